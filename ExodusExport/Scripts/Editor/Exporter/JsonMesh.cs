@@ -73,6 +73,105 @@ namespace SceneExport{
 		public List<SubMesh> subMeshes = new List<SubMesh>();
 		public int subMeshCount = 0;
 
+		/*
+		If set, bulk channels (verts, normals, uvs, weights, triangles) are stored in this binary file 
+		instead of json, and are not written into json at all. Path is relative to json resource folder.
+		The layout must match JsonMeshBinaryData on the importer side.
+		*/
+		public string binaryDataPath = null;
+		
+		public static readonly uint binaryMagic = 0x424D5845;//"EXMB"
+		public static readonly uint binaryVersion = 1;
+		public static readonly int binaryAlignment = 16;
+		
+		enum BinaryChannelId: uint{
+			Verts = 0,
+			Normals = 1,
+			Tangents = 2,
+			Colors = 3,
+			Uv0 = 4,
+			BoneWeights = 12,
+			BoneIndexes = 13,
+			SubMeshTriangles = 0x100
+		}
+		
+		enum BinaryElementType: uint{
+			Float32 = 0,
+			Int32 = 1,
+			UInt8 = 2
+		}
+		
+		class BinaryChannel{
+			public uint channelId;
+			public BinaryElementType elementType;
+			public System.Array data;
+			public ulong offset;
+			
+			public int elementSize{
+				get{
+					return (elementType == BinaryElementType.UInt8) ? 1: 4;
+				}
+			}
+		}
+		
+		static ulong alignBinaryOffset(ulong offset){
+			var align = (ulong)binaryAlignment;
+			return (offset + align - 1) / align * align;
+		}
+		
+		public void saveBinaryData(string baseDir, string relativePath){
+			var channels = new List<BinaryChannel>();
+			System.Action<uint, BinaryElementType, System.Array> addChannel = (channelId, elementType, data) => {
+				if ((data == null) || (data.Length == 0))
+					return;
+				channels.Add(new BinaryChannel(){channelId = channelId, elementType = elementType, data = data});
+			};
+			
+			addChannel((uint)BinaryChannelId.Verts, BinaryElementType.Float32, verts);
+			addChannel((uint)BinaryChannelId.Normals, BinaryElementType.Float32, normals);
+			addChannel((uint)BinaryChannelId.Tangents, BinaryElementType.Float32, tangents);
+			addChannel((uint)BinaryChannelId.Colors, BinaryElementType.UInt8, colors);
+			var uvs = new float[][]{uv0, uv1, uv2, uv3, uv4, uv5, uv6, uv7};
+			for(int i = 0; i < uvs.Length; i++)
+				addChannel((uint)BinaryChannelId.Uv0 + (uint)i, BinaryElementType.Float32, uvs[i]);
+			addChannel((uint)BinaryChannelId.BoneWeights, BinaryElementType.Float32, boneWeights.ToArray());
+			addChannel((uint)BinaryChannelId.BoneIndexes, BinaryElementType.Int32, boneIndexes.ToArray());
+			for(int i = 0; i < subMeshes.Count; i++)
+				addChannel((uint)BinaryChannelId.SubMeshTriangles + (uint)i, BinaryElementType.Int32, subMeshes[i].triangles);
+			
+			ulong offset = alignBinaryOffset((ulong)(16 + 24 * channels.Count));
+			foreach(var cur in channels){
+				cur.offset = offset;
+				offset = alignBinaryOffset(offset + (ulong)(cur.data.Length * cur.elementSize));
+			}
+			
+			var fullPath = System.IO.Path.Combine(baseDir, relativePath);
+			using(var writer = new System.IO.BinaryWriter(System.IO.File.Open(fullPath, System.IO.FileMode.Create))){
+				writer.Write(binaryMagic);
+				writer.Write(binaryVersion);
+				writer.Write((uint)channels.Count);
+				writer.Write((uint)0);
+				foreach(var cur in channels){
+					writer.Write(cur.channelId);
+					writer.Write((uint)cur.elementType);
+					writer.Write((uint)cur.data.Length);
+					writer.Write((uint)0);
+					writer.Write(cur.offset);
+				}
+				
+				foreach(var cur in channels){
+					while((ulong)writer.BaseStream.Position < cur.offset)
+						writer.Write((byte)0);
+					//BinaryWriter is little endian, same as the importer expects.
+					var bytes = new byte[cur.data.Length * cur.elementSize];
+					System.Buffer.BlockCopy(cur.data, 0, bytes, 0, bytes.Length);
+					writer.Write(bytes);
+				}
+			}
+			
+			binaryDataPath = relativePath;
+		}
+
 		static void processFloats3(float[] args, System.Func<Vector3, Vector3> callback){
 			if (callback == null)
 				throw new System.ArgumentNullException("callback");
@@ -328,6 +427,7 @@ namespace SceneExport{
 			subMeshes = other.subMeshes.Select((arg) => new SubMesh(arg)).ToList();
 			
 			subMeshCount = other.subMeshCount;
+			binaryDataPath = other.binaryDataPath;
 		}
 			
 		public void writeRawJsonValue(FastJsonWriter writer){
@@ -341,19 +441,24 @@ namespace SceneExport{
 			writer.writeKeyVal("materials", materials);
 			writer.writeKeyVal("readable", readable);
 			writer.writeKeyVal("vertexCount", vertexCount);
-			writer.writeOptionalKeyVal("colors", colors, 4 * vertsPerLine);
-			writer.writeOptionalKeyVal("verts", verts, 3 * vertsPerLine);
-			writer.writeOptionalKeyVal("normals", normals, 3 * vertsPerLine);
-			writer.writeOptionalKeyVal("tangents", tangents, 4 * vertsPerLine);
-			
-			writer.writeOptionalKeyVal("uv0", uv0, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv1", uv1, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv2", uv2, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv3", uv3, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv4", uv4, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv5", uv5, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv6", uv6, 2 * vertsPerLine);
-			writer.writeOptionalKeyVal("uv7", uv7, 2 * vertsPerLine);
+			bool binaryChannels = !string.IsNullOrEmpty(binaryDataPath);
+			if (binaryChannels)
+				writer.writeKeyVal("binaryDataPath", binaryDataPath);
+			else{
+				writer.writeOptionalKeyVal("colors", colors, 4 * vertsPerLine);
+				writer.writeOptionalKeyVal("verts", verts, 3 * vertsPerLine);
+				writer.writeOptionalKeyVal("normals", normals, 3 * vertsPerLine);
+				writer.writeOptionalKeyVal("tangents", tangents, 4 * vertsPerLine);
+			
+				writer.writeOptionalKeyVal("uv0", uv0, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv1", uv1, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv2", uv2, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv3", uv3, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv4", uv4, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv5", uv5, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv6", uv6, 2 * vertsPerLine);
+				writer.writeOptionalKeyVal("uv7", uv7, 2 * vertsPerLine);
+			}
 			
 			writer.writeOptionalKeyVal("bindPoses", bindPoses);
 			writer.writeOptionalKeyVal("inverseBindPoses", 
@@ -361,8 +466,10 @@ namespace SceneExport{
 			writer.writeOptionalKeyVal("bindPoseTransforms", 
 				bindPoses.Select((arg) => new JsonTransform(arg, true)).ToList());
 			
-			writer.writeOptionalKeyVal("boneWeights", boneWeights, 4 * vertsPerLine);
-			writer.writeOptionalKeyVal("boneIndexes", boneIndexes, 4 * vertsPerLine);
+			if (!binaryChannels){
+				writer.writeOptionalKeyVal("boneWeights", boneWeights, 4 * vertsPerLine);
+				writer.writeOptionalKeyVal("boneIndexes", boneIndexes, 4 * vertsPerLine);
+			}
 			writer.writeKeyVal("defaultSkeletonId", defaultSkeletonId);
 			writer.writeKeyVal("defaultBoneNames", defaultBoneNames);
 			
@@ -374,7 +481,8 @@ namespace SceneExport{
 			writer.writeOptionalKeyVal("blendShapes", blendShapes);			
 			
 			writer.writeKeyVal("subMeshCount", subMeshCount);			
-			writer.writeKeyVal("subMeshes", subMeshes);
+			if (!binaryChannels)
+				writer.writeKeyVal("subMeshes", subMeshes);
 			writer.endObject();			
 		}
 
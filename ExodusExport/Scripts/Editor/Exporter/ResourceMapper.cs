@@ -58,6 +58,9 @@ namespace SceneExport{
 		//public Dictionary<ResId, MeshUsageFlags> meshUsage = new Dictionary<ResId, MeshUsageFlags>();
 		
 		public HashSet<string> resources = new HashSet<string>();
+
+		//Bulk mesh channels go into memory-mappable binary files next to mesh json. Way faster to import.
+		public bool binaryMeshData = true;
 		
 		public ObjectMapper<TerrainData> terrains = new ObjectMapper<TerrainData>();
 		
@@ -645,7 +648,12 @@ namespace SceneExport{
 					(asset) => result.registerAsset(asset)
 				);
 				processObjects |= saveResourcesToPath(result.meshes, baseDir, meshWatcher, 
-					(meshKey, idx, id) => makeJsonMesh(meshKey, id), (obj) => obj.name, "mesh", showGui);
+					(meshKey, idx, id) => makeJsonMesh(meshKey, id), (obj) => obj.name, "mesh", showGui,
+					(mesh) => {
+						if (binaryMeshData)
+							mesh.saveBinaryData(baseDir, string.Format("mesh{0:D8}.bin", mesh.id.objectIndex));
+					}
+				);
 				processObjects |= saveResourcesToPath(result.materials, baseDir, materialsWatcher, 
 					(objData) => {
 						var mat = new JsonMaterial(objData, this);
@@ -2,18 +2,61 @@
 #include "AnimationBuilder.h"
 #include "Runtime/Engine/Classes/Animation/AnimSequence.h"
 #include "Runtime/Engine/Classes/Animation/Skeleton.h"
+#include "AnimationUtils.h"
+#include "UnrealVersionUtilities.h"
 
-void addRawTrackBoneKey(FRawAnimSequenceTrack &outTrack, const JsonTransformKey &key){
-	auto unrealMatrix = key.local.getUnrealTransform();
+static FTransform getKeyTransform(const JsonTransformKey &key){
 	FTransform transform;
-	transform.SetFromMatrix(unrealMatrix);
+	transform.SetFromMatrix(key.local.getUnrealTransform());
+	return transform;
+}
 
+void addRawTrackBoneKey(FRawAnimSequenceTrack &outTrack, const FTransform &transform){
 	outTrack.PosKeys.Add(transform.GetLocation());
 	outTrack.ScaleKeys.Add(transform.GetScale3D());
-	outTrack.RotKeys.Add(transform.GetRotation());
+	auto rot = transform.GetRotation();
+	//Keep neighbors in the same hemisphere, so flips don't look like motion to the compressor.
+	if ((outTrack.RotKeys.Num() > 0) && ((outTrack.RotKeys.Last() | rot) < 0.0f))
+		rot *= -1.0f;
+	outTrack.RotKeys.Add(rot);
+}
+
+static int64 getTrackByteSize(const FRawAnimSequenceTrack &track){
+	return (int64)track.PosKeys.Num() * sizeof(FVector) 
+		+ (int64)track.RotKeys.Num() * sizeof(FQuat) 
+		+ (int64)track.ScaleKeys.Num() * sizeof(FVector);
+}
+
+/*
+Replaces the whole channel with its first key if every key is within tolerance of it.
+*/
+template<typename KeyType, typename ErrorFunc> static bool collapseConstantChannel(TArray<KeyType> &keys, float tolerance, ErrorFunc getError, float &maxError){
+	if (keys.Num() <= 1)
+		return keys.Num() == 1;
+	float channelError = 0.0f;
+	for(int32 i = 1; i < keys.Num(); i++){
+		channelError = FMath::Max(channelError, getError(keys[0], keys[i]));
+		if (channelError > tolerance)
+			return false;
+	}
+	keys.SetNum(1);
+	maxError = FMath::Max(maxError, channelError);
+	return true;
+}
+
+void AnimationBuilder::reduceTrack(FRawAnimSequenceTrack &track, AnimationClipStats &stats) const{
+	if (collapseConstantChannel(track.PosKeys, keyReduction.positionTolerance, 
+			[](const FVector &a, const FVector &b){return FVector::Dist(a, b);}, stats.maxCollapsePositionError))
+		stats.numConstantChannels++;
+	if (collapseConstantChannel(track.RotKeys, keyReduction.rotationTolerance, 
+			[](const FQuat &a, const FQuat &b){return FMath::RadiansToDegrees(a.AngularDistance(b));}, stats.maxCollapseRotationError))
+		stats.numConstantChannels++;
+	if (collapseConstantChannel(track.ScaleKeys, keyReduction.scaleTolerance, 
+			[](const FVector &a, const FVector &b){return (a - b).GetAbsMax();}, stats.maxCollapseScaleError))
+		stats.numConstantChannels++;
 }
 
-void AnimationBuilder::buildAnimation(UAnimSequence *animSeq, USkeleton *skel, const JsonAnimationClip &srcClip){
+AnimationClipStats AnimationBuilder::buildAnimation(UAnimSequence *animSeq, USkeleton *skel, const JsonAnimationClip &srcClip){
 	check(animSeq);
 	animSeq->CleanAnimSequenceForImport();
 	if (!skel){
@@ -39,39 +82,52 @@ void AnimationBuilder::buildAnimation(UAnimSequence *animSeq, USkeleton *skel, c
 
 	int numFrames = maxFrame - minFrame + 1;
 
+	AnimationClipStats stats;
+	stats.name = srcClip.name;
+	stats.numFrames = numFrames;
+
 	for(const auto &matCurve: srcClip.matrixCurves){
 		if (matCurve.keys.Num() <= 0)
 			continue;
 
 		FRawAnimSequenceTrack rawAnimTrack;
+		rawAnimTrack.PosKeys.Reserve(numFrames);
+		rawAnimTrack.RotKeys.Reserve(numFrames);
+		rawAnimTrack.ScaleKeys.Reserve(numFrames);
 
+		//Every source key is decomposed once, padding frames reuse the result.
 		const auto &firstKey = matCurve.keys[0];
-		const auto &lastKey = matCurve.keys[matCurve.keys.Num() - 1];
-		int lastFrame = -1;
+		const auto firstTransform = getKeyTransform(firstKey);
 		
 		int frameIndex = 0;
 		while(frameIndex < firstKey.frame){
-			addRawTrackBoneKey(rawAnimTrack, firstKey);
+			addRawTrackBoneKey(rawAnimTrack, firstTransform);
 			frameIndex++;
 		}
 
-		auto lastWrittenKey = firstKey;
+		auto lastWrittenTransform = firstTransform;
 		for(int i = 0; i < matCurve.keys.Num(); i++){
 			const auto &curKey = matCurve.keys[i];
 			while(frameIndex < curKey.frame){
-				addRawTrackBoneKey(rawAnimTrack, lastWrittenKey);
+				addRawTrackBoneKey(rawAnimTrack, lastWrittenTransform);
 				frameIndex++;
 			}
-			lastWrittenKey = curKey;
-			addRawTrackBoneKey(rawAnimTrack, curKey);
+			lastWrittenTransform = (i == 0) ? firstTransform: getKeyTransform(curKey);
+			addRawTrackBoneKey(rawAnimTrack, lastWrittenTransform);
 			frameIndex++;
 		}
 
 		while(frameIndex <= maxFrame){
-			addRawTrackBoneKey(rawAnimTrack, lastKey);
+			addRawTrackBoneKey(rawAnimTrack, lastWrittenTransform);
 			frameIndex++;
 		}
 
+		stats.numTracks++;
+		stats.rawBytes += getTrackByteSize(rawAnimTrack);
+		if (keyReduction.enabled)
+			reduceTrack(rawAnimTrack, stats);
+		stats.reducedBytes += getTrackByteSize(rawAnimTrack);
+
 		animSeq->AddNewRawTrack(*matCurve.objectName, &rawAnimTrack);
 	}
 
@@ -86,11 +142,29 @@ void AnimationBuilder::buildAnimation(UAnimSequence *animSeq, USkeleton *skel, c
 	animSeq->SequenceLength = (float)numFrames / frameRate;
 	animSeq->MarkRawDataAsModified();
 
+	if (keyReduction.compress){
+#ifdef EXODUS_UE_VER_4_25_GE
+		if (!animSeq->BoneCompressionSettings)
+			animSeq->BoneCompressionSettings = FAnimationUtils::GetDefaultAnimationBoneCompressionSettings();
+#else
+		if (!animSeq->CompressionScheme)
+			animSeq->CompressionScheme = FAnimationUtils::GetDefaultAnimationCompressionAlgorithm();
+#endif
+		animSeq->RequestSyncAnimRecompression(false);
+		stats.compressedBytes = animSeq->GetApproxCompressedSize();
+	}
+
+	UE_LOG(JsonLog, Log, TEXT("Anim clip \"%s\": %d tracks, %d frames, %d of %d channels constant; raw %lld bytes, reduced %lld, compressed %lld; max collapse error pos %f rot %f deg scale %f"),
+		*stats.name, stats.numTracks, stats.numFrames, stats.numConstantChannels, stats.numTracks * 3,
+		stats.rawBytes, stats.reducedBytes, stats.compressedBytes, 
+		stats.maxCollapsePositionError, stats.maxCollapseRotationError, stats.maxCollapseScaleError);
+
 	//animSeq->RawCurveData.
 
 	//Hmm. Things that would interest us are blendshapes and matrix keys.
 	/*
 	Relevant information is in SkeletalMeshEdito.cpp....
 	*/
+	return stats;
 }
 
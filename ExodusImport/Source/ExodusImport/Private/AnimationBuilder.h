@@ -2,7 +2,47 @@
 #include "CoreMinimal.h"
 #include "JsonObjects.h"
 
+/*
+Clips arrive sampled per frame, so most tracks have channels that never change (scale almost always).
+Channels that stay within tolerance are collapsed to a single key, which is the only non-dense form raw tracks support.
+Removing redundant keys from animated channels is left to the engine compression, which runs afterwards.
+*/
+struct AnimationKeyReduction{
+	bool enabled = true;
+	bool compress = true;
+	float positionTolerance = 0.01f;//unreal units
+	float rotationTolerance = 0.01f;//degrees
+	float scaleTolerance = 0.0001f;
+};
+
+struct AnimationClipStats{
+	FString name;
+	int32 numTracks = 0;
+	int32 numFrames = 0;
+	//Out of numTracks * 3
+	int32 numConstantChannels = 0;
+	int64 rawBytes = 0;
+	int64 reducedBytes = 0;
+	//0 if compression is disabled
+	int64 compressedBytes = 0;
+	/*
+	Largest difference between a dropped key and the key that replaced it, when collapsing constant channels.
+	Error added by the engine compression afterwards is not included.
+	*/
+	float maxCollapsePositionError = 0.0f;
+	float maxCollapseRotationError = 0.0f;
+	float maxCollapseScaleError = 0.0f;
+};
+
 class AnimationBuilder{
 public:
-	void buildAnimation(UAnimSequence *animSequence, USkeleton *skeleton, const JsonAnimationClip &srcClip);
+	AnimationKeyReduction keyReduction;
+
+	AnimationClipStats buildAnimation(UAnimSequence *animSequence, USkeleton *skeleton, const JsonAnimationClip &srcClip);
+	AnimationBuilder() = default;
+	AnimationBuilder(const AnimationKeyReduction &keyReduction_)
+	:keyReduction(keyReduction_){
+	}
+protected:
+	void reduceTrack(FRawAnimSequenceTrack &track, AnimationClipStats &stats) const;
 };
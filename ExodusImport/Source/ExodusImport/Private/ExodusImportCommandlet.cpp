@@ -0,0 +1,206 @@
+#include "JsonImportPrivatePCH.h"
+#include "ExodusImportCommandlet.h"
+
+#include "JsonLog.h"
+#include "JsonImporter.h"
+#include "UnrealUtilities.h"
+
+#include "UObject/UObjectIterator.h"
+#include "Engine/World.h"
+#include "Misc/OutputDevice.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+/*
+Counts importer warnings and errors, so they end up in the report.
+*/
+class ImportLogCounter: public FOutputDevice{
+public:
+	int32 numWarnings = 0;
+	int32 numErrors = 0;
+
+	virtual void Serialize(const TCHAR* message, ELogVerbosity::Type verbosity, const FName& category) override{
+		if ((category != JsonLog.GetCategoryName()) && (category != JsonLogTerrain.GetCategoryName())
+				&& (category != JsonLogPrefab.GetCategoryName()))
+			return;
+		if (verbosity == ELogVerbosity::Warning)
+			numWarnings++;
+		else if ((verbosity == ELogVerbosity::Error) || (verbosity == ELogVerbosity::Fatal))
+			numErrors++;
+	}
+};
+
+UExodusImportCommandlet::UExodusImportCommandlet(){
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Imports project exported by ExodusExport without any UI");
+	HelpUsage = TEXT("-run=ExodusImport -source=<json file> [-contentRoot=/Game/Import] [-report=<json file>] [-nosave] [-nodedup] [-instancing [-instanceCellSize=<uu>]] [-landscapeTileComponents=<n>] [-smoothLandscape] [-noAnimReduction] [-animTolerance=<pos>,<rotDeg>,<scale>]");
+}
+
+int32 UExodusImportCommandlet::saveImportedPackages(const FString &contentRoot, TArray<FString> &outSaved, TArray<FString> &outFailed) const{
+	TArray<UPackage*> packages;
+	for(TObjectIterator<UPackage> it; it; ++it){
+		UPackage *package = *it;
+		if (!package->IsDirty() || !package->GetName().StartsWith(contentRoot))
+			continue;
+		packages.Add(package);
+	}
+
+	for(auto package: packages){
+		auto packageName = package->GetName();
+		UWorld *world = UWorld::FindWorldInPackage(package);
+		auto extension = world ? FPackageName::GetMapPackageExtension(): FPackageName::GetAssetPackageExtension();
+		auto filename = FPackageName::LongPackageNameToFilename(packageName, extension);
+
+		auto saveResult = UPackage::Save(package, world, RF_Standalone|RF_Public, *filename);
+		if (saveResult.Result == ESavePackageResult::Success){
+			outSaved.Add(packageName);
+		}
+		else{
+			UE_LOG(JsonLog, Error, TEXT("Could not save package \"%s\" to \"%s\""), *packageName, *filename);
+			outFailed.Add(packageName);
+		}
+	}
+	return outSaved.Num();
+}
+
+static TArray<TSharedPtr<FJsonValue>> makeJsonStringArray(const TArray<FString> &strings){
+	TArray<TSharedPtr<FJsonValue>> result;
+	for(const auto &cur: strings)
+		result.Add(MakeShared<FJsonValueString>(cur));
+	return result;
+}
+
+static TArray<TSharedPtr<FJsonValue>> makeAnimationClipArray(const TArray<AnimationClipStats> &clips){
+	TArray<TSharedPtr<FJsonValue>> result;
+	for(const auto &cur: clips){
+		auto obj = MakeShared<FJsonObject>();
+		obj->SetStringField(TEXT("name"), cur.name);
+		obj->SetNumberField(TEXT("tracks"), cur.numTracks);
+		obj->SetNumberField(TEXT("frames"), cur.numFrames);
+		obj->SetNumberField(TEXT("constantChannels"), cur.numConstantChannels);
+		obj->SetNumberField(TEXT("rawBytes"), (double)cur.rawBytes);
+		obj->SetNumberField(TEXT("reducedBytes"), (double)cur.reducedBytes);
+		obj->SetNumberField(TEXT("compressedBytes"), (double)cur.compressedBytes);
+		obj->SetNumberField(TEXT("maxCollapsePositionError"), cur.maxCollapsePositionError);
+		obj->SetNumberField(TEXT("maxCollapseRotationError"), cur.maxCollapseRotationError);
+		obj->SetNumberField(TEXT("maxCollapseScaleError"), cur.maxCollapseScaleError);
+		result.Add(MakeShared<FJsonValueObject>(obj));
+	}
+	return result;
+}
+
+static TArray<TSharedPtr<FJsonValue>> makeMergedResourceArray(const TArray<ResourceDeduplicator::MergedResource> &merged){
+	TArray<TSharedPtr<FJsonValue>> result;
+	for(const auto &cur: merged){
+		auto obj = MakeShared<FJsonObject>();
+		obj->SetStringField(TEXT("type"), cur.type);
+		obj->SetNumberField(TEXT("id"), cur.id);
+		obj->SetStringField(TEXT("name"), cur.name);
+		obj->SetNumberField(TEXT("canonicalId"), cur.canonicalId);
+		obj->SetStringField(TEXT("canonicalName"), cur.canonicalName);
+		result.Add(MakeShared<FJsonValueObject>(obj));
+	}
+	return result;
+}
+
+int32 UExodusImportCommandlet::Main(const FString &params){
+	FString sourceFile, contentRoot, reportFile;
+	if (!FParse::Value(*params, TEXT("source="), sourceFile) || sourceFile.IsEmpty()){
+		UE_LOG(JsonLog, Error, TEXT("No source file. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+	if (!FParse::Value(*params, TEXT("contentRoot="), contentRoot) || contentRoot.IsEmpty())
+		contentRoot = UnrealUtilities::getDefaultImportPath();
+	if (!FParse::Value(*params, TEXT("report="), reportFile) || reportFile.IsEmpty())
+		reportFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"), TEXT("ExodusImportReport.json"));
+	bool saveFlag = !FParse::Param(*params, TEXT("nosave"));
+	bool dedupFlag = !FParse::Param(*params, TEXT("nodedup"));
+	bool instancingFlag = FParse::Param(*params, TEXT("instancing"));
+	float instanceCellSize = 0.0f;
+	FParse::Value(*params, TEXT("instanceCellSize="), instanceCellSize);
+	int32 landscapeTileComponents = 0;
+	FParse::Value(*params, TEXT("landscapeTileComponents="), landscapeTileComponents);
+	bool smoothLandscapeFlag = FParse::Param(*params, TEXT("smoothLandscape"));
+	AnimationKeyReduction animReduction;
+	animReduction.enabled = !FParse::Param(*params, TEXT("noAnimReduction"));
+	FString animTolerance;
+	if (FParse::Value(*params, TEXT("animTolerance="), animTolerance, false)){
+		TArray<FString> values;
+		animTolerance.ParseIntoArray(values, TEXT(","));
+		if (values.Num() == 3){
+			animReduction.positionTolerance = FCString::Atof(*values[0]);
+			animReduction.rotationTolerance = FCString::Atof(*values[1]);
+			animReduction.scaleTolerance = FCString::Atof(*values[2]);
+		}
+		else{
+			UE_LOG(JsonLog, Warning, TEXT("Invalid -animTolerance \"%s\", expected <pos>,<rotDeg>,<scale>. Using defaults"), *animTolerance);
+		}
+	}
+
+	sourceFile = FPaths::ConvertRelativePathToFull(sourceFile);
+	contentRoot.RemoveFromEnd(TEXT("/"));
+	if (!FPackageName::IsValidLongPackageName(contentRoot / TEXT("Dummy"))){
+		UE_LOG(JsonLog, Error, TEXT("Invalid content root \"%s\", should be something like /Game/Import"), *contentRoot);
+		return 1;
+	}
+
+	UE_LOG(JsonLog, Display, TEXT("Importing \"%s\" into \"%s\""), *sourceFile, *contentRoot);
+
+	ImportLogCounter logCounter;
+	GLog->AddOutputDevice(&logCounter);
+
+	const double startTime = FPlatformTime::Seconds();
+	JsonImporter importer;
+	importer.setImportRootPath(contentRoot);
+	importer.setUnattended(true);
+	importer.setStaticMeshInstancing(instancingFlag, instanceCellSize);
+	importer.setResourceDeduplication(dedupFlag);
+	importer.setLandscapeTiling(landscapeTileComponents);
+	importer.setSmoothLandscapeResampling(smoothLandscapeFlag);
+	importer.setAnimationKeyReduction(animReduction);
+	bool imported = importer.importProject(sourceFile);
+	const double importTime = FPlatformTime::Seconds() - startTime;
+
+	TArray<FString> savedPackages, failedPackages;
+	if (imported && saveFlag)
+		saveImportedPackages(importer.getProjectImportPath(), savedPackages, failedPackages);
+
+	GLog->RemoveOutputDevice(&logCounter);
+
+	bool success = imported && (failedPackages.Num() == 0) && (logCounter.numErrors == 0);
+
+	auto report = MakeShared<FJsonObject>();
+	report->SetBoolField(TEXT("success"), success);
+	report->SetStringField(TEXT("source"), sourceFile);
+	report->SetStringField(TEXT("contentRoot"), importer.getProjectImportPath());
+	report->SetNumberField(TEXT("importSeconds"), importTime);
+	report->SetNumberField(TEXT("totalSeconds"), FPlatformTime::Seconds() - startTime);
+	report->SetNumberField(TEXT("warnings"), logCounter.numWarnings);
+	report->SetNumberField(TEXT("errors"), logCounter.numErrors);
+	report->SetNumberField(TEXT("resourcesRebuilt"), importer.getImportManifest().getNumRebuilt());
+	report->SetNumberField(TEXT("resourcesReused"), importer.getImportManifest().getNumReused());
+	report->SetArrayField(TEXT("mergedResources"), makeMergedResourceArray(importer.getMergedResources()));
+	report->SetArrayField(TEXT("animationClips"), makeAnimationClipArray(importer.getAnimationClipStats()));
+	report->SetArrayField(TEXT("worlds"), makeJsonStringArray(importer.getImportedWorlds()));
+	report->SetArrayField(TEXT("savedPackages"), makeJsonStringArray(savedPackages));
+	report->SetArrayField(TEXT("failedPackages"), makeJsonStringArray(failedPackages));
+	report->SetStringField(TEXT("profile"), importer.getProfileBaseFilename());
+
+	FString reportText;
+	auto writer = TJsonWriterFactory<>::Create(&reportText);
+	FJsonSerializer::Serialize(report, writer);
+	if (!FFileHelper::SaveStringToFile(reportText, *reportFile)){
+		UE_LOG(JsonLog, Error, TEXT("Could not write report \"%s\""), *reportFile);
+		success = false;
+	}
+
+	UE_LOG(JsonLog, Display, TEXT("Import %s: %d packages saved, %d failed, %d warnings, %d errors. Report: \"%s\""),
+		success ? TEXT("succeeded"): TEXT("failed"), savedPackages.Num(), failedPackages.Num(),
+		logCounter.numWarnings, logCounter.numErrors, *reportFile);
+
+	return success ? 0: 1;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "ExodusImportCommandlet.generated.h"
+
+/*
+Headless project import, for build machines:
+
+UE4Editor-Cmd.exe <project>.uproject -run=ExodusImport -source=<path to exported json>
+	[-contentRoot=/Game/Import] [-report=<report json path>] [-nosave] [-nodedup] [-instancing [-instanceCellSize=<uu>]] -nullrhi -unattended
+
+Imports the project the same way the toolbar button does, saves every package created under the content root
+and writes a json report, including the list of identical textures/meshes that were merged
+(see ResourceDeduplicator, -nodedup turns it off). Return value is 0 on success, 1 on failure.
+*/
+UCLASS()
+class UExodusImportCommandlet: public UCommandlet{
+	GENERATED_BODY()
+public:
+	UExodusImportCommandlet();
+
+	virtual int32 Main(const FString &params) override;
+protected:
+	int32 saveImportedPackages(const FString &contentRoot, TArray<FString> &outSaved, TArray<FString> &outFailed) const;
+};
@@ -7,6 +7,9 @@
 #include "Engine/World.h"
 #include "UnrealUtilities.h"
 
+//Marks outerOwnerIds entries nobody asked about yet.
+static const JsonId unresolvedOuterId = -2;
+
 
 void ImportContext::registerDelayedAnimController(JsonId skelId, JsonId controllerId){
 	delayedAnimControllers.Add(AnimControllerIdKey(skelId, controllerId));
@@ -25,23 +28,22 @@ const JsonGameObject* ImportContext::findJsonObject(JsonId id) const{
 	return nullptr;
 }
 
-const JsonRigidbody* ImportContext::locateRigidbody(const JsonGameObject &srcGameObj) const{
-	using namespace JsonObjects;
-
-	const JsonGameObject *currentObject = &srcGameObj;
-	while (currentObject){
-		if (currentObject->rigidbodies.Num() > 0){
-			return &currentObject->rigidbodies[0];
-		}
-		if (!isValidId(currentObject->parentId))
-			break;
+const JsonGameObject* ImportContext::findJsonObjectByInstanceId(InstanceId instId) const{
+	check(srcIndex != nullptr);
+	auto foundId = srcIndex->findIdByInstance(instId);
+	if (!foundId)
+		return nullptr;
+	return findJsonObject(*foundId);
+}
 
-		if (!srcObjects)
-			break;
+const JsonRigidbody* ImportContext::locateRigidbody(const JsonGameObject &srcGameObj) const{
+	if (srcGameObj.hasRigidbody())
+		return &srcGameObj.rigidbodies[0];
 
-		currentObject = findJsonObject(currentObject->parentId);
-	}
-	return nullptr;
+	auto owner = hierarchy.findRigidbodyOwner(srcGameObj.parentId);
+	if (!owner)
+		return nullptr;
+	return &owner->rigidbodies[0];
 }
 
 void ImportContext::registerGameObject(const JsonGameObject &gameObj, ImportedObject imported){
@@ -51,6 +53,9 @@ void ImportContext::registerGameObject(const JsonGameObject &gameObj, ImportedOb
 		UE_LOG(JsonLog, Warning, TEXT("Object re-registration for id %s"), gameObj.id);
 	*/
 	importedObjects.Add(gameObj.id, imported);
+
+	if (outerOwnerIds.IsValidIndex(gameObj.id))
+		outerOwnerIds[gameObj.id] = imported.findRootActor() ? gameObj.id: findOuterOwnerId(gameObj.parentId);
 }
 
 const ImportedObject* ImportContext::findImportedObject(JsonId id) const{
@@ -61,82 +66,63 @@ ImportedObject* ImportContext::findImportedObject(JsonId id){
 	return importedObjects.Find(id);
 }
 
-const FString* ImportContext::findFolderPath(JsonId id) const{
-	return objectFolderPaths.Find(id);
+const FString& ImportContext::getFolderPath(const JsonGameObject &jsonGameObj) const{
+	return hierarchy.getChildFolderPath(jsonGameObj.parentId);
 }
 
-FString ImportContext::processFolderPath(const JsonGameObject &jsonGameObj){
-	FString folderPath;
-	FString childFolderPath = jsonGameObj.ueName;
-	if (jsonGameObj.parentId >= 0){
-		const FString* found = objectFolderPaths.Find(jsonGameObj.parentId);
-		if (found){
-			folderPath = *found;
-			childFolderPath = folderPath + "/" + jsonGameObj.ueName;
-		}
-		else{
-			UE_LOG(JsonLog, Warning, TEXT("Object parent not found, folder path may be invalid"));
+JsonId ImportContext::findOuterOwnerId(JsonId id) const{
+	//Walks only through objects that haven't been asked about yet, and remembers the answer for all of them.
+	TArray<JsonId, TInlineAllocator<32>> chain;
+	JsonId result = -1;
+	while (outerOwnerIds.IsValidIndex(id)){
+		auto cached = outerOwnerIds[id];
+		if (cached != unresolvedOuterId){
+			result = cached;
+			break;
 		}
+		if (chain.Num() >= outerOwnerIds.Num())
+			break;//looped hierarchy
+		chain.Add(id);
+		id = (*srcObjects)[id].parentId;
 	}
-
-	//UE_LOG(JsonLog, Log, TEXT("Folder path for object: %d: %s"), jsonGameObj.id, *folderPath);
-	objectFolderPaths.Add(jsonGameObj.id, childFolderPath);
-	return folderPath;
+	for(auto cur: chain){
+		outerOwnerIds[cur] = result;
+	}
+	return result;
 }
 
 UObject* ImportContext::findSuitableOuter(const JsonGameObject &jsonObj) const{
-	using namespace JsonObjects;
-
-	JsonId parentId = jsonObj.parentId;
-	UObject* result = nullptr;
-	while (isValidId(parentId)){
-		auto foundImported = importedObjects.Find(parentId);
-		if (foundImported){
-			auto rootActor = foundImported->findRootActor();
-			if (rootActor)
-				return rootActor;
-		}
-		auto foundJson = findJsonObject(parentId);
-		if (!foundJson)
-			break;
-		parentId = foundJson->parentId;
-	}
-	return result;
+	auto ownerId = findOuterOwnerId(jsonObj.parentId);
+	if (ownerId < 0)
+		return nullptr;
+	auto foundImported = importedObjects.Find(ownerId);
+	if (!foundImported)
+		return nullptr;
+	return foundImported->findRootActor();
 }
 
 bool ImportContext::isCompoundRigidbodyRootCollider(const JsonGameObject &gameObj) const{
-	using namespace JsonObjects;
-
 	if (!gameObj.hasColliders())
 		return false;
 	if (gameObj.hasRigidbody())
 		return true;
-	int parentId = gameObj.parentId;
-	auto rigBody = locateRigidbody(gameObj);
-	if (!rigBody)
+	if (!hierarchy.findRigidbodyOwner(gameObj.parentId))
 		return false;
 
-	while (isValidId(parentId)){
-		auto parentJson = findJsonObject(parentId);
-		if (!parentJson){
-			UE_LOG(JsonLog, Warning, TEXT("Broken object chain at %s(\"%s\", %d)"), *gameObj.name, *gameObj.scenePath, gameObj.id);
-			return false;//broken object chain. Report?
-		}
-		if (parentJson->hasColliders())
-			return false;//we are not at compound object root, because parent has collides of its own.
-		if (parentJson->hasRigidbody())
-			return true;//parent has rigibody and no colliders. We're possible compound root.
-		parentId = parentJson->parentId;		
-	}
-	check(false);//somehow we found neither rigidbody nor colliders? This is an illegal scene graph and likely an error
-	return false;
+	/*
+	Nearest parent with physics decides it: own colliders mean we're not at compound object root,
+	rigidbody without colliders means we're possible compound root.
+	*/
+	auto physicsOwner = hierarchy.findPhysicsOwner(gameObj.parentId);
+	check(physicsOwner);//there's a rigidbody up the chain, so there must be one.
+	return !physicsOwner->hasColliders();
 }
 
 AActor* ImportContext::createBlankActor(const JsonGameObject &gameObj, bool createMissingRootComponent) const{
 	using namespace UnrealUtilities;
 	check(world);
 	FTransform transform;
-	transform.SetFromMatrix(gameObj.ueWorldMatrix);
+	transform.SetFromMatrix(gameObj.getUeWorldMatrix());
 
 	AActor *blankActor = world->SpawnActor<AActor>(AActor::StaticClass(), transform);
 	USceneComponent *rootComponent = nullptr;
@@ -157,7 +143,7 @@ ImportedObject ImportContext::createBlankActor(const JsonGameObject &gameObj, US
 	using namespace UnrealUtilities;
 	check(world);
 	FTransform transform;
-	transform.SetFromMatrix(gameObj.ueWorldMatrix);
+	transform.SetFromMatrix(gameObj.getUeWorldMatrix());
 
 	AActor *blankActor = world->SpawnActor<AActor>(AActor::StaticClass(), transform);
 	if (!rootComponent){
@@ -186,7 +172,7 @@ ImportedObject ImportContext::createBlankNode(const JsonGameObject &gameObj, boo
 		return createBlankActor(gameObj, nullptr, true, createMissingRootComponent);
 
 	FTransform transform;
-	transform.SetFromMatrix(gameObj.ueWorldMatrix);
+	transform.SetFromMatrix(gameObj.getUeWorldMatrix());
 	UObject *outerPtr = nullptr;
 	if (outerGetter){
 		outerPtr = outerGetter();
@@ -213,16 +199,30 @@ ImportContext::ImportContext(UWorld *world_, bool editorMode_, const JsonScene *
 :srcObjects(nullptr), world(world_), editorMode(editorMode_){
 	check(scene_ != nullptr);
 	srcObjects = &scene_->objects;
+	srcIndex = &scene_->objectIndex;
+	initHierarchy();
 }
 
-ImportContext::ImportContext(UWorld *world_, bool editorMode_, const TArray<JsonGameObject> *objects_)
-:srcObjects(objects_), world(world_), editorMode(editorMode_){
+ImportContext::ImportContext(UWorld *world_, bool editorMode_, const JsonPrefabData *prefab_)
+:srcObjects(nullptr), world(world_), editorMode(editorMode_){
+	check(prefab_ != nullptr);
+	srcObjects = &prefab_->objects;
+	srcIndex = &prefab_->objectIndex;
+	initHierarchy();
+}
+
+void ImportContext::initHierarchy(){
+	check(srcObjects != nullptr);
+	hierarchy.build(*srcObjects);
+	outerOwnerIds.Init(unresolvedOuterId, srcObjects->Num());
 }
 
 
 void ImportContext::clear(){
-	objectFolderPaths.Empty();
 	importedObjects.Empty();
+	for(auto &cur: outerOwnerIds){
+		cur = unresolvedOuterId;
+	}
 
 	delayedAnimControllers.Empty();
 }
@@ -3,6 +3,7 @@
 #include "JsonObjects.h"
 #include "Runtime/CoreUObject/Public/UObject/StrongObjectPtr.h"
 #include "ImportedObject.h"
+#include "ImportHierarchy.h"
 
 class AActor;
 using IdActorMap = TMap<int, AActor*>;
@@ -27,12 +28,24 @@ not much point when I can just use scoped dictionaries.
 class ImportContext{
 protected:
 	mutable uint64 uniqueInt = 0;
+
+	/*
+	For each object: nearest registered object (self included) that has a root actor, or -1.
+	Filled as objects get registered, and for objects that never are, on first query. 
+	Objects are imported parents first, so an answer doesn't change once it is given.
+	*/
+	mutable TArray<JsonId> outerOwnerIds;
+	JsonId findOuterOwnerId(JsonId id) const;
+
+	void initHierarchy();
 public:
 	uint64 getUniqueUint() const;
 	//const JsonScene *srcScene = nullptr;
 	const TArray<JsonGameObject> *srcObjects = nullptr;
+	//Owned by the scene or prefab, same as srcObjects.
+	const JsonGameObjectIndex *srcIndex = nullptr;
 
-	IdNameMap objectFolderPaths;
+	ImportHierarchy hierarchy;
 
 	ImportedObjectMap importedObjects;
 	TStrongObjectPtr<UWorld> world;
@@ -47,12 +60,12 @@ public:
 
 	const ImportedObject* findImportedObject(JsonId id) const;
 	ImportedObject* findImportedObject(JsonId id);
-	FString processFolderPath(const JsonGameObject &jsonObj);
+	const FString& getFolderPath(const JsonGameObject &jsonObj) const;
 
-	const FString* findFolderPath(JsonId id) const;
 	void registerGameObject(const JsonGameObject &gameObj, ImportedObject imported);
 
 	const JsonGameObject* findJsonObject(JsonId id) const;
+	const JsonGameObject* findJsonObjectByInstanceId(InstanceId instId) const;
 
 	bool isCompoundRigidbodyRootCollider(const JsonGameObject &gameObj) const;
 
@@ -69,5 +82,5 @@ public:
 	ImportedObject createBlankNode(const JsonGameObject &gameObj, bool createActor, bool createMissingRootComponent, std::function<UObject*()> outerGetter) const;
 
 	ImportContext(UWorld *world_, bool editorMode_, const JsonScene *scene_);
-	ImportContext(UWorld *world_, bool editorMode_, const TArray<JsonGameObject> *objects_);
+	ImportContext(UWorld *world_, bool editorMode_, const JsonPrefabData *prefab_);
 };
@@ -0,0 +1,107 @@
+#include "JsonImportPrivatePCH.h"
+#include "ImportHierarchy.h"
+
+void ImportHierarchy::clear(){
+	objects = nullptr;
+	rigidbodyOwners.Empty();
+	physicsOwners.Empty();
+	childFolderPaths.Empty();
+	folderPool.Empty();
+}
+
+const JsonGameObject* ImportHierarchy::findOwner(const TArray<JsonId> &owners, JsonId id) const{
+	if (!isValidIndex(id))
+		return nullptr;
+	auto ownerId = owners[id];
+	if (ownerId < 0)
+		return nullptr;
+	return &(*objects)[ownerId];
+}
+
+const FString& ImportHierarchy::getChildFolderPath(JsonId id) const{
+	if (!isValidIndex(id))
+		return JsonStringRef().get();
+	return childFolderPaths[id];
+}
+
+void ImportHierarchy::buildParentFirstOrder(TArray<JsonId> &outOrder, TArray<JsonId> &outParents) const{
+	/*
+	Exporter writes parents before children, but that's not something to rely on here.
+	Every object is placed after its parent, walking up only through the part of the chain that isn't placed yet.
+	*/
+	const auto numObjects = objects->Num();
+	enum class State: uint8{
+		Pending, Visiting, Placed
+	};
+	TArray<State> states;
+	states.Init(State::Pending, numObjects);
+	outParents.Init(-1, numObjects);
+	outOrder.Reset(numObjects);
+
+	TArray<JsonId, TInlineAllocator<64>> chain;
+	for(JsonId i = 0; i < numObjects; i++){
+		chain.Reset();
+		JsonId cur = i;
+		while ((cur >= 0) && (cur < numObjects) && (states[cur] == State::Pending)){
+			states[cur] = State::Visiting;
+			chain.Add(cur);
+
+			const auto &curObj = (*objects)[cur];
+			auto parentId = curObj.parentId;
+			if (!JsonObjects::isValidId(parentId))
+				break;
+			if (parentId >= numObjects){
+				UE_LOG(JsonLog, Warning, TEXT("Object parent not found, folder path may be invalid. Object %d(\"%s\"), parent %d"),
+					curObj.id, *curObj.name, parentId);
+				break;
+			}
+			if (states[parentId] == State::Visiting){
+				UE_LOG(JsonLog, Warning, TEXT("Loop in object hierarchy at %d(\"%s\"), parent %d"), curObj.id, *curObj.name, parentId);
+				break;
+			}
+			outParents[cur] = parentId;
+			cur = parentId;
+		}
+		for(int32 chainIndex = chain.Num() - 1; chainIndex >= 0; chainIndex--){
+			states[chain[chainIndex]] = State::Placed;
+			outOrder.Add(chain[chainIndex]);
+		}
+	}
+}
+
+void ImportHierarchy::build(const TArray<JsonGameObject> &srcObjects){
+	EXODUS_IMPORT_SCOPE(ObjectSpawn);
+	clear();
+	objects = &srcObjects;
+
+	const auto numObjects = srcObjects.Num();
+	TArray<JsonId> order, parents;
+	buildParentFirstOrder(order, parents);
+
+	TBitArray<> hasChildren(false, numObjects);
+	for(auto parentId: parents){
+		if (parentId >= 0)
+			hasChildren[parentId] = true;
+	}
+
+	rigidbodyOwners.Init(-1, numObjects);
+	physicsOwners.Init(-1, numObjects);
+	childFolderPaths.SetNum(numObjects);
+
+	for(auto id: order){
+		const auto &obj = srcObjects[id];
+		const auto parentId = parents[id];
+		const bool hasParent = parentId >= 0;
+
+		rigidbodyOwners[id] = obj.hasRigidbody() ? id: (hasParent ? rigidbodyOwners[parentId]: -1);
+		physicsOwners[id] = (obj.hasRigidbody() || obj.hasColliders()) ? id: (hasParent ? physicsOwners[parentId]: -1);
+
+		if (!hasChildren[id])
+			continue;
+		if (hasParent)
+			childFolderPaths[id] = folderPool.intern(childFolderPaths[parentId].get() + TEXT("/") + obj.ueName.get());
+		else
+			childFolderPaths[id] = folderPool.intern(obj.ueName.get());
+	}
+	UE_LOG(JsonLog, Log, TEXT("Object hierarchy: %d objects, %d folders"), numObjects, folderPool.Num());
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "JsonObjects.h"
+
+/*
+Parent chain data of an object list (scene, prefab), computed in one pass when ImportContext is created.
+
+Rigidbody lookups, compound collider checks and outliner folders used to walk up the parent chain
+for every object, and folder paths were concatenated for every object as well. With hierarchies 20+ levels deep 
+and tens of thousands of leaves that adds up. Here every object gets its answers stored in arrays indexed by id.
+
+All queries take the id of the object itself, "self included" means the object is its own nearest owner.
+*/
+class ImportHierarchy{
+protected:
+	const TArray<JsonGameObject> *objects = nullptr;
+
+	//Nearest object (self included) with a rigidbody, or -1.
+	TArray<JsonId> rigidbodyOwners;
+	//Nearest object (self included) with either a rigidbody or colliders, or -1.
+	TArray<JsonId> physicsOwners;
+	/*
+	Folder that children of the object go into. Only objects that have children get one,
+	each distinct path is stored once in folderPool.
+	*/
+	TArray<JsonStringRef> childFolderPaths;
+	JsonStringPool folderPool;
+
+	bool isValidIndex(JsonId id) const{
+		return (id >= 0) && (id < rigidbodyOwners.Num());
+	}
+	const JsonGameObject* findOwner(const TArray<JsonId> &owners, JsonId id) const;
+	void buildParentFirstOrder(TArray<JsonId> &outOrder, TArray<JsonId> &outParents) const;
+public:
+	void build(const TArray<JsonGameObject> &srcObjects);
+	void clear();
+
+	const JsonGameObject* findRigidbodyOwner(JsonId id) const{
+		return findOwner(rigidbodyOwners, id);
+	}
+	const JsonGameObject* findPhysicsOwner(JsonId id) const{
+		return findOwner(physicsOwners, id);
+	}
+	const FString& getChildFolderPath(JsonId id) const;
+
+	ImportHierarchy() = default;
+	ImportHierarchy(const ImportHierarchy&) = delete;
+	ImportHierarchy& operator=(const ImportHierarchy&) = delete;
+};
@@ -0,0 +1,168 @@
+#include "JsonImportPrivatePCH.h"
+#include "ImportManifest.h"
+#include "JsonObjects.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+FString ImportManifest::makeManifestFilename(const FString &projectImportPath){
+	return FPackageName::LongPackageNameToFilename(projectImportPath / TEXT("ExodusImportManifest"), TEXT(".json"));
+}
+
+FString ImportManifest::hashFiles(const StringArray &filenames, StringArray *outFileHashes){
+	FMD5 md5;
+	if (outFileHashes)
+		outFileHashes->Empty(filenames.Num());
+	for(const auto &curFilename: filenames){
+		auto fileHash = FMD5Hash::HashFile(*curFilename);
+		if (outFileHashes)
+			outFileHashes->Add(fileHash.IsValid() ? BytesToHex(fileHash.GetBytes(), fileHash.GetSize()): FString());
+		if (fileHash.IsValid()){
+			md5.Update(fileHash.GetBytes(), fileHash.GetSize());
+		}
+		else{
+			UE_LOG(JsonLog, Log, TEXT("Could not hash \"%s\""), *curFilename);
+			const uint8 missingMarker = 0;
+			md5.Update(&missingMarker, 1);
+		}
+	}
+
+	uint8 digest[16];
+	md5.Final(digest);
+	return BytesToHex(digest, sizeof(digest));
+}
+
+bool ImportManifest::assetExists(const FString &objectPath){
+	if (objectPath.IsEmpty())
+		return false;
+	if (FindObject<UObject>(nullptr, *objectPath))
+		return true;
+	auto packageName = FPackageName::ObjectPathToPackageName(objectPath);
+	return FPackageName::DoesPackageExist(packageName);
+}
+
+bool ImportManifest::load(const FString &filename_){
+	filename = filename_;
+	prevEntries.Empty();
+	curEntries.Empty();
+	rebuiltKeys.Empty();
+
+	if (!FPaths::FileExists(filename)){
+		UE_LOG(JsonLog, Log, TEXT("No import manifest at \"%s\", everything will be imported"), *filename);
+		return false;
+	}
+
+	auto jsonData = JsonObjects::loadJsonFromFile(filename);
+	if (!jsonData.IsValid())
+		return false;
+
+	int32 fileVersion = 0;
+	jsonData->TryGetNumberField(TEXT("version"), fileVersion);
+	if (fileVersion != version){
+		UE_LOG(JsonLog, Warning, TEXT("Import manifest \"%s\" has version %d (%d expected), ignoring it"),
+			*filename, fileVersion, version);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> *resources = nullptr;
+	if (!jsonData->TryGetObjectField(TEXT("resources"), resources) || !resources)
+		return false;
+
+	for(const auto &curRes: (*resources)->Values){
+		auto resObj = curRes.Value->AsObject();
+		if (!resObj.IsValid())
+			continue;
+
+		Entry entry;
+		resObj->TryGetStringField(TEXT("hash"), entry.hash);
+		resObj->TryGetStringArrayField(TEXT("dependencies"), entry.dependencies);
+
+		const TSharedPtr<FJsonObject> *assets = nullptr;
+		if (resObj->TryGetObjectField(TEXT("assets"), assets) && assets){
+			for(const auto &curAsset: (*assets)->Values){
+				entry.assets.Add(curAsset.Key, curAsset.Value->AsString());
+			}
+		}
+		prevEntries.Add(curRes.Key, entry);
+	}
+
+	UE_LOG(JsonLog, Log, TEXT("Loaded import manifest \"%s\", %d resources"), *filename, prevEntries.Num());
+	return true;
+}
+
+bool ImportManifest::save() const{
+	if (filename.IsEmpty())
+		return false;
+
+	auto resources = MakeShared<FJsonObject>();
+	for(const auto &curEntry: curEntries){
+		const auto &entry = curEntry.Value;
+		auto resObj = MakeShared<FJsonObject>();
+		resObj->SetStringField(TEXT("hash"), entry.hash);
+
+		TArray<TSharedPtr<FJsonValue>> deps;
+		for(const auto &curDep: entry.dependencies)
+			deps.Add(MakeShared<FJsonValueString>(curDep));
+		resObj->SetArrayField(TEXT("dependencies"), deps);
+
+		auto assets = MakeShared<FJsonObject>();
+		for(const auto &curAsset: entry.assets)
+			assets->SetStringField(curAsset.Key, curAsset.Value);
+		resObj->SetObjectField(TEXT("assets"), assets);
+
+		resources->SetObjectField(curEntry.Key, resObj);
+	}
+
+	auto root = MakeShared<FJsonObject>();
+	root->SetNumberField(TEXT("version"), version);
+	root->SetObjectField(TEXT("resources"), resources);
+
+	FString text;
+	auto writer = TJsonWriterFactory<>::Create(&text);
+	if (!FJsonSerializer::Serialize(root, writer)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not serialize import manifest"));
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(text, *filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not save import manifest \"%s\""), *filename);
+		return false;
+	}
+
+	UE_LOG(JsonLog, Log, TEXT("Saved import manifest \"%s\": %d resources, %d rebuilt, %d reused"),
+		*filename, curEntries.Num(), getNumRebuilt(), getNumReused());
+	return true;
+}
+
+const ImportManifest::Entry* ImportManifest::findReusableEntry(const FString &key, const FString &hash,
+		const StringArray &dependencies) const{
+	auto found = prevEntries.Find(key);
+	if (!found || hash.IsEmpty() || (found->hash != hash))
+		return nullptr;
+	if (found->dependencies != dependencies)
+		return nullptr;
+
+	for(const auto &curDep: dependencies){
+		//dependency failed to import this time, or was rebuilt. Either way this one has to go too.
+		if (!curEntries.Contains(curDep) || rebuiltKeys.Contains(curDep))
+			return nullptr;
+	}
+
+	for(const auto &curAsset: found->assets){
+		if (!assetExists(curAsset.Value)){
+			UE_LOG(JsonLog, Log, TEXT("Asset \"%s\" of resource \"%s\" is gone, rebuilding"), *curAsset.Value, *key);
+			return nullptr;
+		}
+	}
+	return found;
+}
+
+void ImportManifest::record(const FString &key, const FString &hash, const StringArray &dependencies,
+		const TMap<FString, FString> &assets, bool rebuilt){
+	auto &entry = curEntries.FindOrAdd(key);
+	entry.hash = hash;
+	entry.dependencies = dependencies;
+	entry.assets = assets;
+	if (rebuilt)
+		rebuiltKeys.Add(key);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "JsonTypes.h"
+
+/*
+Remembers what was produced by the previous import of the same project json.
+
+For every extern resource (keyed by its json filename) it stores content hash of the files it was built from,
+keys of resources it depends on, and object paths of unreal assets generated from it.
+
+On re-import a resource is reused as is when its hash matches, none of its dependencies were rebuilt in this session,
+and its assets still exist. Otherwise it is rebuilt, and everything downstream of it gets rebuilt too,
+because resources are processed in dependency order (textures, materials, skeletons, meshes, clips).
+
+Lives in the content folder next to the imported assets, /Game/Import/<sourceBaseName> by default.
+*/
+class ImportManifest{
+public:
+	struct Entry{
+		FString hash;
+		StringArray dependencies;
+		TMap<FString, FString> assets;//role -> object path
+
+		const FString* findAsset(const FString &role) const{
+			return assets.Find(role);
+		}
+	};
+
+	static const int32 version = 1;
+
+	//projectImportPath is a long package path, see JsonImporter::getProjectImportPath()
+	static FString makeManifestFilename(const FString &projectImportPath);
+	/*
+	Hash over contents of all the files. Missing files are hashed as missing, so adding them later counts as a change.
+	outFileHashes receives per-file hashes in the same order (empty string for missing files).
+	*/
+	static FString hashFiles(const StringArray &filenames, StringArray *outFileHashes = nullptr);
+
+	bool load(const FString &filename_);
+	bool save() const;
+
+	const Entry* findReusableEntry(const FString &key, const FString &hash, const StringArray &dependencies) const;
+	bool wasImportedBefore(const FString &key) const{
+		return prevEntries.Contains(key);
+	}
+	bool wasRebuilt(const FString &key) const{
+		return rebuiltKeys.Contains(key);
+	}
+	void record(const FString &key, const FString &hash, const StringArray &dependencies,
+		const TMap<FString, FString> &assets, bool rebuilt);
+
+	int32 getNumReused() const{
+		return curEntries.Num() - rebuiltKeys.Num();
+	}
+	int32 getNumRebuilt() const{
+		return rebuiltKeys.Num();
+	}
+protected:
+	FString filename;
+	TMap<FString, Entry> prevEntries;
+	TMap<FString, Entry> curEntries;
+	TSet<FString> rebuiltKeys;
+
+	static bool assetExists(const FString &objectPath);
+};
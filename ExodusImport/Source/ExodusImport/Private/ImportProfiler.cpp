@@ -0,0 +1,177 @@
+#include "JsonImportPrivatePCH.h"
+#include "ImportProfiler.h"
+#include "JsonLog.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+static const TCHAR* stageNames[(int32)ImportStage::Count] = {
+	TEXT("FileRead"),
+	TEXT("JsonParse"),
+	TEXT("Texture"),
+	TEXT("Material"),
+	TEXT("StaticMesh"),
+	TEXT("SkeletalMesh"),
+	TEXT("Collision"),
+	TEXT("Landscape"),
+	TEXT("ObjectSpawn"),
+	TEXT("Joints"),
+	TEXT("Animators")
+};
+
+ImportProfiler& ImportProfiler::get(){
+	static ImportProfiler instance;
+	return instance;
+}
+
+const TCHAR* ImportProfiler::getStageName(ImportStage stage){
+	auto index = (int32)stage;
+	if ((index < 0) || (index >= (int32)ImportStage::Count))
+		return TEXT("Unknown");
+	return stageNames[index];
+}
+
+ImportProfiler::Scope*& ImportProfiler::getCurrentScope(){
+	static thread_local Scope* currentScope = nullptr;
+	return currentScope;
+}
+
+ImportProfiler::Scope::Scope(ImportStage stage_)
+:stage(stage_){
+	if (!ImportProfiler::get().isActive())
+		return;
+	auto &current = getCurrentScope();
+	parent = current;
+	current = this;
+	startTime = FPlatformTime::Seconds();
+}
+
+ImportProfiler::Scope::~Scope(){
+	if (startTime == 0.0)
+		return;
+	auto seconds = FPlatformTime::Seconds() - startTime;
+	getCurrentScope() = parent;
+	if (parent)
+		parent->childSeconds += seconds;
+	ImportProfiler::get().addScopeResult(*this, seconds);
+}
+
+void ImportProfiler::addScopeResult(const Scope &scope, double seconds){
+	auto usedPhysical = (uint64)FPlatformMemory::GetStats().UsedPhysical;
+
+	FScopeLock lock(&statsLock);
+	if (!active)
+		return;
+	auto &stats = stages[(int32)scope.stage];
+	stats.calls++;
+	stats.totalSeconds += seconds;
+	stats.selfSeconds += FMath::Max(0.0, seconds - scope.childSeconds);
+	stats.bytesRead += scope.bytesRead;
+	stats.assetsCreated += scope.assetsCreated;
+	stats.peakUsedPhysical = FMath::Max(stats.peakUsedPhysical, usedPhysical);
+}
+
+void ImportProfiler::addBytesRead(int64 numBytes){
+	if (auto scope = getCurrentScope())
+		scope->bytesRead += numBytes;
+}
+
+void ImportProfiler::addAssetCreated(){
+	if (auto scope = getCurrentScope())
+		scope->assetsCreated++;
+}
+
+void ImportProfiler::beginSession(const FString &sessionName_){
+	FScopeLock lock(&statsLock);
+	for(auto &cur: stages)
+		cur = StageStats();
+	sessionName = sessionName_;
+	sessionStart = FPlatformTime::Seconds();
+	sessionEnd = sessionStart;
+	sessionStartUsedPhysical = (uint64)FPlatformMemory::GetStats().UsedPhysical;
+	active = true;
+}
+
+void ImportProfiler::endSession(){
+	FScopeLock lock(&statsLock);
+	if (!active)
+		return;
+	sessionEnd = FPlatformTime::Seconds();
+	active = false;
+}
+
+double ImportProfiler::getSessionSeconds() const{
+	FScopeLock lock(&statsLock);
+	return (active ? FPlatformTime::Seconds(): sessionEnd) - sessionStart;
+}
+
+ImportProfiler::StageStats ImportProfiler::getStageStats(ImportStage stage) const{
+	FScopeLock lock(&statsLock);
+	return stages[(int32)stage];
+}
+
+void ImportProfiler::logSummary() const{
+	UE_LOG(JsonLog, Display, TEXT("Import \"%s\" took %.2f seconds"), *sessionName, getSessionSeconds());
+	for(int32 i = 0; i < (int32)ImportStage::Count; i++){
+		auto stats = getStageStats((ImportStage)i);
+		if (stats.calls == 0)
+			continue;
+		UE_LOG(JsonLog, Display, TEXT("    %-12s: %6d calls, %8.3f s total, %8.3f s self, %10lld bytes read, %5d assets, peak %llu MB"),
+			stageNames[i], stats.calls, stats.totalSeconds, stats.selfSeconds, stats.bytesRead, stats.assetsCreated,
+			stats.peakUsedPhysical / (1024*1024));
+	}
+}
+
+bool ImportProfiler::writeCsv(const FString &filename) const{
+	FString text = TEXT("stage,calls,totalSeconds,selfSeconds,bytesRead,assetsCreated,peakUsedPhysical\n");
+	for(int32 i = 0; i < (int32)ImportStage::Count; i++){
+		auto stats = getStageStats((ImportStage)i);
+		text += FString::Printf(TEXT("%s,%d,%f,%f,%lld,%d,%llu\n"),
+			stageNames[i], stats.calls, stats.totalSeconds, stats.selfSeconds, stats.bytesRead, stats.assetsCreated,
+			stats.peakUsedPhysical);
+	}
+
+	if (!FFileHelper::SaveStringToFile(text, *filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not write import profile \"%s\""), *filename);
+		return false;
+	}
+	return true;
+}
+
+bool ImportProfiler::writeJson(const FString &filename) const{
+	auto root = MakeShared<FJsonObject>();
+	root->SetStringField(TEXT("session"), sessionName);
+	root->SetNumberField(TEXT("totalSeconds"), getSessionSeconds());
+	root->SetNumberField(TEXT("startUsedPhysical"), (double)sessionStartUsedPhysical);
+
+	auto stagesObj = MakeShared<FJsonObject>();
+	for(int32 i = 0; i < (int32)ImportStage::Count; i++){
+		auto stats = getStageStats((ImportStage)i);
+		auto stageObj = MakeShared<FJsonObject>();
+		stageObj->SetNumberField(TEXT("calls"), stats.calls);
+		stageObj->SetNumberField(TEXT("totalSeconds"), stats.totalSeconds);
+		stageObj->SetNumberField(TEXT("selfSeconds"), stats.selfSeconds);
+		stageObj->SetNumberField(TEXT("bytesRead"), (double)stats.bytesRead);
+		stageObj->SetNumberField(TEXT("assetsCreated"), stats.assetsCreated);
+		stageObj->SetNumberField(TEXT("peakUsedPhysical"), (double)stats.peakUsedPhysical);
+		stagesObj->SetObjectField(stageNames[i], stageObj);
+	}
+	root->SetObjectField(TEXT("stages"), stagesObj);
+
+	FString text;
+	auto writer = TJsonWriterFactory<>::Create(&text);
+	if (!FJsonSerializer::Serialize(root, writer) || !FFileHelper::SaveStringToFile(text, *filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not write import profile \"%s\""), *filename);
+		return false;
+	}
+	return true;
+}
+
+bool ImportProfiler::writeSummary(const FString &baseFilename) const{
+	bool csvWritten = writeCsv(baseFilename + TEXT(".csv"));
+	bool jsonWritten = writeJson(baseFilename + TEXT(".json"));
+	if (csvWritten && jsonWritten)
+		UE_LOG(JsonLog, Display, TEXT("Import profile written to \"%s\".csv/.json"), *baseFilename);
+	return csvWritten && jsonWritten;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UnrealVersionUtilities.h"
+#include "HAL/CriticalSection.h"
+
+#ifdef EXODUS_UE_VER_4_25_GE
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+
+enum class ImportStage: int32{
+	FileRead = 0,
+	JsonParse,
+	Texture,
+	Material,
+	StaticMesh,
+	SkeletalMesh,
+	Collision,
+	Landscape,
+	ObjectSpawn,
+	Joints,
+	Animators,
+	Count
+};
+
+/*
+Per-stage timings of the import.
+
+Stages are marked with EXODUS_IMPORT_SCOPE(Stage). Scopes nest, "self" time of a stage excludes time spent
+in nested scopes on the same thread, so json parsing inside mesh loading isn't counted twice.
+Bytes read and assets created are attributed to the innermost scope of the calling thread.
+Peak memory is process used physical memory, sampled when a scope ends.
+
+FileRead and JsonParse scopes run on worker threads as well, so their totals can exceed wall time.
+
+The same scopes also show up in Unreal Insights as cpu trace events (4.25+).
+*/
+class ImportProfiler{
+public:
+	struct StageStats{
+		int32 calls = 0;
+		double totalSeconds = 0.0;
+		double selfSeconds = 0.0;
+		int64 bytesRead = 0;
+		int32 assetsCreated = 0;
+		uint64 peakUsedPhysical = 0;
+	};
+
+	class Scope{
+	public:
+		Scope(ImportStage stage_);
+		~Scope();
+	protected:
+		ImportStage stage;
+		double startTime = 0.0;
+		double childSeconds = 0.0;
+		int64 bytesRead = 0;
+		int32 assetsCreated = 0;
+		Scope *parent = nullptr;
+		friend class ImportProfiler;
+	};
+
+	static ImportProfiler& get();
+	static const TCHAR* getStageName(ImportStage stage);
+
+	void beginSession(const FString &sessionName_);
+	void endSession();
+	bool isActive() const{
+		return active;
+	}
+
+	//Both are cheap no-ops when there's no session
+	static void addBytesRead(int64 numBytes);
+	static void addAssetCreated();
+
+	StageStats getStageStats(ImportStage stage) const;
+	double getSessionSeconds() const;
+
+	void logSummary() const;
+	bool writeCsv(const FString &filename) const;
+	bool writeJson(const FString &filename) const;
+	//Writes <baseName>.csv and <baseName>.json
+	bool writeSummary(const FString &baseFilename) const;
+protected:
+	mutable FCriticalSection statsLock;
+	StageStats stages[(int32)ImportStage::Count];
+	FString sessionName;
+	double sessionStart = 0.0;
+	double sessionEnd = 0.0;
+	uint64 sessionStartUsedPhysical = 0;
+	bool active = false;
+
+	void addScopeResult(const Scope &scope, double seconds);
+	static Scope*& getCurrentScope();
+};
+
+#ifdef EXODUS_UE_VER_4_25_GE
+#define EXODUS_IMPORT_TRACE_SCOPE(stage) TRACE_CPUPROFILER_EVENT_SCOPE_STR(TEXT("ExodusImport/") TEXT(#stage))
+#else
+#define EXODUS_IMPORT_TRACE_SCOPE(stage)
+#endif
+
+#define EXODUS_IMPORT_SCOPE(stage) \
+	ImportProfiler::Scope PREPROCESSOR_JOIN(importProfilerScope, __LINE__)(ImportStage::stage); \
+	EXODUS_IMPORT_TRACE_SCOPE(stage)
@@ -57,6 +57,10 @@ static const FName JsonImportTabName("JsonImport");
 void FJsonImportModule::StartupModule(){
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	LOCTEXT("Importing textures", "Importing textures");
+	//The module is loaded by ExodusImport commandlet as well, there's no toolbar to extend then.
+	if (IsRunningCommandlet())
+		return;
+
 	FJsonImportStyle::Initialize();
 	FJsonImportStyle::ReloadTextures();
 
@@ -107,6 +111,9 @@ void FJsonImportModule::StartupModule(){
 void FJsonImportModule::ShutdownModule(){
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	if (IsRunningCommandlet())
+		return;
+
 	FJsonImportStyle::Shutdown();
 
 	FJsonImportCommands::Unregister();
@@ -4,6 +4,12 @@
 #include "UnrealUtilities.h"
 #include "builders/JointBuilder.h"
 #include "builders/PrefabBuilder.h"
+#include "builders/InstancedMeshBuilder.h"
+#include "StaticMeshBatchBuilder.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "Engine/TextureCube.h"
+#include "Materials/Material.h"
 
 #include "LocTextNamespace.h"
 
@@ -15,7 +21,7 @@ using namespace JsonObjects;
 using namespace UnrealUtilities;
 
 FString JsonImporter::getProjectImportPath() const{
-	auto result = getDefaultImportPath();
+	auto result = importRootPath.IsEmpty() ? getDefaultImportPath(): importRootPath;
 	if (result.Len() && sourceBaseName.Len())
 		result = FPaths::Combine(*result, *sourceBaseName);
 	return result;
@@ -26,49 +32,116 @@ void JsonImporter::importTerrainData(JsonObjPtr jsonData, JsonId terrainId, cons
 	JsonTerrainData terrainData;
 	terrainData.load(jsonData);
 
+	importTerrainData(terrainData, terrainId);
+}
+
+void JsonImporter::importTerrainData(const JsonTerrainData &terrainData, JsonId terrainId){
 	terrainDataMap.Add(terrainId, terrainData);
 }
 
+/*
+All the load* functions below parse json on worker threads (see ResourceParsePipeline.h),
+and only create unreal assets here, in the order of resource ids.
+
+Resources that haven't changed since the last import are not rebuilt, their assets are taken from the manifest.
+
+Terrains are not in the manifest. Landscapes are built into the scene level, and a level that already exists 
+is never reimported (see importSceneObjectsAsWorld), so a changed terrain only shows up after the level is deleted.
+*/
 void JsonImporter::loadTerrains(const StringArray &terrains){
 	FScopedSlowTask terProgress(terrains.Num(), LOCTEXT("Importing terrains", "Importing terrains"));
 	terProgress.MakeDialog();
-	JsonId id = 0;
-	for(auto curFilename: terrains){
-		auto obj = loadExternResourceFromFile(curFilename);//cur->AsObject();
-		auto curId= id;
-		id++;
-		if (!obj.IsValid())
-			continue;
-
-		importTerrainData(obj, curId, assetRootPath);
-		terProgress.EnterProgressFrame(1.0f);
-	}
+	runResourceParsePipeline<ParsedResource<JsonTerrainData>>(terrains.Num(), 
+		[&](int32 index){
+			return parseExternResource<JsonTerrainData>(terrains[index]);
+		},
+		[&](int32 index, const ParsedResource<JsonTerrainData> &terrainData){
+			if (terrainData.isValid())
+				importTerrainData(terrainData.get(), index);
+			terProgress.EnterProgressFrame(1.0f);
+		}
+	);
 }
 
 void JsonImporter::loadCubemaps(const StringArray &cubemaps){
 	FScopedSlowTask texProgress(cubemaps.Num(), LOCTEXT("Importing cubemaps", "Importing cubemaps"));
 	texProgress.MakeDialog();
 	UE_LOG(JsonLog, Log, TEXT("Processing textures"));
-	for(auto curFilename: cubemaps){
-		auto obj = loadExternResourceFromFile(curFilename);
-		if (!obj.IsValid())
-			continue;
-		importCubemap(obj, assetRootPath);
-		texProgress.EnterProgressFrame(1.0f);
-	}
+	runResourceParsePipeline<ParsedResource<JsonCubemap>>(cubemaps.Num(), 
+		[&](int32 index){
+			return parseExternResource<JsonCubemap>(cubemaps[index]);
+		},
+		[&](int32 index, const ParsedResource<JsonCubemap> &jsonCube){
+			if (jsonCube.isValid())
+				importCubemap(jsonCube.get(), assetRootPath);
+			texProgress.EnterProgressFrame(1.0f);
+		}
+	);
 }
 
 void JsonImporter::loadTextures(const StringArray & textures){
 	FScopedSlowTask texProgress(textures.Num(), LOCTEXT("Importing textures", "Importing textures"));
 	texProgress.MakeDialog();
 	UE_LOG(JsonLog, Log, TEXT("Processing textures"));
-	for(auto curFilename: textures){
-		auto obj = loadExternResourceFromFile(curFilename);
-		if (!obj.IsValid())
-			continue;
-		importTexture(obj, assetRootPath);
-		texProgress.EnterProgressFrame(1.0f);
-	}
+	runResourceParsePipeline<ParsedResource<JsonTexture>>(textures.Num(), 
+		[&](int32 index){
+			auto result = parseExternResource<JsonTexture>(textures[index]);
+			if (result.isValid()){
+				const auto &jsonTex = result.get();
+				StringArray imageHashes;
+				result.contentHash = hashResourceFiles(textures[index], 
+					{FPaths::Combine(assetRootPath, jsonTex.path)}, &imageHashes);
+				//Only the settings importTexture actually uses. Extension matters, since the factory picks the format by it.
+				if (imageHashes.Num() && !imageHashes[0].IsEmpty()){
+					result.contentKey = FString::Printf(TEXT("%s|%s|normal%d"), *imageHashes[0], 
+						*FPaths::GetExtension(jsonTex.path).ToLower(), (int)jsonTex.isNormalMap());
+				}
+			}
+			return result;
+		},
+		[&](int32 index, const ParsedResource<JsonTexture> &parsedTex){
+			if (!parsedTex.isValid()){
+				texProgress.EnterProgressFrame(1.0f);
+				return;
+			}
+
+			const auto &jsonTex = parsedTex.get();
+			const auto &key = textures[index];
+			const auto resType = FString(TEXT("texture"));
+			StringArray dependencies;
+			bool rebuilt = true;
+
+			auto canonicalId = findCanonicalResource(resType, parsedTex.contentKey);
+			auto canonicalPath = textureTable.findPath(canonicalId);
+			if (canonicalPath){
+				addResourceDependency(dependencies, textures, canonicalId);
+				textureTable.add(jsonTex.id, FString(*canonicalPath));
+				resourceDeduplicator.addMerged(resType, parsedTex.contentKey, jsonTex.id, jsonTex.name);
+				rebuilt = textures.IsValidIndex(canonicalId) && importManifest.wasRebuilt(textures[canonicalId]);
+			}
+			else{
+				auto reused = findReusableAssets(key, parsedTex.contentHash, dependencies);
+				auto reusedPath = reused ? reused->findAsset(TEXT("texture")): nullptr;
+				if (reusedPath){
+					textureTable.add(jsonTex.id, *reusedPath);
+				}
+				else{
+					TGuardValue<bool> rebuildGuard(rebuildingChangedAssets, importManifest.wasImportedBefore(key));
+					importTexture(jsonTex, assetRootPath);
+				}
+				rebuilt = !reusedPath;
+			}
+
+			TMap<FString, FString> assets;
+			if (auto texPath = textureTable.findPath(jsonTex.id)){
+				assets.Add(TEXT("texture"), *texPath);
+				resourceDeduplicator.addCanonical(resType, parsedTex.contentKey, jsonTex.id, jsonTex.name);
+			}
+			importManifest.record(key, parsedTex.contentHash, dependencies, assets, rebuilt);
+
+			texProgress.EnterProgressFrame(1.0f);
+		}
+	);
 }
 
 void JsonImporter::loadSkeletons(const StringArray &skeletons){
@@ -77,20 +150,46 @@ void JsonImporter::loadSkeletons(const StringArray &skeletons){
 	UE_LOG(JsonLog, Log, TEXT("Processing skeletons"));
 
 	jsonSkeletons.Empty();
-
-	for(int id = 0; id < skeletons.Num(); id++){
-		const auto& curFilename = skeletons[id];
-		auto obj = loadExternResourceFromFile(curFilename);
-		if (!obj.IsValid()){
-			continue;
+	compatibleSkeletonIds.Empty();
+
+	runResourceParsePipeline<ParsedResource<JsonSkeleton>>(skeletons.Num(), 
+		[&](int32 index){
+			JsonSkeleton jsonSkel;
+			if (!loadStreamedResourceFromFile(jsonSkel, skeletons[index]))
+				return ParsedResource<JsonSkeleton>();
+			auto hierarchyKey = jsonSkel.makeHierarchyKey();
+			ParsedResource<JsonSkeleton> result(MoveTemp(jsonSkel));
+			result.contentHash = hashResourceFiles(skeletons[index]);
+			result.contentKey = hierarchyKey;
+			return result;
+		},
+		[&](int32 id, const ParsedResource<JsonSkeleton> &parsedSkel){
+			if (parsedSkel.isValid()){
+				const auto &jsonSkel = parsedSkel.get();
+				jsonSkeletons.Add(id, jsonSkel);
+				UE_LOG(JsonLog, Log, TEXT("Loaded json skeleotn #%d (%s)"), jsonSkel.id, *jsonSkel.name);
+
+				if (deduplicateResources){
+					const FString resType = TEXT("skeleton");
+					auto canonicalId = resourceDeduplicator.findCanonical(resType, parsedSkel.contentKey);
+					if (canonicalId >= 0){
+						UE_LOG(JsonLog, Log, TEXT("Skeleton %d has the same hierarchy as %d, they will share skeleton and animations"), id, canonicalId);
+						compatibleSkeletonIds.Add(id, canonicalId);
+						resourceDeduplicator.addMerged(resType, parsedSkel.contentKey, id, jsonSkel.name);
+					}
+					else{
+						resourceDeduplicator.addCanonical(resType, parsedSkel.contentKey, id, jsonSkel.name);
+					}
+				}
+
+				//USkeleton assets are made together with skeletal meshes, here we only need to know if the skeleton changed.
+				const auto &key = skeletons[id];
+				bool changed = !findReusableAssets(key, parsedSkel.contentHash, StringArray());
+				importManifest.record(key, parsedSkel.contentHash, StringArray(), TMap<FString, FString>(), changed);
+			}
+			skelProgress.EnterProgressFrame(1.0f);
 		}
-
-		JsonSkeleton jsonSkel(obj);
-		jsonSkeletons.Add(id, jsonSkel);
-		UE_LOG(JsonLog, Log, TEXT("Loaded json skeleotn #%d (%s)"), jsonSkel.id, *jsonSkel.name);
-
-		skelProgress.EnterProgressFrame(1.0f);
-	}
+	);
 }
 
 void JsonImporter::loadMaterials(const StringArray &materials){
@@ -98,63 +197,170 @@ void JsonImporter::loadMaterials(const StringArray &materials){
 	matProgress.MakeDialog();
 	UE_LOG(JsonLog, Log, TEXT("Processing materials"));
 	jsonMaterials.Empty();
-	for(auto curFilename: materials){
-		auto obj = loadExternResourceFromFile(curFilename);
-		if (!obj.IsValid())
-			continue;
-
-		JsonMaterial jsonMat(obj);
-		jsonMaterials.Add(jsonMat);
-		if (!jsonMat.supportedShader){
-			UE_LOG(JsonLog, Warning, TEXT("Material \"%s\"(id: %d) is marked as having unsupported shader \"%s\""),
-				*jsonMat.name, jsonMat.id, *jsonMat.shader);
+	runResourceParsePipeline<ParsedResource<JsonMaterial>>(materials.Num(), 
+		[&](int32 index){
+			auto result = parseExternResource<JsonMaterial>(materials[index]);
+			if (result.isValid())
+				result.contentHash = hashResourceFiles(materials[index]);
+			return result;
+		},
+		[&](int32 index, const ParsedResource<JsonMaterial> &parsedMat){
+			if (!parsedMat.isValid()){
+				matProgress.EnterProgressFrame(1.0f);
+				return;
+			}
+
+			const auto &jsonMat = parsedMat.get();
+			jsonMaterials.Add(jsonMat);
+			if (!jsonMat.supportedShader){
+				UE_LOG(JsonLog, Warning, TEXT("Material \"%s\"(id: %d) is marked as having unsupported shader \"%s\""),
+					*jsonMat.name, jsonMat.id, *jsonMat.shader);
+			}
+
+			const auto &key = materials[index];
+			StringArray dependencies;
+			for(auto texId: jsonMat.getTextureIds())
+				addResourceDependency(dependencies, externResources.textures, texId);
+
+			auto reused = findReusableAssets(key, parsedMat.contentHash, dependencies);
+			auto reusedPath = reused ? reused->findAsset(TEXT("materialInstance")): nullptr;
+			if (reusedPath){
+				registerMaterialInstancePath(jsonMat.id, *reusedPath);
+			}
+			else{
+				EXODUS_IMPORT_SCOPE(Material);
+				TGuardValue<bool> rebuildGuard(rebuildingChangedAssets, importManifest.wasImportedBefore(key));
+				auto matInst = materialBuilder.importMaterialInstance(jsonMat, this);
+				if (matInst){
+					registerMaterialInstancePath(jsonMat.id, matInst->GetPathName(), matInst);
+				}
+			}
+
+			TMap<FString, FString> assets;
+			if (auto matPath = materialInstanceTable.findPath(jsonMat.id))
+				assets.Add(TEXT("materialInstance"), *matPath);
+			importManifest.record(key, parsedMat.contentHash, dependencies, assets, !reusedPath);
+
+			//importMaterialInstance(jsonMat, curId);
+			matProgress.EnterProgressFrame(1.0f);
 		}
-
-		auto matInst = materialBuilder.importMaterialInstance(jsonMat, this);
-		if (matInst){
-			registerMaterialInstancePath(jsonMat.id, matInst->GetPathName());
-		}
-
-		//importMaterialInstance(jsonMat, curId);
-		matProgress.EnterProgressFrame(1.0f);
-	}
+	);
 }
 
 void JsonImporter::loadMeshes(const StringArray &meshes){
 	FScopedSlowTask meshProgress(meshes.Num(), LOCTEXT("Importing materials", "Importing meshes"));
 	meshProgress.MakeDialog();
 	UE_LOG(JsonLog, Log, TEXT("Processing meshes"));
-	int32 meshId = 0;
-	for(auto curFilename: meshes){
-		auto obj = loadExternResourceFromFile(curFilename);
-		auto curId = meshId;
-		meshId++;//and this one too...
-		if (!obj.IsValid())
-			continue;
-		importMesh(obj, curId);
-		meshProgress.EnterProgressFrame(1.0f);
-	}
+	StaticMeshBatchBuilder meshBatch;
+	TGuardValue<StaticMeshBatchBuilder*> batchGuard(staticMeshBatch, &meshBatch);
+	runResourceParsePipeline<ParsedResource<JsonMesh>>(meshes.Num(), 
+		[&](int32 meshId){
+			JsonMesh jsonMesh;
+			if (!loadJsonMeshFromFile(jsonMesh, meshes[meshId]))
+				return ParsedResource<JsonMesh>();
+			StringArray extraFiles;
+			if (!jsonMesh.binaryDataPath.IsEmpty())
+				extraFiles.Add(FPaths::Combine(sourceExternDataPath, jsonMesh.binaryDataPath));
+			ParsedResource<JsonMesh> result(MoveTemp(jsonMesh));
+			result.contentHash = hashResourceFiles(meshes[meshId], extraFiles);
+			if (deduplicateResources)
+				result.contentKey = result.get().makeContentKey();
+			return result;
+		},
+		[&](int32 meshId, const ParsedResource<JsonMesh> &parsedMesh){
+			if (!parsedMesh.isValid()){
+				meshProgress.EnterProgressFrame(1.0f);
+				return;
+			}
+
+			const auto &jsonMesh = parsedMesh.get();
+			const auto &key = meshes[meshId];
+			StringArray dependencies;
+			for(auto matId: jsonMesh.materials)
+				addResourceDependency(dependencies, externResources.materials, matId);
+			if (jsonMesh.hasBlendShapes() || jsonMesh.hasBoneWeights())
+				addResourceDependency(dependencies, externResources.skeletons, jsonMesh.defaultSkeletonId);
+
+			const auto resType = FString(TEXT("mesh"));
+			bool rebuilt = true;
+			auto canonicalId = findCanonicalResource(resType, parsedMesh.contentKey);
+			if ((canonicalId != INDEX_NONE) && aliasMeshAssets(jsonMesh, canonicalId)){
+				addResourceDependency(dependencies, meshes, canonicalId);
+				resourceDeduplicator.addMerged(resType, parsedMesh.contentKey, jsonMesh.id.toIndex(), jsonMesh.name);
+				rebuilt = meshes.IsValidIndex(canonicalId) && importManifest.wasRebuilt(meshes[canonicalId]);
+			}
+			else{
+				auto reused = findReusableAssets(key, parsedMesh.contentHash, dependencies);
+				if (reused && !reused->findAsset(TEXT("staticMesh")))
+					reused = nullptr;//failed last time, try again.
+				if (reused){
+					UE_LOG(JsonLog, Log, TEXT("Mesh %d is unchanged, reusing existing assets"), meshId);
+					registerReusedMeshAssets(jsonMesh, *reused);
+				}
+				else{
+					UE_LOG(JsonLog, Log, TEXT("Importing mesh %d"), meshId);
+					TGuardValue<bool> rebuildGuard(rebuildingChangedAssets, importManifest.wasImportedBefore(key));
+					importMesh(jsonMesh, meshId);
+				}
+				rebuilt = !reused;
+			}
+
+			auto assets = collectMeshAssets(jsonMesh);
+			if (assets.Num())
+				resourceDeduplicator.addCanonical(resType, parsedMesh.contentKey, jsonMesh.id.toIndex(), jsonMesh.name);
+			importManifest.record(key, parsedMesh.contentHash, dependencies, assets, rebuilt);
+			meshProgress.EnterProgressFrame(1.0f);
+		}
+	);
+
+	auto numFailed = meshBatch.flush();
+	if (numFailed > 0)
+		UE_LOG(JsonLog, Warning, TEXT("%d static meshes failed to build"), numFailed);
 }
 
 void JsonImporter::loadObjects(const TArray<JsonGameObject> &objects, ImportContext &importData){
 	FScopedSlowTask objProgress(objects.Num(), LOCTEXT("Importing objects", "Importing objects"));
 	objProgress.MakeDialog();
 	UE_LOG(JsonLog, Log, TEXT("Import objects"));
+
+	IdSet parentIds;
+	if (instanceStaticMeshes){
+		for(const auto &curObj: objects){
+			if (curObj.hasParent())
+				parentIds.Add(curObj.parentId);
+		}
+	}
+	InstancedMeshBuilder instancedMeshes(instancingCellSize);
+
 	//int32 objId = 0;
 	for(const auto &curObj: objects){
 		//auto curId = objId;
 		//objId++;
-		importObject(curObj, importData);
+		if (instanceStaticMeshes && InstancedMeshBuilder::canInstance(importData, curObj, parentIds)){
+			instancedMeshes.addObject(importData, curObj);
+		}
+		else{
+			importObject(curObj, importData);
+		}
 		objProgress.EnterProgressFrame(1.0f);
 	}
+	instancedMeshes.buildInstances(importData, this);
 
 	JointBuilder jointBuilder;
-	jointBuilder.processPhysicsJoints(objects, importData);
+	jointBuilder.processPhysicsJoints(importData);
 	processDelayedAnimators(objects, importData);
 }
 
 void JsonImporter::importResources(const JsonExternResourceList &externRes){
 	assetCommonPath = findCommonPath(externRes.resources);
+	resourceDeduplicator.clear();
+
+	textureTable.reserve(externRes.textures.Num());
+	cubemapTable.reserve(externRes.cubemaps.Num());
+	materialInstanceTable.reserve(externRes.materials.Num());
+	skeletonTable.reserve(externRes.skeletons.Num());
+	staticMeshTable.reserve(externRes.meshes.Num());
+	skinMeshTable.reserve(externRes.meshes.Num());
 
 	loadTextures(externRes.textures);
 	loadCubemaps(externRes.cubemaps);
@@ -164,10 +370,42 @@ void JsonImporter::importResources(const JsonExternResourceList &externRes){
 	importPrefabs(externRes.prefabs);
 	loadTerrains(externRes.terrains);
 
+	if (resourceDeduplicator.getMerged().Num() > 0){
+		UE_LOG(JsonLog, Display, TEXT("Identical resources merged: %d textures, %d meshes"),
+			resourceDeduplicator.getNumMerged(TEXT("texture")), resourceDeduplicator.getNumMerged(TEXT("mesh")));
+	}
+
 	//loadAnimClipsDebug(externRes.animationClips);
 	//loadAnimatorsDebug(externRes.animatorControllers); 
 }
 
+FString JsonImporter::hashResourceFiles(const FString &resFilename, const StringArray &extraFiles, 
+		StringArray *outExtraFileHashes) const{
+	StringArray files;
+	files.Add(FPaths::Combine(sourceExternDataPath, resFilename));
+	files.Append(extraFiles);
+	auto result = ImportManifest::hashFiles(files, outExtraFileHashes);
+	if (outExtraFileHashes && outExtraFileHashes->Num())
+		outExtraFileHashes->RemoveAt(0);//that's the resource json itself
+	return result;
+}
+
+void JsonImporter::addResourceDependency(StringArray &outDependencies, const StringArray &resPaths, int32 index){
+	if (!resPaths.IsValidIndex(index))
+		return;
+	outDependencies.AddUnique(resPaths[index]);
+}
+
+int32 JsonImporter::findCanonicalResource(const FString &type, const FString &contentKey) const{
+	if (!deduplicateResources)
+		return INDEX_NONE;
+	return resourceDeduplicator.findCanonical(type, contentKey);
+}
+
+const ImportManifest::Entry* JsonImporter::findReusableAssets(const FString &resKey, const FString &hash, const StringArray &dependencies) const{
+	return importManifest.findReusableEntry(resKey, hash, dependencies);
+}
+
 JsonObjPtr JsonImporter::loadExternResourceFromFile(const FString &filename) const{
 	auto fullPath = FPaths::Combine(sourceExternDataPath, filename);
 	return loadJsonFromFile(fullPath);
@@ -180,11 +418,11 @@ void JsonImporter::setupAssetPaths(const FString &jsonFilename){
 	assetRootPath = sourceExternDataPath;
 }
 
-void JsonImporter::registerMasterMaterialPath(int32 id, FString path){
-	if (matMasterIdMap.Contains(id)){
+void JsonImporter::registerMasterMaterialPath(int32 id, const FString &path, UMaterial *material){
+	if (masterMaterialTable.contains(id)){
 		UE_LOG(JsonLog, Warning, TEXT("DUplicate material registration for id %d, path \"%s\""), id, *path);
 	}
-	matMasterIdMap.Add(id, path);
+	masterMaterialTable.add(id, path, material);
 }
 
 void JsonImporter::registerEmissiveMaterial(int32 id){
@@ -192,25 +430,21 @@ void JsonImporter::registerEmissiveMaterial(int32 id){
 }
 
 FString JsonImporter::getMeshPath(ResId id) const{
-	auto result = meshIdMap.Find(id);
+	auto result = staticMeshTable.findPath(id.toIndex());
 	if (result)
 		return *result;
 	return FString();
 }
 
 UStaticMesh* JsonImporter::loadStaticMeshById(ResId id) const{
-	auto path = meshIdMap.Find(id);
-	if (!path)
-		return nullptr;
-	auto result = LoadObject<UStaticMesh>(0, **path);
-	return result;
+	return staticMeshTable.resolve(id.toIndex());
 }
 
-void JsonImporter::registerMaterialInstancePath(int32 id, FString path){
-	if (matInstIdMap.Contains(id)){
+void JsonImporter::registerMaterialInstancePath(int32 id, const FString &path, UMaterialInstanceConstant *matInst){
+	if (materialInstanceTable.contains(id)){
 		UE_LOG(JsonLog, Warning, TEXT("Duplicate material registration for id %d, path \"%s\""), id, *path);
 	}
-	matInstIdMap.Add(id, path);
+	materialInstanceTable.add(id, path, matInst);
 }
 
 UMaterialInterface* JsonImporter::loadMaterialInterface(int32 id) const{
@@ -219,46 +453,44 @@ UMaterialInterface* JsonImporter::loadMaterialInterface(int32 id) const{
 
 
 USkeleton* JsonImporter::getSkeletonObject(int32 id) const{
-	auto found = skeletonIdMap.Find(id);
-	if (!found)
-		return nullptr;
-	auto result = LoadObject<USkeleton>(nullptr, **found);
-	return result;
+	return skeletonTable.resolve(getCompatibleSkeletonId(id));
+}
+
+JsonId JsonImporter::getCompatibleSkeletonId(JsonId id) const{
+	auto found = compatibleSkeletonIds.Find(id);
+	return found ? *found: id;
 }
 
 void JsonImporter::registerSkeleton(int32 id, USkeleton *skel){
 	check(skel);
 	check(id >= 0);
 
-	if (skeletonIdMap.Contains(id)){
+	//Whichever compatible skeleton gets built first becomes the one for the whole group.
+	auto groupId = getCompatibleSkeletonId(id);
+	if (skeletonTable.contains(groupId)){
 		UE_LOG(JsonLog, Log, TEXT("Duplicate skeleton registration for id %d"), id);
 		return;
 	}
 
-	auto path = skel->GetPathName();
-	skeletonIdMap.Add(id, path);
+	skeletonTable.add(groupId, skel);
 	//auto outer = skel->
 }
 
-UAnimSequence* JsonImporter::getAnimSequence(AnimClipIdKey key) const{
-	auto found = animClipPaths.Find(key);
-	if (!found)
-		return nullptr;
-	return LoadObject<UAnimSequence>(nullptr, **found);
-}
-
 void JsonImporter::registerAnimSequence(AnimClipIdKey key, UAnimSequence *sequence){
 	check(sequence);
-	if (animClipPaths.Contains(key)){
+	if (animSequences.Contains(key)){
 		UE_LOG(JsonLog, Warning, TEXT("Duplicate animation clip regsitration for skeleton %d; clip %d"), key.Key, key.Value)
 		return;
 	}
-	auto path = sequence->GetPathName();
-	animClipPaths.Add(key, path);
+	animSequences.Add(key).set(sequence->GetPathName(), sequence);
 }
 
 const FString* JsonImporter::findMeshPath(ResId meshId) const{
-	return meshIdMap.Find(meshId);
+	return staticMeshTable.findPath(meshId.toIndex());
+}
+
+const FString* JsonImporter::findSkinMeshPath(ResId meshId) const{
+	return skinMeshTable.findPath(meshId.toIndex());
 }
 
 void JsonImporter::importPrefabs(const StringArray &prefabs){
@@ -279,7 +511,7 @@ void JsonImporter::importPrefabs(const StringArray &prefabs){
 			continue;
 
 		PrefabBuilder builder;
-		auto prefab = JsonPrefabData(obj);
+		JsonPrefabData prefab(obj);
 
 		builder.importPrefab(prefab, this);
 		//importPrefab(prefab);
@@ -10,14 +10,23 @@
 #include "JsonObjects/JsonMaterial.h"
 #include "JsonObjects.h"
 #include "ImportContext.h"
+#include "ResourceParsePipeline.h"
+#include "ImportManifest.h"
+#include "ImportProfiler.h"
+#include "ResolvedObjectTable.h"
+#include "ResourceDeduplicator.h"
+#include "AnimationBuilder.h"
 #include "ObjectTools.h"
 #include "Editor/UnrealEd/Public/PackageTools.h"
 
+class UStaticMesh;
 class USkeletalMesh;
+class UMaterial;
 class UTexture;
 class UTextureCube;
 class USkeleton;
 class UAnimSequence;
+class StaticMeshBatchBuilder;
 
 class JsonImporter{
 protected:
@@ -25,19 +34,22 @@ protected:
 	FString sourceExternDataPath;
 	FString assetCommonPath;
 	FString sourceBaseName;
-	ResIdNameMap meshIdMap;
-	ResIdNameMap skinMeshIdMap;
-	IdNameMap texIdMap;
-	IdNameMap cubeIdMap;
-	IdNameMap matMasterIdMap;
-	IdNameMap matInstIdMap;
+	ResolvedObjectTable<UStaticMesh> staticMeshTable;
+	ResolvedObjectTable<USkeletalMesh> skinMeshTable;
+	ResolvedObjectTable<UTexture> textureTable;
+	ResolvedObjectTable<UTextureCube> cubemapTable;
+	ResolvedObjectTable<UMaterial> masterMaterialTable;
+	ResolvedObjectTable<UMaterialInstanceConstant> materialInstanceTable;
 	JsonExternResourceList externResources;
 
 	TArray<JsonMaterial> jsonMaterials;
 	TMap<JsonId, JsonSkeleton> jsonSkeletons;
-	IdNameMap skeletonIdMap;
+	//Skeletons with the same bone hierarchy as an earlier one point to it. Such skeletons share USkeleton and anim sequences.
+	TMap<JsonId, JsonId> compatibleSkeletonIds;
+	ResolvedObjectTable<USkeleton> skeletonTable;
 
-	AnimClipPathMap animClipPaths;//UAnimationSequence
+	//keyed by skeleton and clip, not dense.
+	TMap<AnimClipIdKey, ResolvedObjectRef<UAnimSequence>> animSequences;
 
 	//TMap<JsonId, Json
 	//IdNameMap animatorControllerIdMap;
@@ -55,6 +67,33 @@ protected:
 	IdSet emissiveMaterials;
 	MaterialBuilder materialBuilder;
 
+	ImportManifest importManifest;
+	bool deduplicateResources = true;
+	ResourceDeduplicator resourceDeduplicator;
+	//Set by loadMeshes. When there is one, static meshes are only filled by importStaticMesh and built later in batches.
+	StaticMeshBatchBuilder *staticMeshBatch = nullptr;
+	//Set while a resource from the previous import is being rebuilt, existing assets are replaced instead of reused/renamed.
+	bool rebuildingChangedAssets = false;
+
+	//Content path imported assets go to. Empty means UnrealUtilities::getDefaultImportPath()
+	FString importRootPath;
+	//No message boxes. Set by the commandlet.
+	bool unattended = false;
+	StringArray importedWorlds;
+	//See InstancedMeshBuilder
+	bool instanceStaticMeshes = false;
+	float instancingCellSize = 0.0f;
+	//Components per landscape tile along each axis, 0 means one landscape actor per terrain. See TerrainBuilder.
+	int32 landscapeTileComponents = 0;
+	//Catmull-rom instead of linear when the height map has to be resized. See terrainTools.
+	bool smoothLandscapeResampling = false;
+	AnimationKeyReduction animationKeyReduction;
+	//One entry per built anim sequence
+	TArray<AnimationClipStats> animationClipStats;
+	FString profileBaseFilename;
+
+	void showImportMessage(const FText &message) const;
+
 	static void registerImportedObject(ImportedObjectArray *outArray, const ImportedObject &arg);
 
 	UWorld* importSceneObjectsAsWorld(const JsonScene &scene, const FString &sceneNameOverride, const FString &scenePathOverride);
@@ -69,10 +108,11 @@ protected:
 	void importPrefabs(const StringArray &prefabs);
 
 	void importTerrainData(JsonObjPtr jsonData, JsonId terrainId, const FString &rootPath);
+	void importTerrainData(const JsonTerrainData &terrainData, JsonId terrainId);
 	void loadTerrains(const StringArray &terrains);
 
-	void registerMaterialInstancePath(int32 id, FString path);
-	void registerMasterMaterialPath(int32 id, FString path);
+	void registerMaterialInstancePath(int32 id, const FString &path, UMaterialInstanceConstant *matInst = nullptr);
+	void registerMasterMaterialPath(int32 id, const FString &path, UMaterial *material = nullptr);
 
 	void importStaticMesh(const JsonMesh &jsonMesh, int32 meshId);
 	void importSkeletalMesh(const JsonMesh &jsonMesh, int32 meshId);
@@ -80,8 +120,20 @@ protected:
 	void loadAnimatorsDebug(const StringArray &animatorPaths);
 	void loadAnimClipsDebug(const StringArray &animClipPaths);
 
+	/*
+	One anim sequence is built per clip and skeleton compatibility group, see getCompatibleSkeletonId.
+	It goes next to the first controller that uses the clip with that group.
+	*/
+	struct AnimSequenceRequest{
+		JsonId skelGroupId = -1;
+		FString clipDir;
+	};
+	using AnimSequenceRequestMap = TMap<JsonId, TArray<AnimSequenceRequest>>;
+
 	void processDelayedAnimators(const TArray<JsonGameObject> &objects, ImportContext &workData);
-	void processDelayedAnimator(JsonId skelId, JsonId controllerId);
+	void collectDelayedAnimClips(JsonId skelId, JsonId controllerId, AnimSequenceRequestMap &outRequests, int32 &outNumShared);
+	void buildAnimSequence(JsonId clipIndex, const JsonAnimationClip &animClip, const AnimSequenceRequest &request, 
+		const FString &clipKey, const FString &clipHash);
 
 	template<typename T> bool loadIndexedExternResource(T& outObj, int index, const StringArray &resPaths) const{
 		if ((index < 0 ) || (index >= resPaths.Num())){
@@ -99,21 +151,69 @@ protected:
 		outObj.load(data);
 		return true;
 	}
+
+	/*
+	Same as above, but goes through JsonStreamReader instead of building FJsonObject.
+	For big resources - meshes, skeletons, clips.
+	*/
+	template<typename T> bool loadIndexedStreamedResource(T& outObj, int index, const StringArray &resPaths) const{
+		if ((index < 0 ) || (index >= resPaths.Num())){
+			UE_LOG(JsonLog, Warning, TEXT("Could not load indexed extern resource %d"), index);
+			return false;
+		}
+
+		const auto &resPath = resPaths[index];
+		if (!loadStreamedResourceFromFile(outObj, resPath)){
+			UE_LOG(JsonLog, Warning, TEXT("Could not load indexed extern resource %d (%s)"), index, *resPath);
+			return false;
+		}
+		return true;
+	}
+
+	template<typename T> bool loadStreamedResourceFromFile(T& outObj, const FString &filename) const{
+		auto fullPath = FPaths::Combine(sourceExternDataPath, filename);
+		return JsonObjects::loadJsonStreamFromFile(outObj, fullPath);
+	}
+
+	/*
+	Loads extern resource file into a json struct. Safe to call from worker threads.
+	*/
+	template<typename T> ParsedResource<T> parseExternResource(const FString &filename) const{
+		auto obj = loadExternResourceFromFile(filename);
+		if (!obj.IsValid())
+			return ParsedResource<T>();
+		return ParsedResource<T>(T(obj));
+	}
+
+	/*
+	Incremental re-import helpers, see ImportManifest.
+	Keys are extern resource filenames from JsonExternResourceList.
+	*/
+	FString hashResourceFiles(const FString &resFilename, const StringArray &extraFiles = StringArray(), 
+		StringArray *outExtraFileHashes = nullptr) const;
+	static void addResourceDependency(StringArray &outDependencies, const StringArray &resPaths, int32 index);
+	const ImportManifest::Entry* findReusableAssets(const FString &resKey, const FString &hash, const StringArray &dependencies) const;
+	TMap<FString, FString> collectMeshAssets(const JsonMesh &jsonMesh) const;
+	void registerReusedMeshAssets(const JsonMesh &jsonMesh, const ImportManifest::Entry &entry);
+	//Points jsonMesh at the assets of an identical mesh imported earlier.
+	bool aliasMeshAssets(const JsonMesh &jsonMesh, int32 canonicalId);
+	int32 findCanonicalResource(const FString &type, const FString &contentKey) const;
+
+	//Streams mesh json and opens its binary sidecar, if there's one.
+	bool loadJsonMeshFromFile(JsonMesh &outMesh, const FString &filename) const;
+	bool loadMeshBinaryData(JsonMesh &jsonMesh) const;
 public:
 	const TMap<JsonId, JsonTerrainData>& getTerrainDataMap() const{
 		return terrainDataMap;
 	}
 
-	const ResIdNameMap& getSkinMeshIdMap() const{
-		return skinMeshIdMap;
-	}
-
 	const FString *findMeshPath(ResId meshId) const;
+	const FString *findSkinMeshPath(ResId meshId) const;
 
-	UAnimSequence* getAnimSequence(AnimClipIdKey key) const;
 	void registerAnimSequence(AnimClipIdKey key, UAnimSequence *sequence);
 
 	USkeleton* getSkeletonObject(int32 id) const;
+	JsonId getCompatibleSkeletonId(JsonId id) const;
 	void registerSkeleton(int32 id, USkeleton *skel);
 
 	JsonMesh loadJsonMesh(int32 id) const;
@@ -123,6 +223,57 @@ public:
 	JsonAnimatorController loadAnimationController(JsonId id) const;
 
 	void registerEmissiveMaterial(int32 id);
+
+	bool isRebuildingChangedAssets() const{
+		return rebuildingChangedAssets;
+	}
+	void setImportRootPath(const FString &path){
+		importRootPath = path;
+	}
+	void setUnattended(bool newValue){
+		unattended = newValue;
+	}
+	void setStaticMeshInstancing(bool enabled, float cellSize = 0.0f){
+		instanceStaticMeshes = enabled;
+		instancingCellSize = cellSize;
+	}
+	void setResourceDeduplication(bool enabled){
+		deduplicateResources = enabled;
+	}
+	void setLandscapeTiling(int32 componentsPerTile){
+		landscapeTileComponents = FMath::Max(0, componentsPerTile);
+	}
+	int32 getLandscapeTileComponents() const{
+		return landscapeTileComponents;
+	}
+	void setSmoothLandscapeResampling(bool enabled){
+		smoothLandscapeResampling = enabled;
+	}
+	bool isSmoothLandscapeResampling() const{
+		return smoothLandscapeResampling;
+	}
+	void setAnimationKeyReduction(const AnimationKeyReduction &newValue){
+		animationKeyReduction = newValue;
+	}
+	const TArray<AnimationClipStats>& getAnimationClipStats() const{
+		return animationClipStats;
+	}
+	const TArray<ResourceDeduplicator::MergedResource>& getMergedResources() const{
+		return resourceDeduplicator.getMerged();
+	}
+	bool isUnattended() const{
+		return unattended;
+	}
+	const StringArray& getImportedWorlds() const{
+		return importedWorlds;
+	}
+	const ImportManifest& getImportManifest() const{
+		return importManifest;
+	}
+	//Without extension, ImportProfiler writes .csv and .json next to each other
+	const FString& getProfileBaseFilename() const{
+		return profileBaseFilename;
+	}
 	const FString& getAssetRootPath() const{
 		return assetRootPath;
 	}
@@ -133,6 +284,7 @@ public:
 	UTextureCube* getCubemap(int32 id) const;
 	UTextureCube* loadCubemap(int32 id) const;
 	void importCubemap(JsonObjPtr data, const FString &rootPath);
+	void importCubemap(const JsonCubemap &jsonCube, const FString &rootPath);
 
 	//UMaterialInstanceConstant* getMaterialInstance(int32 id) const;
 	const JsonSkeleton* getSkeleton(int32 id) const;
@@ -148,7 +300,7 @@ public:
 	UStaticMesh *loadStaticMeshById(ResId id) const;
 	USkeletalMesh *loadSkeletalMeshById(ResId id) const;
 
-	void importProject(const FString& path);
+	bool importProject(const FString& path);
 
 	void importResources(const JsonExternResourceList &resources);
 	void loadCubemaps(const StringArray &cubemaps);
@@ -193,9 +345,7 @@ public:
 
 		FString packageName;
 
-		FString packageRoot = TEXT("/Game/Import");
-		if (sourceBaseName.Len())
-			packageRoot = packageRoot + TEXT("/") + sourceBaseName;
+		FString packageRoot = getProjectImportPath();
 		const int maxObjDirLength = 64;
 
 		if (objDir.Len() > 0){
@@ -236,6 +386,10 @@ public:
 
 		if (existingObj){
 			package = existingObj->GetOutermost();
+			if (rebuildingChangedAssets){
+				//Still returned, callers rebuild into it. A new object under the same name would replace it while it is in use.
+				UE_LOG(JsonLog, Log, TEXT("Source of \"%s\" has changed, existing object will be rebuilt"), *existingObj->GetPathName());
+			}
 		}
 		else{
 			UE_LOG(JsonLog, Log, TEXT("Creating package %s"), *packageName);
@@ -85,14 +85,80 @@ void JsonImporter::processAnimator(ImportContext &workData, const JsonGameObject
 	workData.registerDelayedAnimController(skelId, animatorId);
 }
 
+/*
+Controllers only list clip ids, so all of them are gathered first.
+Then every clip that needs building is parsed once, on workers, and built for each skeleton group that uses it.
+A clip used by a crowd of characters with the same rig becomes one sequence.
+*/
 void JsonImporter::processDelayedAnimators(const TArray<JsonGameObject> &objects, ImportContext &workData){
-	FScopedSlowTask delayedAnimProgress(workData.delayedAnimControllers.Num(), 
-		LOCTEXT("Processing animator controllers", "Processing animator controllers"));
+	EXODUS_IMPORT_SCOPE(Animators);
 
+	AnimSequenceRequestMap clipRequests;
+	int32 numShared = 0;
 	for(const auto& i: workData.delayedAnimControllers){
-		processDelayedAnimator(i.Key, i.Value);
-		delayedAnimProgress.EnterProgressFrame();
+		collectDelayedAnimClips(i.Key, i.Value, clipRequests, numShared);
+	}
+
+	struct PendingClip{
+		JsonId clipIndex = -1;
+		FString clipHash;
+		TArray<AnimSequenceRequest> requests;
+	};
+	TArray<PendingClip> pendingClips;
+	for(const auto &curClip: clipRequests){
+		const auto clipIndex = curClip.Key;
+		if (!externResources.animationClips.IsValidIndex(clipIndex)){
+			UE_LOG(JsonLog, Warning, TEXT("Invalid animation clip %d referenced by animator controllers"), clipIndex);
+			continue;
+		}
+		PendingClip pending;
+		pending.clipIndex = clipIndex;
+		pending.clipHash = hashResourceFiles(externResources.animationClips[clipIndex]);
+		//Unchanged clips aren't even parsed.
+		for(const auto &request: curClip.Value){
+			StringArray clipDependencies;
+			addResourceDependency(clipDependencies, externResources.skeletons, request.skelGroupId);
+			auto clipKey = FString::Printf(TEXT("%s|skel%d"), *externResources.animationClips[clipIndex], request.skelGroupId);
+			auto reused = findReusableAssets(clipKey, pending.clipHash, clipDependencies);
+			auto reusedPath = reused ? reused->findAsset(TEXT("animSequence")): nullptr;
+			if (reusedPath){
+				UE_LOG(JsonLog, Log, TEXT("Anim clip %d is unchanged, reusing \"%s\""), clipIndex, **reusedPath);
+				importManifest.record(clipKey, pending.clipHash, clipDependencies, reused->assets, false);
+				continue;
+			}
+			pending.requests.Add(request);
+		}
+		if (pending.requests.Num() > 0)
+			pendingClips.Add(MoveTemp(pending));
 	}
+	UE_LOG(JsonLog, Log, TEXT("Animator controllers: %d clips to build, %d clip uses shared between compatible skeletons or controllers"),
+		pendingClips.Num(), numShared);
+
+	FScopedSlowTask delayedAnimProgress(pendingClips.Num(), 
+		LOCTEXT("Processing animator controllers", "Processing animator controllers"));
+
+	runResourceParsePipeline<ParsedResource<JsonAnimationClip>>(pendingClips.Num(),
+		[&](int32 index){
+			JsonAnimationClip animClip;
+			if (!loadStreamedResourceFromFile(animClip, externResources.animationClips[pendingClips[index].clipIndex]))
+				return ParsedResource<JsonAnimationClip>();
+			return ParsedResource<JsonAnimationClip>(MoveTemp(animClip));
+		},
+		[&](int32 index, const ParsedResource<JsonAnimationClip> &parsedClip){
+			const auto &pending = pendingClips[index];
+			if (!parsedClip.isValid()){
+				UE_LOG(JsonLog, Warning, TEXT("Could not load animation clip %d (%s)"), 
+					pending.clipIndex, *externResources.animationClips[pending.clipIndex]);
+			}
+			else{
+				for(const auto &request: pending.requests){
+					auto clipKey = FString::Printf(TEXT("%s|skel%d"), *externResources.animationClips[pending.clipIndex], request.skelGroupId);
+					buildAnimSequence(pending.clipIndex, parsedClip.get(), request, clipKey, pending.clipHash);
+				}
+			}
+			delayedAnimProgress.EnterProgressFrame();
+		}
+	);
 
 	for(const auto objId: workData.postProcessAnimatorObjects){
 		if ((objId < 0) || (objId >= objects.Num()))
@@ -100,7 +166,7 @@ void JsonImporter::processDelayedAnimators(const TArray<JsonGameObject> &objects
 	}
 }
 
-void JsonImporter::processDelayedAnimator(JsonId skelId, JsonId controllerId){
+void JsonImporter::collectDelayedAnimClips(JsonId skelId, JsonId controllerId, AnimSequenceRequestMap &outRequests, int32 &outNumShared){
 	UE_LOG(JsonLog, Log, TEXT("Processing animator: skelId: %d, controllerId: %d"), skelId, controllerId);
 	if (skelId < 0){
 		UE_LOG(JsonLog, Warning, TEXT("Skeleton not found while processing delayed animator %d(skel) %d(controller)"),
@@ -126,32 +192,58 @@ void JsonImporter::processDelayedAnimator(JsonId skelId, JsonId controllerId){
 		return;
 	}
 
+	auto skelGroupId = getCompatibleSkeletonId(skelId);
 	auto controllerPath = FPaths::GetPath(animController.path);
 	auto baseName = FPaths::GetBaseFilename(animController.path);
-
-	auto animBaseName = FString::Printf(TEXT("%s_skel%d"), *baseName, skelId);
-
-	auto clipDir = FString::Printf(TEXT("%s/%s"), *controllerPath, *animBaseName);
+	auto animBaseName = FString::Printf(TEXT("%s_skel%d"), *baseName, skelGroupId);
 
 	for(const auto clipIndex: animController.animationIds){
-		JsonAnimationClip animClip;
-		if (!loadIndexedExternResource(animClip, clipIndex, externResources.animationClips)){
-			UE_LOG(JsonLog, Warning, TEXT("Coudl not load animation clip %d while processing animation with skelId: %d; controllerId: %d"),
-				clipIndex, skelId, controllerId);
+		auto &requests = outRequests.FindOrAdd(clipIndex);
+		if (requests.ContainsByPredicate([&](const auto &arg){return arg.skelGroupId == skelGroupId;})){
+			outNumShared++;
+			continue;
 		}
+		AnimSequenceRequest newRequest;
+		newRequest.skelGroupId = skelGroupId;
+		newRequest.clipDir = FString::Printf(TEXT("%s/%s"), *controllerPath, *animBaseName);
+		requests.Add(newRequest);
+	}
+}
+
+void JsonImporter::buildAnimSequence(JsonId clipIndex, const JsonAnimationClip &animClip, const AnimSequenceRequest &request, 
+		const FString &clipKey, const FString &clipHash){
+	auto skeleton = getSkeletonObject(request.skelGroupId);
+	if (!skeleton){
+		//Skeleton failed to build or load, the whole group goes without clips.
+		UE_LOG(JsonLog, Warning, TEXT("No skeleton for skeleton group %d, skipping anim clip %d(%s)"), 
+			request.skelGroupId, clipIndex, *animClip.name);
+		return;
+	}
+
+	StringArray clipDependencies;
+	addResourceDependency(clipDependencies, externResources.skeletons, request.skelGroupId);
+
+	AnimationBuilder animBuilder(animationKeyReduction);
+
+	auto clipDir = request.clipDir;
+	bool replaceExisting = importManifest.wasImportedBefore(clipKey);
+	TGuardValue<bool> rebuildGuard(rebuildingChangedAssets, replaceExisting);
+	UAnimSequence *newSeq = createAssetObject<UAnimSequence>(animClip.name, &clipDir, this, 
+		[&](UAnimSequence *newSeq){
+			newSeq->SetSkeleton(skeleton);
+			animationClipStats.Add(animBuilder.buildAnimation(newSeq, skeleton, animClip));
+		}, nullptr, RF_Standalone|RF_Public, !replaceExisting
+	);
+	if (!newSeq){
+		UE_LOG(JsonLog, Warning, TEXT("Could not create anim clip %d for skeleton %d"), clipIndex, request.skelGroupId);
+		return;
+	}
+	UE_LOG(JsonLog, Log, TEXT("Created anim clip at \"%s\""), *newSeq->GetPathName());
+	registerAnimSequence(AnimClipIdKey(request.skelGroupId, clipIndex), newSeq);
 
-		AnimationBuilder animBuilder;
-
-		UAnimSequence *newSeq = createAssetObject<UAnimSequence>(animClip.name, &clipDir, this, 
-			[&](UAnimSequence *newSeq){
-				newSeq->SetSkeleton(skeleton);
-				animBuilder.buildAnimation(newSeq, skeleton, animClip);
-			}, RF_Standalone|RF_Public
-		);
-		UE_LOG(JsonLog, Log, TEXT("Created anim clip at \"%s\""), *newSeq->GetPathName());
-		//createAssetObject(
-		//auto assetObj = createAssetObject(
-	}	
+	TMap<FString, FString> assets;
+	assets.Add(TEXT("animSequence"), newSeq->GetPathName());
+	importManifest.record(clipKey, clipHash, clipDependencies, assets, true);
 }
 
 #undef LOCTEXT_NAMESPACE
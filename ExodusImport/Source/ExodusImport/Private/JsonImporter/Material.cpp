@@ -36,16 +36,11 @@ UMaterialInstanceConstant* JsonImporter::loadMaterialInstance(int32 id) const{
 		return 0;
 	}
 
-	auto foundPath = matInstIdMap.Find(id);
-	if (!foundPath){
+	if (!materialInstanceTable.contains(id)){
 		UE_LOG(JsonLog, Log, TEXT("Id %d is not in the map"), id);
 		return 0;
 	}
-	auto matPath = *foundPath;
-	UMaterialInstanceConstant *mat = Cast<UMaterialInstanceConstant>(
-		StaticLoadObject(UMaterialInstanceConstant::StaticClass(), 0, *matPath));
-	UE_LOG(JsonLog, Log, TEXT("Material instance located"));
-	return mat;
+	return materialInstanceTable.resolve(id);
 }
 
 
@@ -56,16 +51,11 @@ UMaterial* JsonImporter::loadMasterMaterial(int32 id) const{
 		return 0;
 	}
 
-	auto foundPath = matMasterIdMap.Find(id);
-	if (!foundPath){
+	if (!masterMaterialTable.contains(id)){
 		UE_LOG(JsonLog, Log, TEXT("Id %d is not in the map"), id);
 		return 0;
 	}
-
-	auto matPath = *foundPath;
-	UMaterial *mat = Cast<UMaterial>(StaticLoadObject(UMaterial::StaticClass(), 0, *matPath));
-	UE_LOG(JsonLog, Log, TEXT("Material located"));
-	return mat;
+	return masterMaterialTable.resolve(id);
 }
 
 const JsonMaterial* JsonImporter::getJsonMaterial(int32 id) const{
@@ -33,6 +33,7 @@
 #include "DesktopPlatformModule.h"
 #include "MeshBuilder.h"
 #include "SkeletalMeshBuilder.h"
+#include "StaticMeshBatchBuilder.h"
 #include "PhysicsEngine/BodySetup.h"
 
 using namespace UnrealUtilities;
@@ -44,22 +45,29 @@ void JsonImporter::importStaticMesh(const JsonMesh &jsonMesh, int32 meshId){
 	auto mesh = createAssetObject<UStaticMesh>(unrealMeshName, &desiredDir, this, 
 		[&](UStaticMesh *mesh){
 			MeshBuilder meshBuilder;
-			meshBuilder.setupStaticMesh(mesh, jsonMesh, [&](auto &materials){
+			auto materialSetup = [&](TArray<FStaticMaterial> &materials){
 				materials.Empty();
 				for(auto matId: jsonMesh.materials){
 					UMaterialInterface *material = loadMaterialInterface(matId);
 					materials.Add(material);
 				}
-			});
+			};
+			//Rebuilt meshes are built right away, while their components have render state torn down.
+			if (staticMeshBatch && !isRebuildingChangedAssets()){
+				meshBuilder.fillStaticMesh(mesh, jsonMesh, materialSetup);
+				staticMeshBatch->add(mesh, StaticMeshBuildInfo(jsonMesh));
+			}
+			else{
+				meshBuilder.setupStaticMesh(mesh, jsonMesh, materialSetup);
+			}
 		},
 		[&](auto pkg, auto objName){
 			return NewObject<UStaticMesh>(pkg, FName(*objName), RF_Standalone|RF_Public);
-		}, RF_Standalone|RF_Public
+		}, RF_Standalone|RF_Public, !isRebuildingChangedAssets()
 	);
 
 	if (mesh){
-		auto meshPath = mesh->GetPathName();
-		meshIdMap.Add(jsonMesh.id, meshPath);
+		staticMeshTable.add(jsonMesh.id.toIndex(), mesh);
 	}
 }
 
@@ -94,24 +102,23 @@ void JsonImporter::importSkeletalMesh(const JsonMesh &jsonMesh, int32 meshId){
 		},
 		[&](auto pkg, auto objName){
 			return NewObject<USkeletalMesh>(pkg, FName(*objName), RF_Standalone|RF_Public);
-		}, RF_Standalone|RF_Public
+		}, RF_Standalone|RF_Public, !isRebuildingChangedAssets()
 	);
 
 	if (mesh){
-		auto meshPath = mesh->GetPathName();
-		skinMeshIdMap.Add(jsonMesh.id, meshPath);
+		skinMeshTable.add(jsonMesh.id.toIndex(), mesh);
 	}
 }
 
 void JsonImporter::importMesh(const JsonMesh &jsonMesh, int32 meshId){
 	UE_LOG(JsonLog, Log, TEXT("Importing mesh: %s(%d)"), *jsonMesh.name, jsonMesh.id.id)
 	UE_LOG(JsonLog, Log, TEXT("Mesh data: Verts: %d; submeshes: %d; materials: %d; colors %d; normals: %d"), 
-		jsonMesh.verts.Num(), jsonMesh.subMeshes.Num(), jsonMesh.colors.Num(), jsonMesh.normals.Num());
+		jsonMesh.getVerts().Num(), jsonMesh.subMeshes.Num(), jsonMesh.getColors().Num(), jsonMesh.getNormals().Num());
 	UE_LOG(JsonLog, Log, TEXT("Mesh data: uv0: %d; uv1: %d; uv2: %d; uv3: %d; uv4: %d; uv5: %d; uv6: %d; uv7: %d;"),
-		jsonMesh.uv0.Num(), jsonMesh.uv1.Num(), jsonMesh.uv2.Num(), jsonMesh.uv3.Num(), 
-		jsonMesh.uv4.Num(), jsonMesh.uv5.Num(), jsonMesh.uv6.Num(), jsonMesh.uv7.Num());
+		jsonMesh.getUv(0).Num(), jsonMesh.getUv(1).Num(), jsonMesh.getUv(2).Num(), jsonMesh.getUv(3).Num(), 
+		jsonMesh.getUv(4).Num(), jsonMesh.getUv(5).Num(), jsonMesh.getUv(6).Num(), jsonMesh.getUv(7).Num());
 
-	if (jsonMesh.verts.Num() <= 0){
+	if (jsonMesh.getVerts().Num() <= 0){
 		UE_LOG(JsonLog, Warning, TEXT("No verts found in the mesh %d!"), jsonMesh.id.id);
 	}
 
@@ -133,6 +140,7 @@ void JsonImporter::importMesh(JsonObjPtr obj, int32 meshId){
 	UE_LOG(JsonLog, Log, TEXT("Importing mesh %d"), meshId);
 
 	JsonMesh jsonMesh(obj);
+	loadMeshBinaryData(jsonMesh);
 
 	importMesh(jsonMesh, meshId);
 }
@@ -143,8 +151,71 @@ JsonMesh JsonImporter::loadJsonMesh(int32 id) const{
 		return JsonMesh();
 	}
 
-	auto meshData = loadExternResourceFromFile(externResources.meshes[id]);
-	return JsonMesh(meshData);
+	JsonMesh result;
+	loadJsonMeshFromFile(result, externResources.meshes[id]);
+	return result;
+}
+
+TMap<FString, FString> JsonImporter::collectMeshAssets(const JsonMesh &jsonMesh) const{
+	TMap<FString, FString> result;
+	if (auto found = staticMeshTable.findPath(jsonMesh.id.toIndex()))
+		result.Add(TEXT("staticMesh"), *found);
+	if (auto found = skinMeshTable.findPath(jsonMesh.id.toIndex())){
+		result.Add(TEXT("skinMesh"), *found);
+		//Skeleton is made by the first skin mesh of its compatibility group, so it has to be remembered here.
+		if (auto foundSkel = skeletonTable.findPath(getCompatibleSkeletonId(jsonMesh.defaultSkeletonId)))
+			result.Add(TEXT("skeleton"), *foundSkel);
+	}
+	return result;
+}
+
+void JsonImporter::registerReusedMeshAssets(const JsonMesh &jsonMesh, const ImportManifest::Entry &entry){
+	if (auto found = entry.findAsset(TEXT("staticMesh")))
+		staticMeshTable.add(jsonMesh.id.toIndex(), *found);
+	if (auto found = entry.findAsset(TEXT("skinMesh")))
+		skinMeshTable.add(jsonMesh.id.toIndex(), *found);
+	auto foundSkel = entry.findAsset(TEXT("skeleton"));
+	if (foundSkel && (jsonMesh.defaultSkeletonId >= 0)){
+		//Same key registerSkeleton and getSkeletonObject use.
+		auto skelGroupId = getCompatibleSkeletonId(jsonMesh.defaultSkeletonId);
+		if (!skeletonTable.contains(skelGroupId))
+			skeletonTable.add(skelGroupId, *foundSkel);
+	}
+}
+
+bool JsonImporter::aliasMeshAssets(const JsonMesh &jsonMesh, int32 canonicalId){
+	//Copies, since adding to the table may reallocate it.
+	auto staticPath = staticMeshTable.findPath(canonicalId);
+	auto skinPath = skinMeshTable.findPath(canonicalId);
+	FString staticMeshPath = staticPath ? *staticPath: FString();
+	FString skinMeshPath = skinPath ? *skinPath: FString();
+	if (staticMeshPath.IsEmpty() && skinMeshPath.IsEmpty())
+		return false;
+
+	auto meshId = jsonMesh.id.toIndex();
+	if (!staticMeshPath.IsEmpty())
+		staticMeshTable.add(meshId, staticMeshPath);
+	if (!skinMeshPath.IsEmpty())
+		skinMeshTable.add(meshId, skinMeshPath);
+	return true;
+}
+
+bool JsonImporter::loadJsonMeshFromFile(JsonMesh &outMesh, const FString &filename) const{
+	if (!loadStreamedResourceFromFile(outMesh, filename))
+		return false;
+	return loadMeshBinaryData(outMesh);
+}
+
+bool JsonImporter::loadMeshBinaryData(JsonMesh &jsonMesh) const{
+	if (jsonMesh.binaryDataPath.IsEmpty())
+		return true;
+
+	auto fullPath = FPaths::Combine(sourceExternDataPath, jsonMesh.binaryDataPath);
+	if (!jsonMesh.loadBinaryData(fullPath)){
+		UE_LOG(JsonLog, Error, TEXT("Could not load binary data \"%s\" of mesh %d"), *fullPath, jsonMesh.id.toIndex());
+		return false;
+	}
+	return true;
 }
 
 const JsonSkeleton* JsonImporter::getSkeleton(int32 id) const{
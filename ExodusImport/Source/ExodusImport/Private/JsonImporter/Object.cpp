@@ -75,10 +75,11 @@ Add handling of prefab instances according to those rules.
 */
 ImportedObject JsonImporter::importObject(const JsonGameObject &jsonGameObj, ImportContext &workData, bool createEmptyTransforms){
 	using namespace UnrealUtilities;
+	EXODUS_IMPORT_SCOPE(ObjectSpawn);
 
 	auto* parentObject = workData.findImportedObject(jsonGameObj.parentId);
 
-	auto folderPath = workData.processFolderPath(jsonGameObj);
+	const auto &folderPath = workData.getFolderPath(jsonGameObj);
 	UE_LOG(JsonLog, Log, TEXT("importing object: %d(%s), folder: %s, Num Components: %d"), 
 		jsonGameObj.id, *jsonGameObj.name, *folderPath, jsonGameObj.getNumComponents());
 
@@ -297,14 +298,11 @@ ImportedObject JsonImporter::importObject(const JsonGameObject &jsonGameObj, Imp
 }
 
 USkeletalMesh* JsonImporter::loadSkeletalMeshById(ResId id) const{
-	auto foundPath = skinMeshIdMap.Find(id);
-	if (!foundPath){
+	if (!skinMeshTable.contains(id.toIndex())){
 		UE_LOG(JsonLog, Warning, TEXT("Could not load skin mesh %d"), id.toIndex());
 		return nullptr;
 	}
-
-	auto result = LoadObject<USkeletalMesh>(nullptr, **foundPath);
-	return result;
+	return skinMeshTable.resolve(id.toIndex());
 }
 
 void JsonImporter::registerImportedObject(ImportedObjectArray *outArray, const ImportedObject &arg){
@@ -33,6 +33,7 @@
 #include "PackageTools.h"
 
 #include "UnrealUtilities.h"
+#include "Misc/ScopeExit.h"
 #include "JsonObjects.h"
 #include "Runtime/AssetRegistry/Public/AssetRegistryModule.h"
 #include "UnrealEd/Public/Editor.h"
@@ -95,7 +96,8 @@ UWorld* JsonImporter::importSceneObjectsAsWorld(const JsonScene &scene, const FS
 		FString("Level"), &outPackageName, &outWorldName, &existingWorld);
 
 	if (existingWorld){
-		UE_LOG(JsonLog, Warning, TEXT("World already exists for %s(%s)"), *sceneName, *scenePath);
+		//Not rebuilt, even if terrains it uses have changed. Delete the level to get it reimported.
+		UE_LOG(JsonLog, Warning, TEXT("World already exists for %s(%s), skipping it"), *sceneName, *scenePath);
 		return nullptr;
 	}
 
@@ -136,27 +138,47 @@ FString getWorldPackagePath(UWorld *world){
 	return filePath;
 }
 
-void JsonImporter::importProject(const FString& filename){
+void JsonImporter::showImportMessage(const FText &message) const{
+	if (unattended || IsRunningCommandlet()){
+		UE_LOG(JsonLog, Display, TEXT("%s"), *message.ToString());
+		return;
+	}
+	FMessageDialog::Debugf(message);
+}
+
+bool JsonImporter::importProject(const FString& filename){
 	setupAssetPaths(filename);
+	importedWorlds.Empty();
+
+	auto &profiler = ImportProfiler::get();
+	profiler.beginSession(sourceBaseName);
+	ON_SCOPE_EXIT{
+		profiler.endSession();
+		profiler.logSummary();
+		profileBaseFilename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"), 
+			FString::Printf(TEXT("ExodusImportProfile_%s"), *sourceBaseName));
+		profiler.writeSummary(profileBaseFilename);
+	};
+
 	auto jsonData = loadJsonFromFile(filename);
 	if (!jsonData){
 		UE_LOG(JsonLog, Error, TEXT("Json loading failed, aborting. \"%s\""), *filename);
-		return;
+		return false;
 	}
 
 	JsonProject project(jsonData);
 	externResources = project.externResources;
 
+	importManifest.load(ImportManifest::makeManifestFilename(getProjectImportPath()));
 	importResources(externResources);
 	const auto& scenes = externResources.scenes;
 
 	auto singleScene = externResources.scenes.Num() == 1;
-	auto createWorldFlag = !singleScene;
+	//Nothing would save the editor level when running unattended, so scenes always become separate worlds then.
+	auto createWorldFlag = !singleScene || unattended;
 	FString lastWorldPackage;
 	FScopedSlowTask sceneProgress(scenes.Num(), LOCTEXT("Importing scenes", "Importing scenes"));
 
-	StringArray importedWorlds;
-
 	sceneProgress.MakeDialog();
 	for(int i = 0; i < scenes.Num(); i++){
 		const auto& sceneFile = scenes[i];
@@ -170,7 +192,7 @@ void JsonImporter::importProject(const FString& filename){
 			if (singleScene){
 				if (scene.containsTerrain()){
 					//FMessageDialog::Debugf(TEXT("The scene you're importing contains terrain, and will be imported as a new level"));
-					FMessageDialog::Debugf(LOCTEXT("Scene contains terrain", "The scene you're importing contains terrain, and will be imported as a new level"));
+					showImportMessage(LOCTEXT("Scene contains terrain", "The scene you're importing contains terrain, and will be imported as a new level"));
 					createWorldRequired = true;
 				}
 			}
@@ -186,14 +208,17 @@ void JsonImporter::importProject(const FString& filename){
 		sceneProgress.EnterProgressFrame();
 	}
 
+	importManifest.save();
+
 	if (importedWorlds.Num() > 0){
 		FString text = TEXT("Scenes imported as:\n");
 		for(const auto& cur: importedWorlds){
 			text += FString::Printf(TEXT("%s\n"), *cur);
 		}
 		text += TEXT("If you imported scenes with terrain, please wait till shaders finish compiling.");
-		FMessageDialog::Debugf(FText::FromString(text));
+		showImportMessage(FText::FromString(text));
 	}
+	return true;
 }
 
 #undef LOCTEXT_NAMESPACE
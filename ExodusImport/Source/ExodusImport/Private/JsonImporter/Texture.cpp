@@ -20,7 +20,7 @@ UTextureCube* JsonImporter::getCubemap(int32 id) const{
 }
 
 UTextureCube* JsonImporter::loadCubemap(int32 id) const{
-	return staticLoadResourceById<UTextureCube>(cubeIdMap, id, TEXT("cubemap"));
+	return cubemapTable.resolve(id);
 }
 
 bool loadTextureData(ByteArray &outData, const FString &path){
@@ -111,6 +111,10 @@ static bool loadCompressedBinary(ByteArray &outData, const FString &filename){
 
 void JsonImporter::importCubemap(JsonObjPtr data, const FString &rootPath){
 	JsonCubemap jsonCube(data);
+	importCubemap(jsonCube, rootPath);
+}
+
+void JsonImporter::importCubemap(const JsonCubemap &jsonCube, const FString &rootPath){
 	UE_LOG(JsonLog, Log, TEXT("Cubemap: %d, %s, %s (%s), %dx%d"), 
 		jsonCube.id, *jsonCube.name, *jsonCube.assetPath, *jsonCube.exportPath, 
 		jsonCube.texParams.width, jsonCube.texParams.height);
@@ -125,7 +129,7 @@ void JsonImporter::importCubemap(JsonObjPtr data, const FString &rootPath){
 		&packageName, &textureName, &existingTexture);
 
 	if (existingTexture){
-		cubeIdMap.Add(jsonCube.id, existingTexture->GetPathName());
+		cubemapTable.add(jsonCube.id, existingTexture);
 		UE_LOG(JsonLog, Warning, TEXT("Cube texture %s already exists, package %s"), *textureName, *packageName);
 		return;
 	}
@@ -208,7 +212,7 @@ void JsonImporter::importCubemap(JsonObjPtr data, const FString &rootPath){
 	//cubeTex->Source.
 
 	if (cubeTex){
-		cubeIdMap.Add(jsonCube.id, cubeTex->GetPathName());
+		cubemapTable.add(jsonCube.id, cubeTex);
 		cubeTex->PostEditChange();
 		FAssetRegistryModule::AssetCreated(cubeTex);
 		texturePackage->SetDirtyFlag(true);
@@ -222,7 +226,7 @@ UTexture* JsonImporter::getTexture(int32 id) const{
 }
 
 UTexture* JsonImporter::loadTexture(int32 id) const{
-	return staticLoadResourceById<UTexture>(texIdMap, id, TEXT("texture"));
+	return textureTable.resolve(id);
 }
 
 void JsonImporter::importTexture(JsonObjPtr obj, const FString &rootPath){
@@ -231,17 +235,11 @@ void JsonImporter::importTexture(JsonObjPtr obj, const FString &rootPath){
 }
 
 void JsonImporter::importTexture(const JsonTexture &jsonTex, const FString &rootPath){
+	EXODUS_IMPORT_SCOPE(Texture);
 	UE_LOG(JsonLog, Log, TEXT("Texture: %s, %s, %d x %d"), 
 		*jsonTex.path, *jsonTex.name, jsonTex.width, jsonTex.height);
 
-	bool isNormalMap = false;
-	
-	if (jsonTex.importDataFound && jsonTex.normalMapFlag){
-		isNormalMap = true;
-	}
-	else{
-		isNormalMap = jsonTex.name.EndsWith(FString("_n")) || jsonTex.name.EndsWith(FString("Normals"));
-	}
+	bool isNormalMap = jsonTex.isNormalMap();
 
 	if (isNormalMap){
 		UE_LOG(JsonLog, Log, TEXT("Texture recognized as normalmap: %s(%s)"), *jsonTex.name, *jsonTex.path);
@@ -256,8 +254,9 @@ void JsonImporter::importTexture(const JsonTexture &jsonTex, const FString &root
 	UPackage *texturePackage = createPackage(jsonTex.name, jsonTex.path, rootPath, FString("Texture"), 
 		&packageName, &textureName, &existingTexture);
 
-	if (existingTexture){
-		texIdMap.Add(jsonTex.id, existingTexture->GetPathName());
+	//When rebuilding, the texture factory reimports into the existing texture, same as editor reimport does.
+	if (existingTexture && !rebuildingChangedAssets){
+		textureTable.add(jsonTex.id, existingTexture);
 		UE_LOG(JsonLog, Warning, TEXT("Texutre %s already exists, package %s"), *textureName, *packageName);
 		return;
 	}
@@ -277,9 +276,13 @@ void JsonImporter::importTexture(const JsonTexture &jsonTex, const FString &root
 		UE_LOG(JsonLog, Warning, TEXT("New path: %s"), *fileSystemPath);
 	}
 
-	if (!FFileHelper::LoadFileToArray(binaryData, *fileSystemPath)){
-		UE_LOG(JsonLog, Warning, TEXT("Could not load texture %s(%s)"), *jsonTex.name, *jsonTex.path);
-		return;
+	{
+		EXODUS_IMPORT_SCOPE(FileRead);
+		if (!FFileHelper::LoadFileToArray(binaryData, *fileSystemPath)){
+			UE_LOG(JsonLog, Warning, TEXT("Could not load texture %s(%s)"), *jsonTex.name, *jsonTex.path);
+			return;
+		}
+		ImportProfiler::addBytesRead(binaryData.Num());
 	}
 
 	if (binaryData.Num() <= 0){
@@ -303,9 +306,10 @@ void JsonImporter::importTexture(const JsonTexture &jsonTex, const FString &root
 		UTexture2D::StaticClass(), texturePackage, *textureName, RF_Standalone|RF_Public, 0, *ext, data, data + binaryData.Num(), GWarn);
 
 	if (unrealTexture){
-		texIdMap.Add(jsonTex.id, unrealTexture->GetPathName());
+		textureTable.add(jsonTex.id, unrealTexture);
 		FAssetRegistryModule::AssetCreated(unrealTexture);
 		texturePackage->SetDirtyFlag(true);
+		ImportProfiler::addAssetCreated();
 	}
 	texFab->RemoveFromRoot();
 }
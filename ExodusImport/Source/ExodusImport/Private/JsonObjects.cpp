@@ -1,6 +1,7 @@
 #include "JsonImportPrivatePCH.h"
 #include "JsonObjects.h"
 #include "JsonLog.h"
+#include "ImportProfiler.h"
 
 #define LOCTEXT_NAMESPACE LOCTEXT_NAMESPACE_NAME
 
@@ -8,12 +9,10 @@ using namespace JsonObjects;
 
 JsonObjPtr JsonObjects::loadJsonFromFile(const FString &filename){
 	FString jsonString;
-	if (!FFileHelper::LoadFileToString(jsonString, *filename)){
-		UE_LOG(JsonLog, Warning, TEXT("Could not load json file \"%s\""), *filename);
+	if (!loadJsonTextFromFile(jsonString, filename))
 		return 0;
-	}
 
-	UE_LOG(JsonLog, Log, TEXT("Loaded json file \"%s\""), *filename);
+	EXODUS_IMPORT_SCOPE(JsonParse);
 	JsonReaderRef reader = TJsonReaderFactory<>::Create(jsonString);
 
 	JsonObjPtr jsonData = MakeShareable(new FJsonObject());
@@ -17,6 +17,7 @@
 #include "JsonObjects/loggers.h"
 #include "JsonObjects/getters.h"
 #include "JsonObjects/utilities.h"
+#include "JsonObjects/JsonStreamReader.h"
 
 #include "JsonObjects/JsonTexture.h"
 #include "JsonObjects/JsonCubemap.h"
@@ -20,26 +20,36 @@ public:
 		return (width == 0) || (height == 0);
 	}
 
+	//Square planes are transposed in place, others need one temporary buffer.
 	void transpose(){
-		auto oldData = data;
 		auto srcWidth = getWidth();
 		auto srcHeight = getHeight();
+		if (srcWidth == srcHeight){
+			DataPlaneUtility::transposeSquareInPlace(getData(), srcWidth);
+			return;
+		}
+		auto oldData = MoveTemp(data);
 		resize(srcHeight, srcWidth);
 		DataPlaneUtility::transpose2dData(getData(), oldData.GetData(), srcWidth, srcHeight);
 	}
 
+	//Doesn't allocate if out already has enough room.
+	void getTransposed(DataPlane2D<T> &out) const{
+		check(&out != this);
+		out.resize(getHeight(), getWidth());
+		DataPlaneUtility::transpose2dData(out.getData(), getData(), getWidth(), getHeight());
+	}
+
 	DataPlane2D<T> getTransposed() const{
-		auto srcWidth = getWidth();
-		auto srcHeight = getHeight();
-		DataPlane2D<T> result(srcHeight, srcWidth);
-		DataPlaneUtility::transpose2dData(result.getData(), getData(), srcWidth, srcHeight);
+		DataPlane2D<T> result;
+		getTransposed(result);
 		return result;
 	}
 
 	void resize(int32 width_, int32 height_){
 		width = width_;
 		height = height_;
-		data.SetNum(width * height);
+		data.SetNum(width * height, false);//keeps the allocation, so planes can be reused as scratch buffers
 		numTotalEls = width * height;
 	}
 
@@ -83,6 +93,12 @@ public:
 		return data;
 	}
 
+	//Hands the buffer over without copying, the plane is left empty.
+	DataArray releaseArray(){
+		width = height = numTotalEls = 0;
+		return MoveTemp(data);
+	}
+
 	void saveToRaw(const FString& filename) const{
 		auto totalDataSize = sizeof(T) * numTotalEls;
 		const uint8* dataPtr = (const uint8*)data.GetData();
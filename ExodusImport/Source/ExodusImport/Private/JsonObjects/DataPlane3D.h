@@ -32,24 +32,39 @@ public:
 		numTotalEls = numLayerEls * layers;
 	}
 
+	//Transposes width and height of every layer. Square layers are done in place.
 	void transpose(){
-		auto oldData = data;
 		auto srcWidth = getWidth();
 		auto srcHeight = getHeight();
 		auto srcDepth = getNumLayers();
+		if (srcWidth == srcHeight){
+			for(int32 layer = 0; layer < srcDepth; layer++)
+				DataPlaneUtility::transposeSquareInPlace(getLayer(layer), srcWidth);
+			return;
+		}
+		auto oldData = MoveTemp(data);
 		resize(srcHeight, srcWidth, srcDepth);
 		DataPlaneUtility::transpose3dDataWidthHeight(getData(), oldData.GetData(), srcWidth, srcHeight, srcDepth);
 	}
 
+	void getTransposed(DataPlane3D<T> &out) const{
+		check(&out != this);
+		out.resize(getHeight(), getWidth(), getNumLayers());
+		DataPlaneUtility::transpose3dDataWidthHeight(out.getData(), getData(), getWidth(), getHeight(), getNumLayers());
+	}
+
 	DataPlane3D<T> getTransposed() const{
-		auto srcWidth = getWidth();
-		auto srcHeight = getHeight();
-		auto srcDepth = getNumLayers();
-		DataPlane3D<T> result(srcHeight, srcWidth, srcDepth);
-		DataPlaneUtility::transpose3dDataWidthHeight(result.getData(), getData(), srcWidth, srcHeight, srcDepth);
+		DataPlane3D<T> result;
+		getTransposed(result);
 		return result;
 	}
 
+	//Single layer, transposed, without the intermediate copy getLayerData() + transpose() would make.
+	void getTransposedLayer(DataPlane2D<T> &out, int layer) const{
+		out.resize(getHeight(), getWidth());
+		DataPlaneUtility::transpose2dData(out.getData(), getLayer(layer), getWidth(), getHeight());
+	}
+
 	void clear(){
 		resize(0, 0, 0);
 	}
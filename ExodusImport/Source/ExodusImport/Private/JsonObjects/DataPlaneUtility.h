@@ -1,19 +1,112 @@
 #pragma once
 
+#include "CoreMinimal.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	#define EXODUS_TRANSPOSE_SSE 1
+	#include <emmintrin.h>
+#else
+	#define EXODUS_TRANSPOSE_SSE 0
+#endif
+
+/*
+Transposition of row-major planes. Source is srcWidth x srcHeight, result is srcHeight x srcWidth.
+
+Done in square tiles, so both reads and writes stay within a few cache lines per tile.
+The naive row-by-row version writes with a stride of a whole row, which on 4k terrains means a cache miss per element.
+4-byte elements (floats, int32) are moved in 4x4 blocks with SSE2 when it is available.
+*/
 namespace DataPlaneUtility{
+	//32x32 4-byte elements is 4k per tile, source and destination tiles together fit L1 comfortably.
+	const int32 transposeTileSize = 32;
+
+	namespace Detail{
+		template<typename T> void transposeTileScalar(T* dst, const T* src, int32 srcWidth, int32 srcHeight,
+				int32 x0, int32 x1, int32 y0, int32 y1){
+			for(int32 y = y0; y < y1; y++){
+				const T* srcRow = src + (int64)y * srcWidth;
+				for(int32 x = x0; x < x1; x++){
+					dst[(int64)x * srcHeight + y] = srcRow[x];
+				}
+			}
+		}
+
+		template<int32 ElementSize> struct TransposeTile{
+			template<typename T> static void run(T* dst, const T* src, int32 srcWidth, int32 srcHeight,
+					int32 x0, int32 x1, int32 y0, int32 y1){
+				transposeTileScalar(dst, src, srcWidth, srcHeight, x0, x1, y0, y1);
+			}
+		};
+
+#if EXODUS_TRANSPOSE_SSE
+		template<> struct TransposeTile<4>{
+			template<typename T> static void run(T* dst, const T* src, int32 srcWidth, int32 srcHeight,
+					int32 x0, int32 x1, int32 y0, int32 y1){
+				//Integer unpacks only shuffle bits around, so it's fine for floats as well.
+				const int32 x4End = x0 + ((x1 - x0) & ~3);
+				const int32 y4End = y0 + ((y1 - y0) & ~3);
+				for(int32 y = y0; y < y4End; y += 4){
+					const T* srcRow = src + (int64)y * srcWidth;
+					for(int32 x = x0; x < x4End; x += 4){
+						__m128i r0 = _mm_loadu_si128((const __m128i*)(srcRow + x));
+						__m128i r1 = _mm_loadu_si128((const __m128i*)(srcRow + srcWidth + x));
+						__m128i r2 = _mm_loadu_si128((const __m128i*)(srcRow + srcWidth * 2 + x));
+						__m128i r3 = _mm_loadu_si128((const __m128i*)(srcRow + srcWidth * 3 + x));
+
+						__m128i t0 = _mm_unpacklo_epi32(r0, r1);
+						__m128i t1 = _mm_unpacklo_epi32(r2, r3);
+						__m128i t2 = _mm_unpackhi_epi32(r0, r1);
+						__m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+						T* dstCol = dst + (int64)x * srcHeight + y;
+						_mm_storeu_si128((__m128i*)(dstCol), _mm_unpacklo_epi64(t0, t1));
+						_mm_storeu_si128((__m128i*)(dstCol + srcHeight), _mm_unpackhi_epi64(t0, t1));
+						_mm_storeu_si128((__m128i*)(dstCol + srcHeight * 2), _mm_unpacklo_epi64(t2, t3));
+						_mm_storeu_si128((__m128i*)(dstCol + srcHeight * 3), _mm_unpackhi_epi64(t2, t3));
+					}
+				}
+				//leftovers along both edges
+				transposeTileScalar(dst, src, srcWidth, srcHeight, x4End, x1, y0, y1);
+				transposeTileScalar(dst, src, srcWidth, srcHeight, x0, x4End, y4End, y1);
+			}
+		};
+#endif
+	}
+
+	/*
+	Transposes a srcWidth x srcHeight block whose rows are srcStride elements apart,
+	so a part of a larger plane can be transposed without copying it out first.
+	*/
+	template<typename T> void transpose2dRegion(T* transposed, const T* src, int32 srcStride, int32 srcWidth, int32 srcHeight){
+		check((transposed != src) || (srcWidth * srcHeight == 0));
+		check(srcStride >= srcWidth);
+		for(int32 y0 = 0; y0 < srcHeight; y0 += transposeTileSize){
+			const int32 y1 = FMath::Min(y0 + transposeTileSize, srcHeight);
+			for(int32 x0 = 0; x0 < srcWidth; x0 += transposeTileSize){
+				const int32 x1 = FMath::Min(x0 + transposeTileSize, srcWidth);
+				Detail::TransposeTile<sizeof(T)>::run(transposed, src, srcStride, srcHeight, x0, x1, y0, y1);
+			}
+		}
+	}
+
+	//dst and src must not overlap, see transposeSquareInPlace for that.
 	template<typename T> void transpose2dData(T* transposed, const T* src, int32 srcWidth, int32 srcHeight){
-		auto srcRowData = src;
-		auto dstRowData = transposed;
-		for(int32 y = 0; y < srcHeight; y++){
-			auto srcPixData = srcRowData;
-			auto dstPixData = dstRowData;
-			for(int32 x = 0; x < srcWidth; x++){
-				*dstPixData = *srcPixData;
-				srcPixData ++;
-				dstPixData += srcWidth;
+		transpose2dRegion(transposed, src, srcWidth, srcWidth, srcHeight);
+	}
+
+	//Square planes only. Swaps tiles across the diagonal, no extra memory.
+	template<typename T> void transposeSquareInPlace(T* data, int32 size){
+		for(int32 y0 = 0; y0 < size; y0 += transposeTileSize){
+			const int32 y1 = FMath::Min(y0 + transposeTileSize, size);
+			for(int32 x0 = y0; x0 < size; x0 += transposeTileSize){
+				const int32 x1 = FMath::Min(x0 + transposeTileSize, size);
+				for(int32 y = y0; y < y1; y++){
+					//on the diagonal tile only the upper triangle is swapped
+					for(int32 x = (x0 == y0) ? y + 1: x0; x < x1; x++){
+						Swap(data[(int64)y * size + x], data[(int64)x * size + y]);
+					}
+				}
 			}
-			srcRowData += srcWidth;
-			dstRowData ++;
 		}
 	}
 
@@ -21,7 +114,7 @@ namespace DataPlaneUtility{
 	template<typename T> void transpose3dDataWidthHeight(T* transposed, const T* src, int32 srcWidth, int32 srcHeight, int32 srcDepth){
 		auto srcRowData = src;
 		auto dstRowData = transposed;
-		auto layerSize=  srcWidth * srcHeight;
+		const int64 layerSize = (int64)srcWidth * srcHeight;
 		for(int32 layer = 0; layer < srcDepth; layer++){
 			transpose2dData(dstRowData, srcRowData, srcWidth, srcHeight);
 			srcRowData += layerSize;
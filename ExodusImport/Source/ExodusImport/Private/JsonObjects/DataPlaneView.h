@@ -0,0 +1,119 @@
+#pragma once
+
+#include "JsonTypes.h"
+#include "DataPlane2D.h"
+#include "DataPlaneUtility.h"
+
+/*
+Read-only counterparts of DataPlane2D/DataPlane3D. They don't own anything, data usually lives in a mapped file
+(see JsonBinaryTerrain) and is only copied into a DataPlane2D when a conversion needs a buffer of its own.
+*/
+template<typename T> class DataPlane2DView{
+protected:
+	const T* data = nullptr;
+	int32 width = 0;
+	int32 height = 0;
+public:
+	int32 getWidth() const{return width;}
+	int32 getHeight() const{return height;}
+	int getNumRowElements() const{return width;}
+	int32 getNumElements() const{return width * height;}
+
+	bool isEmpty() const{
+		return (width == 0) || (height == 0);
+	}
+
+	const T* getData() const{
+		return data;
+	}
+
+	const T* getRow(int y) const{
+		return data + y * getNumRowElements();
+	}
+
+	T getValue(int x, int y) const{
+		return data[x + y * getNumRowElements()];
+	}
+
+	void copyTo(DataPlane2D<T> &out) const{
+		out.resize(width, height);
+		if (getNumElements() > 0)
+			FMemory::Memcpy(out.getData(), data, sizeof(T) * getNumElements());
+	}
+
+	DataPlane2D<T> getCopy() const{
+		DataPlane2D<T> result;
+		copyTo(result);
+		return result;
+	}
+
+	//Doesn't allocate if out already has enough room.
+	void getTransposed(DataPlane2D<T> &out) const{
+		out.resize(height, width);
+		DataPlaneUtility::transpose2dData(out.getData(), data, width, height);
+	}
+
+	DataPlane2D<T> getTransposed() const{
+		DataPlane2D<T> result;
+		getTransposed(result);
+		return result;
+	}
+
+	//Transposed copy of the rect (max exclusive) only, out ends up rect.Height() x rect.Width().
+	void getTransposedRegion(DataPlane2D<T> &out, const FIntRect &rect) const{
+		check((rect.Min.X >= 0) && (rect.Min.Y >= 0) && (rect.Max.X <= width) && (rect.Max.Y <= height));
+		out.resize(rect.Height(), rect.Width());
+		DataPlaneUtility::transpose2dRegion(out.getData(), getRow(rect.Min.Y) + rect.Min.X, 
+			getNumRowElements(), rect.Width(), rect.Height());
+	}
+
+	template<typename DstT, class Converter> void convertTo(DataPlane2D<DstT> &out, Converter convert) const{
+		out.resize(width, height);
+		auto numElements = getNumElements();
+		auto* dstPtr = out.getData();
+		for(auto i = 0; i < numElements; i++){
+			dstPtr[i] = convert(data[i]);
+		}
+	}
+
+	DataPlane2DView() = default;
+	DataPlane2DView(const T* data_, int32 width_, int32 height_)
+	:data(data_), width(width_), height(height_){
+	}
+	DataPlane2DView(const DataPlane2D<T> &plane)
+	:data(plane.getData()), width(plane.getWidth()), height(plane.getHeight()){
+	}
+};
+
+template<typename T> class DataPlane3DView{
+protected:
+	const T* data = nullptr;
+	int32 width = 0;
+	int32 height = 0;
+	int32 layers = 0;
+public:
+	int getWidth() const{return width;}
+	int getHeight() const{return height;}
+	int getNumLayers() const{return layers;}
+	int getNumRowElements() const{return width;}
+	int getNumLayerElements() const{return width * height;}
+	int getNumElements() const{return width * height * layers;}
+
+	const T* getData() const{
+		return data;
+	}
+
+	DataPlane2DView<T> getLayer(int layer) const{
+		check((layer >= 0) && (layer < layers));
+		return DataPlane2DView<T>(data + getNumLayerElements() * layer, width, height);
+	}
+
+	T getValue(int layer, int x, int y) const{
+		return data[getNumLayerElements() * layer + getNumRowElements() * y + x];
+	}
+
+	DataPlane3DView() = default;
+	DataPlane3DView(const T* data_, int32 width_, int32 height_, int32 layers_)
+	:data(data_), width(width_), height(height_), layers(layers_){
+	}
+};
@@ -2,6 +2,7 @@
 #include "JsonAnimation.h"
 #include"macros.h"
 #include "UnrealUtilities.h"
+#include "JsonStreamReader.h"
 
 using namespace JsonObjects;
 using namespace UnrealUtilities;
@@ -27,15 +28,15 @@ void JsonTransformKey::load(JsonObjPtr data){
 	JSON_GET_VAR_NOLOG(data, time);
 	JSON_GET_VAR_NOLOG(data, frame);
 
-	getJsonObj(data, local, "local");
-	getJsonObj(data, world, "world");
+	getJsonObj(data, local, JSON_KEY("local"));
+	getJsonObj(data, world, JSON_KEY("world"));
 }
 
 void JsonAnimationMatrixCurve::load(JsonObjPtr data){
 	JSON_GET_VAR(data, objectName);
 	JSON_GET_VAR(data, objectPath);
 
-	getJsonObjArray(data, keys, "keys");
+	getJsonObjArray(data, keys, JSON_KEY("keys"));
 }
 
 void JsonKeyframe::load(JsonObjPtr data){
@@ -53,7 +54,7 @@ void JsonAnimationCurve::load(JsonObjPtr data){
 	JSON_GET_VAR(data, preWrapMode);
 	JSON_GET_VAR(data, postWrapMode);
 
-	getJsonObjArray(data, keys, "keys");
+	getJsonObjArray(data, keys, JSON_KEY("keys"));
 }
 
 void JsonAnimationEvent::load(JsonObjPtr data){
@@ -78,15 +79,15 @@ void JsonAnimatorController::load(JsonObjPtr data){
 	JSON_GET_VAR(data, path);
 	JSON_GET_VAR(data, id);
 
-	getJsonObjArray(data, parameters, "parameters");
-	animationIds = getIntArray(data, "animationIds");
+	getJsonObjArray(data, parameters, JSON_KEY("parameters"));
+	animationIds = getIntArray(data, JSON_KEY("animationIds"));
 }
 
 void JsonAnimator::load(JsonObjPtr data){
 	JSON_GET_VAR(data, name);
 	JSON_GET_VAR(data, skeletonId);
 
-	skinMeshIds = getIntArray(data, "skinMeshIds");
+	skinMeshIds = getIntArray(data, JSON_KEY("skinMeshIds"));
 
 	JSON_GET_VAR(data, animatorControllerId);
 	JSON_GET_VAR(data, applyRootMotion);
@@ -100,7 +101,7 @@ void JsonAnimator::load(JsonObjPtr data){
 	JSON_GET_VAR(data, linearVelocityBlending);
 	JSON_GET_VAR(data, speed);
 
-	getJsonObjArray(data, humanBones, "humanBones");
+	getJsonObjArray(data, humanBones, JSON_KEY("humanBones"));
 }
 
 void JsonEditorCurveBinding::load(JsonObjPtr data){
@@ -109,7 +110,7 @@ void JsonEditorCurveBinding::load(JsonObjPtr data){
 	JSON_GET_VAR(data, isPPtrCurve);
 	JSON_GET_VAR(data, path);
 
-	getJsonObjArray(data, curves, "curves");
+	getJsonObjArray(data, curves, JSON_KEY("curves"));
 }
 
 void JsonAnimationClip::load(JsonObjPtr data){
@@ -121,13 +122,13 @@ void JsonAnimationClip::load(JsonObjPtr data){
 	JSON_GET_VAR(data, legacy);
 	JSON_GET_VAR(data, length);
 
-	getJsonObj(data, localBounds, "localBounds");
+	getJsonObj(data, localBounds, JSON_KEY("localBounds"));
 	JSON_GET_VAR(data, wrapMode);
 
-	getJsonObjArray(data, animEvents, "animEvents");
-	getJsonObjArray(data, objBindings, "objBindings");
-	getJsonObjArray(data, floatBindings, "floatBindings");
-	getJsonObjArray(data, matrixCurves, "matrixCurves");
+	getJsonObjArray(data, animEvents, JSON_KEY("animEvents"));
+	getJsonObjArray(data, objBindings, JSON_KEY("objBindings"));
+	getJsonObjArray(data, floatBindings, JSON_KEY("floatBindings"));
+	getJsonObjArray(data, matrixCurves, JSON_KEY("matrixCurves"));
 }
 
 void JsonHumanBone::load(JsonObjPtr data){
@@ -145,10 +146,110 @@ void JsonEditorCurveBinding::load(JsonObjPtr data){
 	JSON_GET_VAR(data, isPPtrCurve);
 	JSON_GET_VAR(data, path);
 
-	getJsonObjArray(data, curves, "curves");
+	getJsonObjArray(data, curves, JSON_KEY("curves"));
 }
 */
 
+/*
+Streamed versions. Clips are mostly made of transform keys, so these are the ones that matter.
+*/
+void JsonTransform::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, x);
+		JSON_STREAM_VAR(reader, field, y);
+		JSON_STREAM_VAR(reader, field, z);
+		JSON_STREAM_VAR(reader, field, pos);
+		return false;
+	});
+}
+
+void JsonTransformKey::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, time);
+		JSON_STREAM_VAR(reader, field, frame);
+		JSON_STREAM_VAR(reader, field, local);
+		JSON_STREAM_VAR(reader, field, world);
+		return false;
+	});
+}
+
+void JsonAnimationMatrixCurve::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, objectName);
+		JSON_STREAM_VAR(reader, field, objectPath);
+		JSON_STREAM_VAR(reader, field, keys);
+		return false;
+	});
+}
+
+void JsonKeyframe::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, time);
+		JSON_STREAM_VAR(reader, field, value);
+		JSON_STREAM_VAR(reader, field, weightedMode);
+		JSON_STREAM_VAR(reader, field, inTangent);
+		JSON_STREAM_VAR(reader, field, inWeight);
+		JSON_STREAM_VAR(reader, field, outTangent);
+		JSON_STREAM_VAR(reader, field, outWeight);
+		return false;
+	});
+}
+
+void JsonAnimationCurve::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, length);
+		JSON_STREAM_VAR(reader, field, preWrapMode);
+		JSON_STREAM_VAR(reader, field, postWrapMode);
+		JSON_STREAM_VAR(reader, field, keys);
+		return false;
+	});
+}
+
+void JsonAnimationEvent::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, time);
+		JSON_STREAM_VAR(reader, field, floatParameter);
+		JSON_STREAM_VAR(reader, field, intParameter);
+		JSON_STREAM_VAR(reader, field, stringParameter);
+		JSON_STREAM_VAR(reader, field, objectReferenceParameter);
+		JSON_STREAM_VAR(reader, field, isFiredByAnimator);
+		JSON_STREAM_VAR(reader, field, isFiredByLegacy);
+		return false;
+	});
+}
+
+void JsonEditorCurveBinding::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, propertyName);
+		JSON_STREAM_VAR(reader, field, isDiscreteCurve);
+		JSON_STREAM_VAR(reader, field, isPPtrCurve);
+		JSON_STREAM_VAR(reader, field, path);
+		JSON_STREAM_VAR(reader, field, curves);
+		return false;
+	});
+}
+
+void JsonAnimationClip::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, name);
+		JSON_STREAM_VAR(reader, field, id);
+		JSON_STREAM_VAR(reader, field, frameRate);
+		JSON_STREAM_VAR(reader, field, empty);
+		JSON_STREAM_VAR(reader, field, humanMotion);
+		JSON_STREAM_VAR(reader, field, isLooping);
+		JSON_STREAM_VAR(reader, field, legacy);
+		JSON_STREAM_VAR(reader, field, length);
+		JSON_STREAM_VAR(reader, field, localBounds);
+		JSON_STREAM_VAR(reader, field, wrapMode);
+
+		JSON_STREAM_VAR(reader, field, animEvents);
+		JSON_STREAM_VAR(reader, field, objBindings);
+		JSON_STREAM_VAR(reader, field, floatBindings);
+		JSON_STREAM_VAR(reader, field, matrixCurves);
+		return false;
+	});
+}
+
 FMatrix JsonTransform::getUnityTransform() const{
 	auto result = FMatrix::Identity;
 	auto x1 = x;
@@ -3,6 +3,8 @@
 #include "JsonTypes.h"
 #include "JsonObjects/JsonBounds.h"
 
+class JsonStreamReader;
+
 class JsonTransform{
 public:
 	FVector x;
@@ -13,6 +15,7 @@ public:
 	FMatrix getUnityTransform() const;
 	FMatrix getUnrealTransform() const;
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonTransform() = default;
 	JsonTransform(JsonObjPtr data){
 		load(data);
@@ -27,6 +30,7 @@ public:
 	JsonTransform world;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonTransformKey() = default;
 	JsonTransformKey(JsonObjPtr data){
 		load(data);
@@ -40,6 +44,7 @@ public:
 	TArray<JsonTransformKey> keys;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonAnimationMatrixCurve() = default;
 	JsonAnimationMatrixCurve(JsonObjPtr data){
 		load(data);
@@ -57,6 +62,7 @@ public:
 	float outWeight;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonKeyframe() = default;
 	JsonKeyframe(JsonObjPtr data){
 		load(data);
@@ -71,6 +77,7 @@ public:
 	TArray<JsonKeyframe> keys;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonAnimationCurve() = default;
 	JsonAnimationCurve(JsonObjPtr data){
 		load(data);
@@ -89,6 +96,7 @@ public:
 
 	JsonAnimationEvent() = default;
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonAnimationEvent(JsonObjPtr data){
 		load(data);
 	}
@@ -176,6 +184,7 @@ public:
 	TArray<JsonAnimationCurve> curves;
 	//TArrau>KspmAmo,atopmCirve? cirves; Well, this is new
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonEditorCurveBinding() = default;
 	JsonEditorCurveBinding(JsonObjPtr data){
 		load(data);
@@ -204,6 +213,7 @@ public:
 	TArray<JsonAnimationMatrixCurve> matrixCurves;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonAnimationClip() = default;
 	JsonAnimationClip(JsonObjPtr data){
 		load(data);
@@ -0,0 +1,25 @@
+#include "JsonImportPrivatePCH.h"
+#include "JsonArena.h"
+
+JsonStringRef JsonStringPool::intern(const FString &str){
+	if (str.IsEmpty())
+		return JsonStringRef();
+	if (auto found = lookup.Find(str))
+		return JsonStringRef(*found);
+	return intern(FString(str));
+}
+
+JsonStringRef JsonStringPool::intern(FString &&str){
+	if (str.IsEmpty())
+		return JsonStringRef();
+	if (auto found = lookup.Find(str))
+		return JsonStringRef(*found);
+	const FString *stored = strings.Add_GetRef(MakeUnique<FString>(MoveTemp(str))).Get();
+	lookup.Add(stored);
+	return JsonStringRef(stored);
+}
+
+void JsonStringPool::Empty(){
+	lookup.Empty();
+	strings.Empty();
+}
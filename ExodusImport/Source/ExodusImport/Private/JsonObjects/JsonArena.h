@@ -0,0 +1,124 @@
+#pragma once
+#include "JsonTypes.h"
+
+/*
+Storage helpers for big object lists (scenes, prefabs).
+
+A scene can have a hundred thousand game objects. Giving each one its own component arrays and strings
+means several heap blocks per object, most of them tiny, and makes every copy of an object a deep copy.
+Instead, objects keep JsonSpan/JsonStringRef handles into storage owned by the scene.
+
+Handles are only valid while the owner is alive. Moving the owner is fine (TArray and TUniquePtr moves keep
+heap blocks where they are), copying is not, which is why owners of an arena are move-only.
+*/
+
+/*
+Read-only string shared through JsonStringPool. Converts to const FString&, and *ref gives TCHAR*,
+same as FString, so it can be used in UE_LOG and Printf.
+*/
+class JsonStringRef{
+protected:
+	const FString *str = &getEmptyString();
+
+	static const FString& getEmptyString(){
+		static const FString emptyString;
+		return emptyString;
+	}
+public:
+	const FString& get() const{
+		return *str;
+	}
+	operator const FString&() const{
+		return *str;
+	}
+	const TCHAR* operator*() const{
+		return **str;
+	}
+	int32 Len() const{
+		return str->Len();
+	}
+	bool IsEmpty() const{
+		return str->IsEmpty();
+	}
+	bool operator==(const JsonStringRef &other) const{
+		return (str == other.str) || str->Equals(*other.str, ESearchCase::CaseSensitive);
+	}
+	bool operator!=(const JsonStringRef &other) const{
+		return !(*this == other);
+	}
+
+	JsonStringRef() = default;
+	explicit JsonStringRef(const FString *str_)
+	:str(str_ ? str_: &getEmptyString()){
+	}
+};
+
+/*
+Each distinct string is stored once. Comparison is case-sensitive, unlike FName and default TMap<FString>,
+as object names that differ only in case are still different names.
+*/
+class JsonStringPool{
+protected:
+	struct KeyFuncs: BaseKeyFuncs<const FString*, FString, false>{
+		static const FString& GetSetKey(const FString *element){
+			return *element;
+		}
+		static bool Matches(const FString &a, const FString &b){
+			return a.Equals(b, ESearchCase::CaseSensitive);
+		}
+		static uint32 GetKeyHash(const FString &key){
+			return FCrc::StrCrc32(*key);
+		}
+	};
+
+	TArray<TUniquePtr<FString>> strings;
+	TSet<const FString*, KeyFuncs> lookup;
+public:
+	JsonStringRef intern(const FString &str);
+	JsonStringRef intern(FString &&str);
+	int32 Num() const{
+		return strings.Num();
+	}
+	void Empty();
+};
+
+/*
+Range of elements in an arena array. Set up with setRange while the arena is still growing,
+and pointed at actual elements by bind once it is complete.
+*/
+template<typename T> class JsonSpan{
+protected:
+	const T* data = nullptr;
+	int32 num = 0;
+	int32 first = 0;
+public:
+	int32 Num() const{
+		return num;
+	}
+	bool IsEmpty() const{
+		return num == 0;
+	}
+	const T& operator[](int32 index) const{
+		check(data && (index >= 0) && (index < num));
+		return data[index];
+	}
+	const T* begin() const{
+		return data;
+	}
+	const T* end() const{
+		return data + num;
+	}
+	TArrayView<const T> getView() const{
+		return TArrayView<const T>(data, num);
+	}
+
+	void setRange(int32 first_, int32 num_){
+		first = first_;
+		num = num_;
+		data = nullptr;
+	}
+	void bind(const TArray<T> &storage){
+		check((first >= 0) && (first + num <= storage.Num()));
+		data = (num > 0) ? storage.GetData() + first: nullptr;
+	}
+};
@@ -2,76 +2,75 @@
 #include "JsonBinaryTerrain.h"
 #include "terrainTools.h"
 
-void JsonBinaryTerrain::clear(){
-	heightMap.clear();
-	alphaMaps.clear();
-	detailMaps.clear();
-}
+static_assert(PLATFORM_LITTLE_ENDIAN, "Binary terrain data is little endian and is read in place");
 
-template<typename T> static void readPtr(T& out, uint8*&ptr){
-	out = *((T*)ptr);
-	ptr += sizeof(T);
-}
-
-template<typename T> void readPtrElements(T* dst, int32 numElements, uint8*&ptr){
-	T* src = (T*)ptr;
-	for(int i = 0; i < numElements; i++)
-		dst[i] = src[i];
-
-	ptr += sizeof(T) * numElements;//overflow?
+void JsonBinaryTerrain::clear(){
+	heightMap = FloatPlane2DView();
+	alphaMaps = FloatPlane3DView();
+	detailMaps = IntPlane3DView();
+	hMapW = hMapH = alphaMapW = alphaMapH = numAlphaMaps = detailMapW = detailMapH = numDetailMaps = 0;
+	file.close();
 }
 
 bool JsonBinaryTerrain::load(const FString &filename){
-	TArray<uint8> fileBuffer;
-	if (!FFileHelper::LoadFileToArray(fileBuffer, *filename)){
+	clear();
+	if (!file.open(filename)){
 		UE_LOG(JsonLog, Error, TEXT("Could not load binary terrain data from \"%s\""), *filename);
 		return false;
 	}
 
-	auto fileSize = fileBuffer.Num();//Aaand nope.  - 2; ///As per documentation, there are two padding bytes at the end.... for some reason?
+	auto fileSize = file.getSize();//Aaand nope.  - 2; ///As per documentation, there are two padding bytes at the end.... for some reason?
 
-	int32 hMapW = 0, hMapH = 0, alphaMapW = 0, alphaMapH = 0, 
-		numAlphaMaps = 0, detailMapW = 0, detailMapH = 0, numDetailMaps = 0;
-
-	const auto headerSize = sizeof(hMapW) * 8;
+	int32 header[8];
+	const int64 headerSize = sizeof(header);
 
 	if (fileSize < headerSize){
 		UE_LOG(JsonLog, Error, TEXT("File \"%s\" is too small to store a header. Min header size is %d"), 
 			*filename, (int32)headerSize);
+		clear();
 		return false;
 	}
 
-	uint8* basePtr = fileBuffer.GetData();
-	auto curPtr = basePtr;
+	const uint8* basePtr = file.getData();
+	FMemory::Memcpy(header, basePtr, headerSize);
+	hMapW = header[0];
+	hMapH = header[1];
+	alphaMapW = header[2];
+	alphaMapH = header[3];
+	numAlphaMaps = header[4];
+	detailMapW = header[5];
+	detailMapH = header[6];
+	numDetailMaps = header[7];
+
+	for(auto cur: header){
+		if (cur < 0){
+			UE_LOG(JsonLog, Error, TEXT("File \"%s\" has negative sizes in its header"), *filename);
+			clear();
+			return false;
+		}
+	}
 
-	readPtr(hMapW, curPtr);
-	readPtr(hMapH, curPtr);
-	readPtr(alphaMapW, curPtr);
-	readPtr(alphaMapH, curPtr);
-	readPtr(numAlphaMaps, curPtr);
-	readPtr(detailMapW, curPtr);
-	readPtr(detailMapH, curPtr);
-	readPtr(numDetailMaps, curPtr);
-
-	const auto dataSize = sizeof(float) * (
-		hMapW * hMapH  + alphaMapW * alphaMapH * numAlphaMaps + detailMapW * detailMapH * numDetailMaps
-	);
+	const int64 numHeightEls = (int64)hMapW * hMapH;
+	const int64 numAlphaEls = (int64)alphaMapW * alphaMapH * numAlphaMaps;
+	const int64 numDetailEls = (int64)detailMapW * detailMapH * numDetailMaps;
+	const int64 dataSize = sizeof(float) * (numHeightEls + numAlphaEls) + sizeof(int32) * numDetailEls;
 
 	const auto totalSize = headerSize + dataSize;
 
-	if (fileSize <  totalSize){
-		UE_LOG(JsonLog, Error, TEXT("File \"%s\" is too small to map data. Expected file size %d"), 
-			*filename, (int32)totalSize);
+	if ((fileSize < totalSize) || (numHeightEls > MAX_int32) || (numAlphaEls > MAX_int32) || (numDetailEls > MAX_int32)){
+		UE_LOG(JsonLog, Error, TEXT("File \"%s\" is too small to map data. Expected file size %lld"), 
+			*filename, (long long)totalSize);
+		clear();
 		return false;
 	}
 
-	heightMap.resize(hMapW, hMapH);
-	alphaMaps.resize(alphaMapW, alphaMapH, numAlphaMaps);
-	detailMaps.resize(detailMapW, detailMapH, numDetailMaps);
-
-	readPtrElements(heightMap.getData(), heightMap.getNumElements(), curPtr);
-	readPtrElements(alphaMaps.getData(), alphaMaps.getNumElements(), curPtr);
-	readPtrElements(detailMaps.getData(), detailMaps.getNumElements(), curPtr);
+	//32 byte header, so everything below stays 4 byte aligned within the mapping.
+	auto curPtr = basePtr + headerSize;
+	heightMap = FloatPlane2DView((const float*)curPtr, hMapW, hMapH);
+	curPtr += sizeof(float) * numHeightEls;
+	alphaMaps = FloatPlane3DView((const float*)curPtr, alphaMapW, alphaMapH, numAlphaMaps);
+	curPtr += sizeof(float) * numAlphaEls;
+	detailMaps = IntPlane3DView((const int32*)curPtr, detailMapW, detailMapH, numDetailMaps);
 
 	return true;
 }
@@ -79,13 +78,14 @@ bool JsonBinaryTerrain::load(const FString &filename){
 void JsonConvertedTerrain::clear(){
 	heightMap.clear();
 	alphaMaps.Empty();
+	detailMaps.Empty();
 }
 
 bool isValidLandscapeSize(int size){
 	return ((size - 1) % JsonTerrainConstants::quadsPerComponent) == 0;
 }
 
-int32 findCloseLandscapeSize(int srcVertSize){
+int32 findCloseLandscapeSize(int srcVertSize, int32 maxComponents = JsonTerrainConstants::maxComponentsPerDimension){
 	if (isValidLandscapeSize(srcVertSize))
 		return srcVertSize;
 
@@ -94,7 +94,7 @@ int32 findCloseLandscapeSize(int srcVertSize){
 	if ((strips % JsonTerrainConstants::quadsPerComponent) != 0)
 		comps ++;
 
-	comps = FMath::Clamp(comps, 1, (int)JsonTerrainConstants::maxComponentsPerDimension);
+	comps = FMath::Clamp(comps, 1, maxComponents);
 	return comps * JsonTerrainConstants::quadsPerComponent + 1;
 }
 
@@ -106,37 +106,31 @@ void convertToUint8(DataPlane2D<uint8> &dstData, const FloatPlane2D &srcData){
 	);
 }
 
-void convertFloat3DSplatToUintPlanes(TArray<DataPlane2D<uint8>> &outResult, const FloatPlane3D& src, int desiredW, int desiredH, const TCHAR* mapType = 0){
-	if (!mapType)
-		mapType = TEXT("");
-
-	outResult.Empty();
-	UE_LOG(JsonLogTerrain, Log, TEXT("Processing %s maps. %d detail maps present"), mapType, src.getNumLayers());
-	for(int layerIndex = 0; layerIndex < src.getNumLayers(); layerIndex++){
-		UE_LOG(JsonLogTerrain, Log, TEXT("Processing %s map %d out of %d."), mapType, layerIndex, src.getNumLayers());
-		auto srcFloats = src.getLayerData(layerIndex);
-		srcFloats.transpose();
-		FloatPlane2D dstFloats(desiredW, desiredH);
-		JsonTerrainTools::scaleSplatMapToHeightMap(dstFloats, srcFloats, true);
-
-		auto& byteMap = outResult.AddDefaulted_GetRef();
-		convertToUint8(byteMap, dstFloats);
-		/*
-		dstFloats.convertTo(byteMap, 
-			[](float arg) ->uint8{
-				return FMath::Clamp(FMath::RoundToInt(arg * (float)0xFF), 0, 0xFF);
-			}
-		);
-		*/
-	}
+uint16 convertHeightToUint16(float arg){
+	float zeroLevel = (float)0x7FFF;
+	float oneLevel = (float)0xFFFF;
+	float diff = oneLevel - zeroLevel;
+	return FMath::Clamp(FMath::RoundToInt(arg * diff + zeroLevel), 0, 0xFFFF);
+	//return FMath::Clamp(FMath::RoundToInt(arg * (float)0xFFFF), 0, 0xFFFF);
 }
 
-void JsonConvertedTerrain::assignFrom(const JsonBinaryTerrain& src){
-	UE_LOG(JsonLogTerrain, Log, TEXT("Transposing height map"));
-	auto floatHMap = src.heightMap.getTransposed();
+/*
+Source planes are stored transposed relative to the landscape, so a window of the landscape-oriented source
+is the mirrored rect of the stored one.
+*/
+static FIntRect transposeRect(const FIntRect &rect){
+	return FIntRect(rect.Min.Y, rect.Min.X, rect.Max.Y, rect.Max.X);
+}
+
+template<typename T> static FIntPoint getTransposedSize(const DataPlane2DView<T> &plane){
+	return FIntPoint(plane.getHeight(), plane.getWidth());
+}
 
-	auto hMapW = floatHMap.getWidth();
-	auto hMapH = floatHMap.getHeight();
+JsonTerrainTileConverter::JsonTerrainTileConverter(const JsonBinaryTerrain &src_, int32 maxComponents, 
+		JsonTerrainTools::ResampleFilter heightMapFilter_)
+:src(src_), heightMapFilter(heightMapFilter_){
+	auto hMapW = src.heightMap.getHeight();//transposed
+	auto hMapH = src.heightMap.getWidth();
 	auto detMapH = src.detailMaps.getHeight();
 	auto detMapW = src.detailMaps.getWidth();
 	auto alphaMapW = src.alphaMaps.getWidth();
@@ -145,75 +139,67 @@ void JsonConvertedTerrain::assignFrom(const JsonBinaryTerrain& src){
 	auto maxW = FMath::Max3(hMapW, detMapW, alphaMapW);
 	auto maxH = FMath::Max3(hMapH, detMapH, alphaMapH);
 
-	auto idealHMapW = findCloseLandscapeSize(maxW);//findCloseLandscapeSize(hMapW * 4);
-	auto idealHMapH = findCloseLandscapeSize(maxH);//findCloseLandscapeSize(hMapH * 4);
-	UE_LOG(JsonLogTerrain, Log, TEXT("Landscape width found: %d x %d"), idealHMapW, idealHMapH);
+	vertSize.X = findCloseLandscapeSize(maxW, maxComponents);
+	vertSize.Y = findCloseLandscapeSize(maxH, maxComponents);
+	UE_LOG(JsonLogTerrain, Log, TEXT("Landscape width found: %d x %d"), vertSize.X, vertSize.Y);
+}
 
-	if ((hMapW != idealHMapW) || (hMapH != idealHMapH)){
-		UE_LOG(JsonLogTerrain, Log, TEXT("Resizing heightmap data"));
-		//auto newHeight = conv
-		FloatPlane2D newHMap(idealHMapW, idealHMapH);
-		JsonTerrainTools::rescaleHeightMap(newHMap, floatHMap, true);
-		floatHMap = newHMap;
+void JsonTerrainTileConverter::convertRegion(JsonConvertedTerrain &out, const FIntRect &region, bool gui) const{
+	const FIntRect dstRect(region.Min, region.Max + FIntPoint(1, 1));
+	check((dstRect.Min.X >= 0) && (dstRect.Min.Y >= 0) && (dstRect.Max.X <= vertSize.X) && (dstRect.Max.Y <= vertSize.Y));
+	FloatPlane2D dstFloats;//reused by the height map and every layer
+
+	//Layers without usable source data come out empty (zero) rather than not at all, so layer indices stay put.
+	auto resampled = [&](bool success){
+		if (!success){
+			dstFloats.resize(dstRect.Width(), dstRect.Height());
+			FMemory::Memzero(dstFloats.getData(), dstFloats.getByteSize());
+		}
+	};
+
+	auto fetchHeights = [&](FloatPlane2D &outWindow, const FIntRect &window){
+		src.heightMap.getTransposedRegion(outWindow, transposeRect(window));
+	};
+	const auto hMapSize = getTransposedSize(src.heightMap);
+	if (hMapSize == vertSize){
+		fetchHeights(dstFloats, dstRect);
 	}
 	else{
-		UE_LOG(JsonLogTerrain, Log, TEXT("Sizes match (how?). Nothing to do."));
+		resampled(JsonTerrainTools::rescaleHeightMapRegion(dstFloats, vertSize, dstRect, hMapSize, fetchHeights, gui, heightMapFilter));
+	}
+	dstFloats.convertTo(out.heightMap, convertHeightToUint16);
+
+	out.alphaMaps.Empty(getNumAlphaMaps());
+	for(int layerIndex = 0; layerIndex < getNumAlphaMaps(); layerIndex++){
+		const auto srcLayer = src.alphaMaps.getLayer(layerIndex);
+		resampled(JsonTerrainTools::scaleSplatMapToHeightMapRegion(dstFloats, vertSize, dstRect, getTransposedSize(srcLayer), 
+			[&](FloatPlane2D &outWindow, const FIntRect &window){
+				srcLayer.getTransposedRegion(outWindow, transposeRect(window));
+			}, gui
+		));
+		convertToUint8(out.alphaMaps.AddDefaulted_GetRef(), dstFloats);
 	}
 
-	UE_LOG(JsonLogTerrain, Log, TEXT("Converting height map"));
-	floatHMap.convertTo(
-		heightMap, 
-		[](float arg) ->uint16{
-			float zeroLevel = (float)0x7FFF;
-			float oneLevel = (float)0xFFFF;
-			float diff = oneLevel - zeroLevel;
-			return FMath::Clamp(FMath::RoundToInt(arg * diff + zeroLevel), 0, 0xFFFF);
-			//return FMath::Clamp(FMath::RoundToInt(arg * (float)0xFFFF), 0, 0xFFFF);
-		}
-	);
-	UE_LOG(JsonLogTerrain, Log, TEXT("Conversion finished. %d x %d"), heightMap.getWidth(), heightMap.getHeight());
-
-	convertFloat3DSplatToUintPlanes(alphaMaps, src.alphaMaps, idealHMapW, idealHMapH, TEXT("alpha"));
-
-	auto& dstDetails = detailMaps;
-	const auto& srcDetails = src.detailMaps;
-	UE_LOG(JsonLogTerrain, Log, TEXT("Processing %d detail maps"), srcDetails.getNumLayers());
-	for(int detailIndex = 0 ; detailIndex < srcDetails.getNumLayers(); detailIndex++){
-		UE_LOG(JsonLogTerrain, Log, TEXT("Processing detail map %d out of %d."), detailIndex, srcDetails.getNumLayers());
-
-		auto srcLayer = srcDetails.getLayerData(detailIndex);
-		srcLayer.transpose();
-
-		FloatPlane2D srcFloats;
-		srcLayer.convertTo(srcFloats, [](int32 arg)->float{
-			return (float)FMath::Clamp(arg, 0, 16)/16.0f; //why? Is this an oversight?
-		});
-
-		FloatPlane2D dstFloats(idealHMapW, idealHMapH);//desiredW, desiredH);
-		JsonTerrainTools::scaleSplatMapToHeightMap(dstFloats, srcFloats, true);
-
-		auto& byteMap = dstDetails.AddDefaulted_GetRef();
-		convertToUint8(byteMap, dstFloats);
-		/*
-		dstFloats.convertTo(byteMap, 
-			[](float arg) ->uint8{
-				return FMath::Clamp(FMath::RoundToInt(arg * (float)0xFF), 0, 0xFF);
-			}
-		);
-		*/
-		//srcLayer.
-
-		/*
-		FloatPlane2D srcFloats(srcLaye
-		FloatPlane2D dstFloats(desiredW, desiredH);
-		JsonTerrainTools::scaleSplatMapToHeightMap(dstFloats, srcFloats, true);
-
-		auto& byteMap = outResult.AddDefaulted_GetRef();
-		dstFloats.convertTo(byteMap, 
-			[](float arg) ->uint8{
-				return FMath::Clamp(FMath::RoundToInt(arg * (float)0xFF), 0, 0xFF);
-			}
-		);
-		*/
+	out.detailMaps.Empty(getNumDetailMaps());
+	DataPlane2D<int32> srcWindow;//reused by all layers
+	for(int detailIndex = 0 ; detailIndex < getNumDetailMaps(); detailIndex++){
+		const auto srcLayer = src.detailMaps.getLayer(detailIndex);
+		resampled(JsonTerrainTools::scaleSplatMapToHeightMapRegion(dstFloats, vertSize, dstRect, getTransposedSize(srcLayer), 
+			[&](FloatPlane2D &outWindow, const FIntRect &window){
+				srcLayer.getTransposedRegion(srcWindow, transposeRect(window));
+				srcWindow.convertTo(outWindow, [](int32 arg)->float{
+					return (float)FMath::Clamp(arg, 0, 16)/16.0f; //why? Is this an oversight?
+				});
+			}, gui
+		));
+		convertToUint8(out.detailMaps.AddDefaulted_GetRef(), dstFloats);
 	}
 }
+
+void JsonConvertedTerrain::assignFrom(const JsonBinaryTerrain& src, int32 maxComponents, JsonTerrainTools::ResampleFilter heightMapFilter){
+	JsonTerrainTileConverter converter(src, maxComponents, heightMapFilter);
+	UE_LOG(JsonLogTerrain, Log, TEXT("Converting terrain: %d alpha maps, %d detail maps"), 
+		converter.getNumAlphaMaps(), converter.getNumDetailMaps());
+	converter.convertRegion(*this, converter.getFullRegion(), true);
+	UE_LOG(JsonLogTerrain, Log, TEXT("Conversion finished. %d x %d"), heightMap.getWidth(), heightMap.getHeight());
+}
@@ -3,32 +3,64 @@
 #include "JsonTypes.h"
 #include "DataPlane2D.h"
 #include "DataPlane3D.h"
+#include "DataPlaneView.h"
+#include "MappedFileData.h"
 #include "terrainTools.h"
 
 //using FloatPlane2D = DataPlane2D<float>;
 using FloatPlane3D = DataPlane3D<float>;
 using IntPlane3D = DataPlane3D<int32>;
+using FloatPlane2DView = DataPlane2DView<float>;
+using FloatPlane3DView = DataPlane3DView<float>;
+using IntPlane3DView = DataPlane3DView<int32>;
 
 class JsonTerrainConstants{
 public:
 	enum{
 		quadsPerComponent = 63,
-		maxComponentsPerDimension = 64
+		maxComponentsPerDimension = 64,
+		//Tiled landscapes are split into streaming proxies, so the single actor limit doesn't apply to them
+		maxTiledComponentsPerDimension = 256
 	};
 };
 
+/*
+Terrain data written by the exporter next to terrain json.
+
+Layout: 8 int32 header fields (in the order below), then float heightmap, float alpha maps and int32 detail maps,
+each stored layer by layer, row by row.
+
+The file is memory-mapped, planes are views into the mapping and stay valid while this object lives.
+*/
 class JsonBinaryTerrain{
 public:
-	FloatPlane2D heightMap;
-	FloatPlane3D alphaMaps;
+	int32 hMapW = 0;
+	int32 hMapH = 0;
+	int32 alphaMapW = 0;
+	int32 alphaMapH = 0;
+	int32 numAlphaMaps = 0;
+	int32 detailMapW = 0;
+	int32 detailMapH = 0;
+	int32 numDetailMaps = 0;
+
+	FloatPlane2DView heightMap;
+	FloatPlane3DView alphaMaps;
 	//FloatPlane3D detailMaps;
-	IntPlane3D detailMaps;
+	IntPlane3DView detailMaps;
 
 	void clear();
 	bool load(const FString &filename);
 	JsonBinaryTerrain() = default;
+	JsonBinaryTerrain(const JsonBinaryTerrain&) = delete;
+	JsonBinaryTerrain& operator=(const JsonBinaryTerrain&) = delete;
+protected:
+	MappedFileData file;
 };
 
+/*
+Final integer data for the landscape. TerrainBuilder moves the planes out with releaseArray(), 
+so they aren't duplicated on the way to ALandscapeProxy::Import.
+*/
 class JsonConvertedTerrain{
 public:
 	DataPlane2D<uint16> heightMap;
@@ -38,6 +70,43 @@ public:
 	TArray<DataPlane2D<uint8>> detailMaps;
 
 	void clear();
-	void assignFrom(const JsonBinaryTerrain& src);
+	//heightMapFilter only affects the height map, splat and detail maps are always resampled linearly, like unity does.
+	void assignFrom(const JsonBinaryTerrain& src, int32 maxComponents = JsonTerrainConstants::maxComponentsPerDimension,
+		JsonTerrainTools::ResampleFilter heightMapFilter = JsonTerrainTools::ResampleFilter::Linear);
 	JsonConvertedTerrain() = default;
+};
+
+/*
+Converts binary terrain into landscape data one region at a time, straight from the mapped source planes.
+
+Only the source window a region reads from is copied out, so memory use follows the region size 
+and not the terrain size. Regions are resampled against the full landscape size, 
+so neighboring regions sharing a border row or column get identical values on it.
+*/
+class JsonTerrainTileConverter{
+public:
+	//Size of the whole landscape, in vertices
+	const FIntPoint& getVertSize() const{
+		return vertSize;
+	}
+	FIntRect getFullRegion() const{
+		return FIntRect(0, 0, vertSize.X - 1, vertSize.Y - 1);
+	}
+	int32 getNumAlphaMaps() const{
+		return src.alphaMaps.getNumLayers();
+	}
+	int32 getNumDetailMaps() const{
+		return src.detailMaps.getNumLayers();
+	}
+
+	//region is in landscape vertices, max inclusive, same as ALandscapeProxy::Import takes it.
+	void convertRegion(JsonConvertedTerrain &out, const FIntRect &region, bool gui = false) const;
+
+	//src has to stay loaded while the converter is in use.
+	JsonTerrainTileConverter(const JsonBinaryTerrain &src_, int32 maxComponents = JsonTerrainConstants::maxComponentsPerDimension,
+		JsonTerrainTools::ResampleFilter heightMapFilter_ = JsonTerrainTools::ResampleFilter::Linear);
+protected:
+	const JsonBinaryTerrain &src;
+	FIntPoint vertSize = FIntPoint::ZeroValue;
+	JsonTerrainTools::ResampleFilter heightMapFilter = JsonTerrainTools::ResampleFilter::Linear;
 };
\ No newline at end of file
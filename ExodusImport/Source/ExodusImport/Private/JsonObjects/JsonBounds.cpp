@@ -1,6 +1,7 @@
 #include "JsonImportPrivatePCH.h"
 #include "JsonBounds.h"
 #include "macros.h"
+#include "JsonStreamReader.h"
 
 void JsonBounds::load(JsonObjPtr jsonData){
 	using namespace JsonObjects;
@@ -12,3 +13,10 @@ JsonBounds::JsonBounds(JsonObjPtr jsonData){
 	load(jsonData);
 }
 
+void JsonBounds::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, center);
+		JSON_STREAM_VAR(reader, field, size);
+		return false;
+	});
+}
@@ -1,11 +1,14 @@
 #pragma once
 #include "JsonTypes.h"
 
+class JsonStreamReader;
+
 class JsonBounds{
 public:
 	FVector center;
 	FVector size;
 	void load(JsonObjPtr jsonData);
+	void load(JsonStreamReader &reader);
 	JsonBounds() = default;
 	JsonBounds(JsonObjPtr jsonData);
 };
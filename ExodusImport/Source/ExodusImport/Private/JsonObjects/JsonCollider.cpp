@@ -21,8 +21,8 @@ void JsonCollider::load(JsonObjPtr data){
 	JSON_GET_VAR(data, enabled);
 	JSON_GET_VAR(data, contactOffset);
 
-	getJsonObj(data, bounds, "bounds");
+	getJsonObj(data, bounds, JSON_KEY("bounds"));
 
-	getJsonValue(trigger, data, "isTrigger");
+	getJsonValue(trigger, data, JSON_KEY("isTrigger"));
 	//JSON_GET_VAR(data, trigger);
 }
@@ -18,7 +18,7 @@ void JsonCubemap::load(JsonObjPtr data){
 	JSON_GET_VAR(data, isHdr);
 	JSON_GET_VAR(data, format);
 
-	getJsonObj(data, texParams, "texParams");
-	getJsonObj(data, texImportParams, "texImportParams");
+	getJsonObj(data, texParams, JSON_KEY("texParams"));
+	getJsonObj(data, texImportParams, JSON_KEY("texImportParams"));
 }
 	
\ No newline at end of file
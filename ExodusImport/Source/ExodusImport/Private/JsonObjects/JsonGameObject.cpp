@@ -12,28 +12,25 @@ Apparently Intellisense is unaware of that.
 I guess it means I should no longer place "using namespace" at beginning of *.cpp files and expect it to be isolated.
 */
 
-JsonGameObject::JsonGameObject(JsonObjPtr jsonData){
-	load(jsonData);
-}
-
-void JsonGameObject::load(JsonObjPtr jsonData){
+void JsonGameObject::load(JsonObjPtr jsonData, JsonGameObjectArena &arena){
 	using namespace JsonObjects;
 	using namespace UnrealUtilities;
 
-	JSON_GET_PARAM(jsonData, name, getString);
+	auto &strings = arena.strings;
+	name = strings.intern(getString(jsonData, JSON_KEY("name")));
 	JSON_GET_PARAM(jsonData, id, getInt);
 
-	JSON_GET_PARAM(jsonData, scenePath, getString);
+	scenePath = strings.intern(getString(jsonData, JSON_KEY("scenePath")));
 
 	JSON_GET_PARAM(jsonData, instanceId, getInt);
 	JSON_GET_PARAM(jsonData, localPosition, getVector);
 	JSON_GET_PARAM(jsonData, localRotation, getQuat);
 	JSON_GET_PARAM(jsonData, localScale, getVector);
 	JSON_GET_PARAM(jsonData, worldMatrix, getMatrix);
-	JSON_GET_PARAM(jsonData, localMatrix, getMatrix);
+	//localMatrix is not read, local transform is available as localPosition/Rotation/Scale
 	JSON_GET_PARAM2(jsonData, parentId, parent, getInt);
 
-	JSON_GET_PARAM2(jsonData, parentName, parentName, getString);
+	parentName = strings.intern(getString(jsonData, JSON_KEY("parentName")));
 
 	JSON_GET_PARAM2(jsonData, meshId, mesh, getResId);
 
@@ -47,30 +44,30 @@ void JsonGameObject::load(JsonObjPtr jsonData){
 	JSON_GET_PARAM(jsonData, occludeeStatic, getBool);
 
 	JSON_GET_PARAM(jsonData, nameClash, getBool);
-	JSON_GET_PARAM(jsonData, uniqueName, getString);
+	uniqueName = strings.intern(getString(jsonData, JSON_KEY("uniqueName")));
 
 	JSON_GET_PARAM(jsonData, prefabRootId, getInt);
 	JSON_GET_PARAM(jsonData, prefabObjectId, getInt);
 	JSON_GET_PARAM(jsonData, prefabInstance, getBool);
 	JSON_GET_PARAM(jsonData, prefabModelInstance, getBool);
-	JSON_GET_PARAM(jsonData, prefabType, getString);
-
-	renderers.Empty();
-	skinRenderers.Empty();
-	lights.Empty();
-	probes.Empty();
+	prefabType = strings.intern(getString(jsonData, JSON_KEY("prefabType")));
 
-	getJsonObjArray(jsonData, lights, "light", true);
-	getJsonObjArray(jsonData, renderers, "renderer", true);
-	getJsonObjArray(jsonData, probes, "reflectionProbes", true);
-	getJsonObjArray(jsonData, terrains, "terrains", true);
-	getJsonObjArray(jsonData, skinRenderers, "skinRenderers", true);
-	getJsonObjArray(jsonData, animators, "animators", true);
+	auto appendComponents = [&](auto &outSpan, auto &storage, const FString &fieldName){
+		auto first = storage.Num();
+		auto num = appendJsonObjArray(jsonData, storage, fieldName, true);
+		outSpan.setRange(first, num);
+	};
+	appendComponents(lights, arena.lights, JSON_KEY("light"));
+	appendComponents(renderers, arena.renderers, JSON_KEY("renderer"));
+	appendComponents(probes, arena.probes, JSON_KEY("reflectionProbes"));
+	appendComponents(terrains, arena.terrains, JSON_KEY("terrains"));
+	appendComponents(skinRenderers, arena.skinRenderers, JSON_KEY("skinRenderers"));
+	appendComponents(animators, arena.animators, JSON_KEY("animators"));
 
-	getJsonObjArray(jsonData, colliders, "colliders", true);
-	getJsonObjArray(jsonData, rigidbodies, "rigidbodies", true);
+	appendComponents(colliders, arena.colliders, JSON_KEY("colliders"));
+	appendComponents(rigidbodies, arena.rigidbodies, JSON_KEY("rigidbodies"));
 
-	getJsonObjArray(jsonData, joints, "joints", true);
+	appendComponents(joints, arena.joints, JSON_KEY("joints"));
 
 	if (nameClash && (uniqueName.Len() > 0)){
 		UE_LOG(JsonLog, Warning, TEXT("Name clash detected on object %d: %s. Renaming to %s"), 
@@ -79,8 +76,70 @@ void JsonGameObject::load(JsonObjPtr jsonData){
 	}
 	else
 		ueName = name;
+}
 
-	ueWorldMatrix = unityWorldToUe(worldMatrix);
+void JsonGameObjectArena::bind(TArray<JsonGameObject> &objects) const{
+	for(auto &cur: objects){
+		cur.lights.bind(lights);
+		cur.probes.bind(probes);
+		cur.renderers.bind(renderers);
+		cur.skinRenderers.bind(skinRenderers);
+		cur.terrains.bind(terrains);
+		cur.animators.bind(animators);
+		cur.colliders.bind(colliders);
+		cur.rigidbodies.bind(rigidbodies);
+		cur.joints.bind(joints);
+	}
+}
+
+void JsonGameObjectArena::Empty(){
+	strings.Empty();
+	lights.Empty();
+	probes.Empty();
+	renderers.Empty();
+	skinRenderers.Empty();
+	terrains.Empty();
+	animators.Empty();
+	colliders.Empty();
+	rigidbodies.Empty();
+	joints.Empty();
+}
+
+void JsonGameObjectIndex::build(const TArray<JsonGameObject> &objects){
+	clear();
+	for(const auto &cur: objects){
+		instanceIds.registerId(cur.instanceId, cur.id);
+		if (cur.hasJoints())
+			jointObjects.Add(cur.id);
+	}
+}
+
+void JsonGameObjectIndex::clear(){
+	instanceIds.clear();
+	jointObjects.Empty();
+}
+
+void JsonObjects::loadGameObjects(TArray<JsonGameObject> &outObjects, JsonGameObjectArena &arena, JsonObjPtr data, const FString &name){
+	outObjects.Reset();
+	arena.Empty();
+
+	const JsonValPtrs *objValues = nullptr;
+	loadArray(data, objValues, name);
+	if (!objValues)
+		return;
+
+	outObjects.Reserve(objValues->Num());
+	for(int i = 0; i < objValues->Num(); i++){
+		auto &dstObj = outObjects.AddDefaulted_GetRef();
+		const auto &jsonObj = (*objValues)[i]->AsObject();
+		if (!jsonObj.IsValid()){
+			UE_LOG(JsonLog, Warning, TEXT("Could not retrieve index %d from \"%s\""), i, *name);
+			continue;
+		}
+		dstObj.load(jsonObj, arena);
+	}
+	arena.bind(outObjects);
+	UE_LOG(JsonLog, Log, TEXT("Loaded %d objects, %d unique strings"), outObjects.Num(), arena.strings.Num());
 }
 
 IntArray JsonGameObject::getFirstMaterials() const{
@@ -103,10 +162,14 @@ FTransform JsonGameObject::getUnrealTransform(const FVector& localUnityOffset) c
 
 FTransform JsonGameObject::getUnrealTransform() const{
 	FTransform result;
-	result.SetFromMatrix(ueWorldMatrix);
+	result.SetFromMatrix(getUeWorldMatrix());
 	return result;
 }
 
+FMatrix JsonGameObject::getUeWorldMatrix() const{
+	return UnrealUtilities::unityWorldToUe(worldMatrix);
+}
+
 FVector JsonGameObject::unityLocalVectorToUnrealWorld(const FVector &arg) const{
 	using namespace UnrealUtilities;
 
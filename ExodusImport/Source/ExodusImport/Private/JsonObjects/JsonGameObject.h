@@ -9,54 +9,91 @@
 #include "JsonCollider.h"
 #include "JsonRigidbody.h"
 #include "JsonPhysics.h"
+#include "JsonArena.h"
+#include "InstanceIdMap.h"
 
+class JsonGameObject;
+
+/*
+Components and strings of all game objects in a scene (or prefab). Objects only hold spans into it.
+*/
+class JsonGameObjectArena{
+public:
+	JsonStringPool strings;
+
+	TArray<JsonLight> lights;
+	TArray<JsonReflectionProbe> probes;
+	TArray<JsonRenderer> renderers;
+	TArray<JsonSkinRenderer> skinRenderers;
+	TArray<JsonTerrain> terrains;
+	TArray<JsonAnimator> animators;
+
+	TArray<JsonCollider> colliders;
+	TArray<JsonRigidbody> rigidbodies;
+
+	TArray<JsonPhysicsJoint> joints;
+
+	//Must be called once all objects are loaded, arrays above move around while they grow.
+	void bind(TArray<JsonGameObject> &objects) const;
+	void Empty();
+
+	JsonGameObjectArena() = default;
+	JsonGameObjectArena(JsonGameObjectArena&&) = default;
+	JsonGameObjectArena& operator=(JsonGameObjectArena&&) = default;
+	JsonGameObjectArena(const JsonGameObjectArena&) = delete;
+	JsonGameObjectArena& operator=(const JsonGameObjectArena&) = delete;
+};
+
+/*
+Compact enough to be passed around by value: component lists are spans into JsonGameObjectArena
+and strings are shared through its pool. Valid only while the arena (scene, prefab) is alive.
+*/
 class JsonGameObject{
 public:
-	FString name;
-	int32 id;
-	int32 instanceId;
+	JsonStringRef name;
+	int32 id = -1;
+	int32 instanceId = -1;
 
-	FString scenePath;
+	JsonStringRef scenePath;
 
-	FVector localPosition;
-	FQuat localRotation;
-	FVector localScale;
+	FVector localPosition = FVector::ZeroVector;
+	FQuat localRotation = FQuat::Identity;
+	FVector localScale = FVector::OneVector;
 	FMatrix worldMatrix = FMatrix::Identity;
-	FMatrix localMatrix = FMatrix::Identity;
-	int32 parentId;
-	FString parentName;
+	int32 parentId = -1;
+	JsonStringRef parentName;
 	//int32 meshId;
 	ResId meshId;
 
 	bool activeSelf = true;
 	bool activeInHierarchy = true;
 
-	bool isStatic;
-	bool lightMapStatic;
-	bool navigationStatic;
-	bool occluderStatic;
-	bool occludeeStatic;
+	bool isStatic = false;
+	bool lightMapStatic = false;
+	bool navigationStatic = false;
+	bool occluderStatic = false;
+	bool occludeeStatic = false;
 
-	bool nameClash;
-	FString uniqueName;
+	bool nameClash = false;
+	JsonStringRef uniqueName;
 
-	int32 prefabRootId;
-	int32 prefabObjectId;
-	bool prefabInstance;
-	bool prefabModelInstance;
-	FString prefabType;
+	int32 prefabRootId = -1;
+	int32 prefabObjectId = -1;
+	bool prefabInstance = false;
+	bool prefabModelInstance = false;
+	JsonStringRef prefabType;
 
-	TArray<JsonLight> lights;
-	TArray<JsonReflectionProbe> probes;
-	TArray<JsonRenderer> renderers;
-	TArray<JsonSkinRenderer> skinRenderers;
-	TArray<JsonTerrain> terrains;
-	TArray<JsonAnimator> animators;
+	JsonSpan<JsonLight> lights;
+	JsonSpan<JsonReflectionProbe> probes;
+	JsonSpan<JsonRenderer> renderers;
+	JsonSpan<JsonSkinRenderer> skinRenderers;
+	JsonSpan<JsonTerrain> terrains;
+	JsonSpan<JsonAnimator> animators;
 
-	TArray<JsonCollider> colliders;
-	TArray<JsonRigidbody> rigidbodies;
+	JsonSpan<JsonCollider> colliders;
+	JsonSpan<JsonRigidbody> rigidbodies;
 
-	TArray<JsonPhysicsJoint> joints;
+	JsonSpan<JsonPhysicsJoint> joints;
 
 	FVector unityLocalVectorToUnrealWorld(const FVector &arg) const;
 	FVector unityLocalPosToUnrealWorld(const FVector &arg) const;
@@ -99,13 +136,37 @@ public:
 
 	FTransform getUnrealTransform(const FVector& localUnityOffset) const;
 	FTransform getUnrealTransform() const;
+	//worldMatrix converted to unreal space. Computed on every call, it is not stored.
+	FMatrix getUeWorldMatrix() const;
 
-	FMatrix ueWorldMatrix = FMatrix::Identity;
-	FString ueName;
+	JsonStringRef ueName;
 
-	void load(JsonObjPtr jsonData);
+	//Components are appended to the arena, spans are bound later by JsonGameObjectArena::bind
+	void load(JsonObjPtr jsonData, JsonGameObjectArena &arena);
 	JsonGameObject() = default;
-	JsonGameObject(JsonObjPtr jsonData);
 };
 
-using JsonGameObjectArray = TArray<JsonGameObject>;
\ No newline at end of file
+using JsonGameObjectArray = TArray<JsonGameObject>;
+
+/*
+Lookups over a loaded object list, built once by its owner (scene, prefab) and shared by everyone 
+who needs to resolve object references, instead of each builder making its own map.
+*/
+class JsonGameObjectIndex{
+public:
+	InstanceIdMap instanceIds;
+	//Objects that have at least one joint, in object order.
+	TArray<JsonId> jointObjects;
+
+	const JsonId* findIdByInstance(InstanceId instId) const{
+		return instanceIds.find(instId);
+	}
+
+	void build(const TArray<JsonGameObject> &objects);
+	void clear();
+};
+
+namespace JsonObjects{
+	//Loads array of game objects from the field "name" of data, and binds them to the arena.
+	void loadGameObjects(TArray<JsonGameObject> &outObjects, JsonGameObjectArena &arena, JsonObjPtr data, const FString &name);
+}
\ No newline at end of file
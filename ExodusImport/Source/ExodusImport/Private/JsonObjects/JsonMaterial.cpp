@@ -134,6 +134,19 @@ bool JsonMaterial::nameMarkedCutout() const{
 	return name.Contains(TEXT("/Transparent/Cutout/"), ESearchCase::CaseSensitive);
 }
 
+IntArray JsonMaterial::getTextureIds() const{
+	IntArray result;
+	const JsonTextureId texIds[] = {
+		mainTexture, albedoTex, specularTex, metallicTex, normalMapTex, occlusionTex,
+		parallaxTex, emissionTex, detailMaskTex, detailAlbedoTex, detailNormalMapTex
+	};
+	for(auto curId: texIds){
+		if (curId >= 0)
+			result.AddUnique(curId);
+	}
+	return result;
+}
+
 FString JsonMaterial::getUnrealMaterialName() const{
 	//Duplicated code. Need to do something about it later.
 	auto pathBaseName = FPaths::GetBaseFilename(path);
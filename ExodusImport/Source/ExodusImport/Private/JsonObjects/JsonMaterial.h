@@ -172,6 +172,7 @@ public:
 	}
 
 	FString getUnrealMaterialName() const;
+	IntArray getTextureIds() const;//all valid texture ids referenced by the material, no duplicates
 
 	bool nameMarkedTransparent() const;
 	bool nameMarkedCutout() const;
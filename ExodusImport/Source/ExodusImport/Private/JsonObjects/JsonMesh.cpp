@@ -3,6 +3,9 @@
 #include "macros.h"
 #include "loggers.h"
 #include "UnrealUtilities.h"
+#include "JsonStreamReader.h"
+#include "JsonMeshBinaryData.h"
+#include "Misc/SecureHash.h"
 
 //#define JSON_ENABLE_VALUE_LOGGING
 
@@ -26,41 +29,46 @@ void JsonMesh::load(JsonObjPtr data){
 	JSON_GET_VAR(data, materials);
 	JSON_GET_VAR(data, readable);
 	JSON_GET_VAR(data, vertexCount);
-	colors = getByteArray(data, "colors", true);
+	if (data->HasField("binaryDataPath")){
+		JSON_GET_VAR(data, binaryDataPath);
+	}
+	bool hasBinaryData = !binaryDataPath.IsEmpty();
+
+	getByteArray(data, JSON_KEY("colors"), colors, true);
 	logValue(TEXT("colors: "), colors);
 	
-	verts = getFloatArray(data, "verts", false);
+	getFloatArray(data, JSON_KEY("verts"), verts, hasBinaryData);
 	logValue(TEXT("verts: "), verts);
-	normals = getFloatArray(data, "normals", true);
+	getFloatArray(data, JSON_KEY("normals"), normals, true);
 	logValue(TEXT("normals: "), normals);
 
-	tangents = getFloatArray(data, "tangents", true);
+	getFloatArray(data, JSON_KEY("tangents"), tangents, true);
 	logValue(TEXT("tangents: "), tangents);
-	uv0 = getFloatArray(data, "uv0", true);
+	getFloatArray(data, JSON_KEY("uv0"), uv0, true);
 	logValue(TEXT("uv0: "), uv0);
-	uv1 = getFloatArray(data, "uv1", true);
+	getFloatArray(data, JSON_KEY("uv1"), uv1, true);
 	logValue(TEXT("uv1: "), uv1);
-	uv2 = getFloatArray(data, "uv2", true);
+	getFloatArray(data, JSON_KEY("uv2"), uv2, true);
 	logValue(TEXT("uv2: "), uv2);
-	uv3 = getFloatArray(data, "uv3", true);
+	getFloatArray(data, JSON_KEY("uv3"), uv3, true);
 	logValue(TEXT("uv3: "), uv3);
-	uv4 = getFloatArray(data, "uv4", true);
+	getFloatArray(data, JSON_KEY("uv4"), uv4, true);
 	logValue(TEXT("uv4: "), uv4);
-	uv5 = getFloatArray(data, "uv5", true);
+	getFloatArray(data, JSON_KEY("uv5"), uv5, true);
 	logValue(TEXT("uv5: "), uv5);
-	uv6 = getFloatArray(data, "uv6", true);
+	getFloatArray(data, JSON_KEY("uv6"), uv6, true);
 	logValue(TEXT("uv6: "), uv6);
-	uv7 = getFloatArray(data, "uv7", true);
+	getFloatArray(data, JSON_KEY("uv7"), uv7, true);
 	logValue(TEXT("uv7: "), uv7);
 
-	boneWeights = getFloatArray(data, "boneWeights", true);
+	getFloatArray(data, JSON_KEY("boneWeights"), boneWeights, true);
 	logValue(TEXT("boneWeights: "), boneWeights);
 
-	boneIndexes = getIntArray(data, "boneIndexes", true);
+	getIntArray(data, JSON_KEY("boneIndexes"), boneIndexes, true);
 	logValue(TEXT("boneIndexes: "), boneIndexes);
 
 	JSON_GET_VAR(data, defaultSkeletonId);
-	defaultBoneNames = getStringArray(data, "defaultBoneNames", true);
+	defaultBoneNames = getStringArray(data, JSON_KEY("defaultBoneNames"), true);
 	logValue(TEXT("defaultBoneNames: "), boneIndexes);
 
 	JSON_GET_VAR_NOLOG(data, defaultMeshNodeName);
@@ -68,14 +76,14 @@ void JsonMesh::load(JsonObjPtr data){
 	JSON_GET_VAR_NOLOG(data, defaultMeshNodeMatrix);
 
 	JSON_GET_VAR(data, blendShapeCount);
-	getJsonObjArray(data, blendShapes, "blendShapes", blendShapeCount == 0);
+	getJsonObjArray(data, blendShapes, JSON_KEY("blendShapes"), blendShapeCount == 0);
 
 	bool needsSkinWeights = (boneWeights.Num() != 0)||(boneIndexes.Num() != 0);
-	bindPoses = getMatrixArray(data, "bindPoses", !needsSkinWeights);
-	inverseBindPoses = getMatrixArray(data, "inverseBindPoses", !needsSkinWeights);
+	bindPoses = getMatrixArray(data, JSON_KEY("bindPoses"), !needsSkinWeights || hasBinaryData);
+	inverseBindPoses = getMatrixArray(data, JSON_KEY("inverseBindPoses"), !needsSkinWeights || hasBinaryData);
 
 	JSON_GET_VAR(data, subMeshCount);
-	getJsonObjArray(data, subMeshes, "subMeshes");
+	getJsonObjArray(data, subMeshes, JSON_KEY("subMeshes"), hasBinaryData);
 }
 
 void JsonBlendShapeFrame::load(JsonObjPtr data){
@@ -95,7 +103,95 @@ void JsonBlendShape::load(JsonObjPtr data){
 	JSON_GET_VAR(data, index);
 	JSON_GET_VAR(data, numFrames);
 
-	getJsonObjArray(data, frames, "frames");
+	getJsonObjArray(data, frames, JSON_KEY("frames"));
+}
+
+void JsonSubMesh::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, triangles);
+		return false;
+	});
+}
+
+void JsonMesh::load(JsonStreamReader &reader){
+	defaultMeshNodeMatrix = FMatrix::Identity;
+
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, id);
+		JSON_STREAM_VAR(reader, field, name);
+		JSON_STREAM_VAR(reader, field, uniqueName);
+
+		JSON_STREAM_VAR(reader, field, convexCollider);
+		JSON_STREAM_VAR(reader, field, triangleCollider);
+
+		JSON_STREAM_VAR(reader, field, path);
+		JSON_STREAM_VAR(reader, field, materials);
+		JSON_STREAM_VAR(reader, field, readable);
+		JSON_STREAM_VAR(reader, field, binaryDataPath);
+		if (field == TEXT("vertexCount")){
+			if (!reader.readValue(vertexCount))
+				return false;
+			//vertexCount is written before the channels. Other channels are optional, so only positions are reserved.
+			if (vertexCount > 0)
+				verts.Reserve(vertexCount * 3);
+			return true;
+		}
+		JSON_STREAM_VAR(reader, field, colors);
+
+		JSON_STREAM_VAR(reader, field, verts);
+		JSON_STREAM_VAR(reader, field, normals);
+		JSON_STREAM_VAR(reader, field, tangents);
+		JSON_STREAM_VAR(reader, field, uv0);
+		JSON_STREAM_VAR(reader, field, uv1);
+		JSON_STREAM_VAR(reader, field, uv2);
+		JSON_STREAM_VAR(reader, field, uv3);
+		JSON_STREAM_VAR(reader, field, uv4);
+		JSON_STREAM_VAR(reader, field, uv5);
+		JSON_STREAM_VAR(reader, field, uv6);
+		JSON_STREAM_VAR(reader, field, uv7);
+
+		JSON_STREAM_VAR(reader, field, boneWeights);
+		JSON_STREAM_VAR(reader, field, boneIndexes);
+
+		JSON_STREAM_VAR(reader, field, defaultSkeletonId);
+		JSON_STREAM_VAR(reader, field, defaultBoneNames);
+		JSON_STREAM_VAR(reader, field, defaultMeshNodeName);
+		JSON_STREAM_VAR(reader, field, defaultMeshNodeMatrix);
+
+		JSON_STREAM_VAR(reader, field, blendShapeCount);
+		JSON_STREAM_VAR(reader, field, blendShapes);
+		JSON_STREAM_VAR(reader, field, bindPoses);
+		JSON_STREAM_VAR(reader, field, inverseBindPoses);
+
+		JSON_STREAM_VAR(reader, field, subMeshCount);
+		JSON_STREAM_VAR(reader, field, subMeshes);
+		return false;
+	});
+
+	if ((verts.Num() == 0) && binaryDataPath.IsEmpty()){
+		UE_LOG(JsonLog, Warning, TEXT("No verts in mesh \"%s\" (%s)"), *name, *reader.getSourceName());
+	}
+}
+
+void JsonBlendShapeFrame::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, index);
+		JSON_STREAM_VAR(reader, field, weight);
+		JSON_STREAM_VAR(reader, field, deltaVerts);
+		JSON_STREAM_VAR(reader, field, deltaTangents);
+		JSON_STREAM_VAR(reader, field, deltaNormals);
+		return false;
+	});
+}
+
+void JsonBlendShape::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, name);
+		JSON_STREAM_VAR(reader, field, index);
+		JSON_STREAM_VAR(reader, field, numFrames);
+		JSON_STREAM_VAR(reader, field, frames);
+		return false;
+	});
 }
 
 FString JsonMesh::makeUnrealMeshName() const{
@@ -113,14 +209,153 @@ FString JsonMesh::makeUnrealMeshName() const{
 	return result;
 }
 
+namespace{
+	//Length goes first, so that data moving between neighbouring channels changes the hash.
+	template<typename T> void hashArray(FMD5 &md5, TArrayView<const T> data){
+		int32 num = data.Num();
+		md5.Update((const uint8*)&num, sizeof(num));
+		if (num > 0)
+			md5.Update((const uint8*)data.GetData(), num * sizeof(T));
+	}
+
+	template<typename T> void hashValue(FMD5 &md5, const T &value){
+		md5.Update((const uint8*)&value, sizeof(value));
+	}
+
+	void hashString(FMD5 &md5, const FString &value){
+		FTCHARToUTF8 utf8(*value);
+		hashValue(md5, utf8.Length());
+		md5.Update((const uint8*)utf8.Get(), utf8.Length());
+	}
+}
+
+FString JsonMesh::makeContentKey() const{
+	FMD5 md5;
+	hashArray(md5, getVerts());
+	hashArray(md5, getNormals());
+	hashArray(md5, getTangents());
+	for(int i = 0; i < 8; i++)
+		hashArray(md5, getUv(i));
+	hashArray(md5, getColors());
+	hashArray(md5, getBoneWeights());
+	hashArray(md5, getBoneIndexes());
+
+	hashValue(md5, subMeshCount);
+	for(int i = 0; i < subMeshCount; i++)
+		hashArray(md5, getTriangles(i));
+	hashArray(md5, IntArrayView(materials));
+
+	hashValue(md5, convexCollider);
+	hashValue(md5, triangleCollider);
+
+	//Skinning. Skeleton id is a resource id, so the same skeleton means the same USkeleton.
+	hashValue(md5, defaultSkeletonId);
+	hashValue(md5, defaultBoneNames.Num());
+	for(const auto &curName: defaultBoneNames)
+		hashString(md5, curName);
+	hashString(md5, defaultMeshNodeName);
+	hashValue(md5, defaultMeshNodeMatrix);
+	hashArray(md5, TArrayView<const FMatrix>(bindPoses));
+	hashArray(md5, TArrayView<const FMatrix>(inverseBindPoses));
+
+	hashValue(md5, blendShapes.Num());
+	for(const auto &curShape: blendShapes){
+		hashString(md5, curShape.name);
+		hashValue(md5, curShape.frames.Num());
+		for(const auto &curFrame: curShape.frames){
+			hashValue(md5, curFrame.weight);
+			hashArray(md5, FloatArrayView(curFrame.deltaVerts));
+			hashArray(md5, FloatArrayView(curFrame.deltaNormals));
+			hashArray(md5, FloatArrayView(curFrame.deltaTangents));
+		}
+	}
+
+	uint8 digest[16];
+	md5.Final(digest);
+	return BytesToHex(digest, sizeof(digest));
+}
+
+bool JsonMesh::loadBinaryData(const FString &filename){
+	auto newData = MakeShared<JsonMeshBinaryData>();
+	if (!newData->open(filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not open binary data for mesh \"%s\"(%d)"), *name, id.toIndex());
+		binaryData.Reset();
+		return false;
+	}
+	binaryData = newData;
+
+	//Triangles are in the sidecar, but the rest of the code walks subMeshes array.
+	if (subMeshes.Num() < subMeshCount)
+		subMeshes.SetNum(subMeshCount);
+	return true;
+}
+
+FloatArrayView JsonMesh::getVerts() const{
+	if (binaryData)
+		return binaryData->getFloats(JsonMeshBinaryData::Verts);
+	return verts;
+}
+
+FloatArrayView JsonMesh::getNormals() const{
+	if (binaryData)
+		return binaryData->getFloats(JsonMeshBinaryData::Normals);
+	return normals;
+}
+
+FloatArrayView JsonMesh::getTangents() const{
+	if (binaryData)
+		return binaryData->getFloats(JsonMeshBinaryData::Tangents);
+	return tangents;
+}
+
+FloatArrayView JsonMesh::getUv(int uvIndex) const{
+	const int maxNumCoords = 8;
+	if ((uvIndex < 0) || (uvIndex >= maxNumCoords))
+		return FloatArrayView();
+	if (binaryData)
+		return binaryData->getFloats(JsonMeshBinaryData::Uv0 + uvIndex);
+
+	const FloatArray* coords[maxNumCoords] = {
+		&uv0, &uv1, &uv2, &uv3, &uv4, &uv5, &uv6, &uv7
+	};
+	return *coords[uvIndex];
+}
+
+ByteArrayView JsonMesh::getColors() const{
+	if (binaryData)
+		return binaryData->getBytes(JsonMeshBinaryData::Colors);
+	return colors;
+}
+
+FloatArrayView JsonMesh::getBoneWeights() const{
+	if (binaryData)
+		return binaryData->getFloats(JsonMeshBinaryData::BoneWeights);
+	return boneWeights;
+}
+
+IntArrayView JsonMesh::getBoneIndexes() const{
+	if (binaryData)
+		return binaryData->getInts(JsonMeshBinaryData::BoneIndexes);
+	return boneIndexes;
+}
+
+IntArrayView JsonMesh::getTriangles(int subMeshIndex) const{
+	if (binaryData)
+		return binaryData->getInts(JsonMeshBinaryData::SubMeshTriangles + subMeshIndex);
+	if (!subMeshes.IsValidIndex(subMeshIndex))
+		return IntArrayView();
+	return subMeshes[subMeshIndex].triangles;
+}
+
 const FVector JsonMesh::getVertex(int index) const{
-	return UnrealUtilities::getIdxVector3(verts, index);
+	return UnrealUtilities::getIdxVector3(getVerts(), index);
 }
 
 const FVector JsonMesh::getNormal(int index) const{
-	if (!normals.Num())
+	auto normalFloats = getNormals();
+	if (!normalFloats.Num())
 		return FVector::ZeroVector;
-	return UnrealUtilities::getIdxVector3(normals, index);
+	return UnrealUtilities::getIdxVector3(normalFloats, index);
 }
 
 FVector JsonBlendShapeFrame::getDeltaVert(int vertIdx) const{
@@ -2,6 +2,9 @@
 
 #include "JsonTypes.h"
 
+class JsonStreamReader;
+class JsonMeshBinaryData;
+
 class JsonBlendShapeFrame{
 public:
 	int index;
@@ -15,6 +18,7 @@ public:
 	FVector getDeltaNormal(int index) const;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonBlendShapeFrame(JsonObjPtr data){
 		load(data);
 	}
@@ -29,6 +33,7 @@ public:
 	TArray<JsonBlendShapeFrame> frames;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonBlendShape(JsonObjPtr data){
 		load(data);
 	}
@@ -40,6 +45,7 @@ public:
 	IntArray triangles;
 	JsonSubMesh() = default;
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonSubMesh(JsonObjPtr data){
 		load(data);
 	}
@@ -72,16 +78,34 @@ public:
 	FloatArray uv6;
 	FloatArray uv7;
 
+	/*
+	When the mesh comes with a binary sidecar, bulk channels live there and arrays above stay empty.
+	Use the accessors below instead of touching arrays directly, they work in both cases.
+	*/
+	FString binaryDataPath;
+	TSharedPtr<JsonMeshBinaryData> binaryData;
+
+	bool loadBinaryData(const FString &filename);
+
+	FloatArrayView getVerts() const;
+	FloatArrayView getNormals() const;
+	FloatArrayView getTangents() const;
+	FloatArrayView getUv(int uvIndex) const;
+	ByteArrayView getColors() const;
+	FloatArrayView getBoneWeights() const;
+	IntArrayView getBoneIndexes() const;
+	IntArrayView getTriangles(int subMeshIndex) const;
+
 	bool hasColors() const{
-		return (colors.Num() > 0);
+		return (getColors().Num() > 0);
 	}
 
 	bool hasNormals() const{
-		return (normals.Num() > 0);
+		return (getNormals().Num() > 0);
 	}
 
 	bool hasTangents() const{
-		return (tangents.Num() > 0);
+		return (getTangents().Num() > 0);
 	}
 
 	const FVector getVertex(int index) const;
@@ -89,11 +113,8 @@ public:
 
 	int getNumTexCoords() const{
 		const int maxNumCoords = 8;
-		const FloatArray* coords[maxNumCoords] = {
-			&uv0, &uv1, &uv2, &uv3, &uv4, &uv5, &uv6, &uv7
-		};
 		for(int i = 0; i < maxNumCoords; i++){
-			if (coords[i]->Num() == 0)
+			if (getUv(i).Num() == 0)
 				return i;
 		}
 		return maxNumCoords;
@@ -105,7 +126,7 @@ public:
 	StringArray defaultBoneNames;
 
 	bool hasBones() const{
-		return boneIndexes.Num() > 0;
+		return getBoneIndexes().Num() > 0;
 	}
 
 	FString defaultMeshNodeName;
@@ -120,9 +141,11 @@ public:
 	TArray<JsonSubMesh> subMeshes;
 
 	FString makeUnrealMeshName() const;
+	//Hash of everything that ends up in the unreal asset, see ResourceDeduplicator. Names, paths and ids are not included.
+	FString makeContentKey() const;
 
 	bool hasBoneWeights() const{
-		return (boneWeights.Num() > 0) || (boneIndexes.Num() > 0);
+		return (getBoneWeights().Num() > 0) || (getBoneIndexes().Num() > 0);
 	}
 
 	bool hasBlendShapes() const{
@@ -131,6 +154,7 @@ public:
 
 	JsonMesh() = default;
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonMesh(JsonObjPtr data){
 		load(data);
 	}
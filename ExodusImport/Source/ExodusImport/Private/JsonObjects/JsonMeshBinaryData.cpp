@@ -0,0 +1,155 @@
+#include "JsonImportPrivatePCH.h"
+#include "JsonMeshBinaryData.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Mesh binary data is little endian and is read in place");
+
+namespace{
+	struct BinaryHeader{
+		uint32 magic;
+		uint32 version;
+		uint32 numChannels;
+		uint32 reserved;
+	};
+
+	struct BinaryChannelEntry{
+		uint32 channelId;
+		uint32 elementType;
+		uint32 numElements;
+		uint32 reserved;
+		uint64 offset;
+	};
+
+	static_assert(sizeof(BinaryHeader) == 16, "Unexpected mesh binary header size");
+	static_assert(sizeof(BinaryChannelEntry) == 24, "Unexpected mesh binary channel entry size");
+}
+
+static int64 getElementSize(JsonMeshBinaryData::ElementType elementType){
+	switch(elementType){
+		case JsonMeshBinaryData::ElementType::Float32:
+			return sizeof(float);
+		case JsonMeshBinaryData::ElementType::Int32:
+			return sizeof(int32);
+		case JsonMeshBinaryData::ElementType::UInt8:
+			return sizeof(uint8);
+		default:
+			return 0;
+	}
+}
+
+JsonMeshBinaryData::JsonMeshBinaryData(){
+}
+
+JsonMeshBinaryData::~JsonMeshBinaryData(){
+	close();
+}
+
+void JsonMeshBinaryData::close(){
+	channels.Empty();
+	data = nullptr;
+	dataSize = 0;
+	file.close();
+}
+
+bool JsonMeshBinaryData::open(const FString &filename_){
+	close();
+	filename = filename_;
+	if (!file.open(filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not load mesh data \"%s\""), *filename);
+		return false;
+	}
+	data = file.getData();
+	dataSize = file.getSize();
+
+	if (!parseHeader()){
+		close();
+		return false;
+	}
+
+	UE_LOG(JsonLog, Log, TEXT("Mesh data \"%s\" opened, %d channels"), *filename, channels.Num());
+	return true;
+}
+
+bool JsonMeshBinaryData::parseHeader(){
+	if (!data || (dataSize < (int64)sizeof(BinaryHeader))){
+		UE_LOG(JsonLog, Warning, TEXT("Mesh data \"%s\" is too small"), *filename);
+		return false;
+	}
+
+	BinaryHeader header;
+	FMemory::Memcpy(&header, data, sizeof(header));
+	if (header.magic != magic){
+		UE_LOG(JsonLog, Warning, TEXT("Mesh data \"%s\" has invalid signature %x"), *filename, header.magic);
+		return false;
+	}
+	if (header.version != version){
+		UE_LOG(JsonLog, Warning, TEXT("Mesh data \"%s\" has unsupported version %d (%d expected)"), *filename, header.version, version);
+		return false;
+	}
+
+	auto tableSize = (int64)header.numChannels * (int64)sizeof(BinaryChannelEntry);
+	if ((int64)sizeof(BinaryHeader) + tableSize > dataSize){
+		UE_LOG(JsonLog, Warning, TEXT("Mesh data \"%s\" is truncated: channel table does not fit"), *filename);
+		return false;
+	}
+
+	const uint8* tablePtr = data + sizeof(BinaryHeader);
+	for(uint32 i = 0; i < header.numChannels; i++){
+		BinaryChannelEntry entry;
+		FMemory::Memcpy(&entry, tablePtr + i * sizeof(BinaryChannelEntry), sizeof(entry));
+
+		auto elementType = (ElementType)entry.elementType;
+		auto elementSize = getElementSize(elementType);
+		if (elementSize == 0){
+			UE_LOG(JsonLog, Warning, TEXT("Unknown element type %d in channel %d of mesh data \"%s\""),
+				entry.elementType, entry.channelId, *filename);
+			return false;
+		}
+		if ((entry.numElements > (uint32)MAX_int32) || ((entry.offset % elementSize) != 0)
+				|| ((int64)entry.offset + (int64)entry.numElements * elementSize > dataSize)){
+			UE_LOG(JsonLog, Warning, TEXT("Channel %d of mesh data \"%s\" is out of bounds or misaligned"),
+				entry.channelId, *filename);
+			return false;
+		}
+		if (channels.Contains(entry.channelId)){
+			UE_LOG(JsonLog, Warning, TEXT("Duplicate channel %d in mesh data \"%s\""), entry.channelId, *filename);
+		}
+
+		auto &dst = channels.Add(entry.channelId);
+		dst.elementType = elementType;
+		dst.numElements = (int32)entry.numElements;
+		dst.offset = entry.offset;
+	}
+	return true;
+}
+
+const uint8* JsonMeshBinaryData::getChannelData(uint32 channelId, ElementType elementType, int32 &outNum) const{
+	outNum = 0;
+	auto found = channels.Find(channelId);
+	if (!found)
+		return nullptr;
+	if (found->elementType != elementType){
+		UE_LOG(JsonLog, Warning, TEXT("Channel %d of mesh data \"%s\" has unexpected element type %d"),
+			channelId, *filename, (uint32)found->elementType);
+		return nullptr;
+	}
+	outNum = found->numElements;
+	return data + found->offset;
+}
+
+FloatArrayView JsonMeshBinaryData::getFloats(uint32 channelId) const{
+	int32 num = 0;
+	auto ptr = getChannelData(channelId, ElementType::Float32, num);
+	return FloatArrayView(reinterpret_cast<const float*>(ptr), num);
+}
+
+IntArrayView JsonMeshBinaryData::getInts(uint32 channelId) const{
+	int32 num = 0;
+	auto ptr = getChannelData(channelId, ElementType::Int32, num);
+	return IntArrayView(reinterpret_cast<const int32*>(ptr), num);
+}
+
+ByteArrayView JsonMeshBinaryData::getBytes(uint32 channelId) const{
+	int32 num = 0;
+	auto ptr = getChannelData(channelId, ElementType::UInt8, num);
+	return ByteArrayView(ptr, num);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "JsonTypes.h"
+#include "MappedFileData.h"
+
+/*
+Binary sidecar with bulk mesh channels. Written by the exporter next to mesh json,
+json itself keeps only metadata and "binaryDataPath" in this case.
+
+Layout, everything is little endian:
+	uint32 magic ("EXMB"), uint32 version, uint32 numChannels, uint32 reserved
+	numChannels entries of {uint32 channelId, uint32 elementType, uint32 numElements, uint32 reserved, uint64 offset}
+	channel data, each channel starts at 16 byte boundary.
+
+The file is memory-mapped and channels are handed out as views into the mapping, so nothing is copied.
+Views stay valid as long as this object lives.
+*/
+class JsonMeshBinaryData{
+public:
+	static const uint32 magic = 0x424D5845;//"EXMB"
+	static const uint32 version = 1;
+
+	enum ChannelId: uint32{
+		Verts = 0,
+		Normals = 1,
+		Tangents = 2,
+		Colors = 3,
+		Uv0 = 4,//up to Uv0 + 7
+		BoneWeights = 12,
+		BoneIndexes = 13,
+		SubMeshTriangles = 0x100//+ subMesh index
+	};
+
+	enum class ElementType: uint32{
+		Float32 = 0,
+		Int32 = 1,
+		UInt8 = 2
+	};
+
+	bool open(const FString &filename_);
+	bool isOpen() const{
+		return data != nullptr;
+	}
+	const FString& getFilename() const{
+		return filename;
+	}
+
+	bool hasChannel(uint32 channelId) const{
+		return channels.Contains(channelId);
+	}
+	FloatArrayView getFloats(uint32 channelId) const;
+	IntArrayView getInts(uint32 channelId) const;
+	ByteArrayView getBytes(uint32 channelId) const;
+
+	JsonMeshBinaryData();
+	~JsonMeshBinaryData();
+	JsonMeshBinaryData(const JsonMeshBinaryData&) = delete;
+	JsonMeshBinaryData& operator=(const JsonMeshBinaryData&) = delete;
+protected:
+	struct ChannelInfo{
+		ElementType elementType = ElementType::Float32;
+		int32 numElements = 0;
+		uint64 offset = 0;
+	};
+
+	FString filename;
+	MappedFileData file;
+	const uint8* data = nullptr;
+	int64 dataSize = 0;
+	TMap<uint32, ChannelInfo> channels;
+
+	bool parseHeader();
+	void close();
+	const uint8* getChannelData(uint32 channelId, ElementType elementType, int32 &outNum) const;
+};
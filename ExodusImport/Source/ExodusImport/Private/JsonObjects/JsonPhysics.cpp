@@ -58,9 +58,9 @@ void JsonHingeJointData::load(JsonObjPtr data){
 	using namespace JsonObjects;
 
 	JSON_GET_VAR(data, angle);
-	getJsonObj(data, limits, "limits");
-	getJsonObj(data, motor, "motor");
-	getJsonObj(data, spring, "spring");
+	getJsonObj(data, limits, JSON_KEY("limits"));
+	getJsonObj(data, motor, JSON_KEY("motor"));
+	getJsonObj(data, spring, JSON_KEY("spring"));
 	JSON_GET_VAR(data, useLimits);
 	JSON_GET_VAR(data, useMotor);
 	JSON_GET_VAR(data, useSpring);
@@ -160,10 +160,10 @@ void JsonPhysicsJoint::load(JsonObjPtr data){
 	JSON_GET_VAR(data, enableCollision);
 	JSON_GET_VAR(data, autoConfigureConnectedAnchor);
 
-	getJsonObjArray(data, springJointData, "springJointData", true);
-	getJsonObjArray(data, hingeJointData, "hingeJointData", true);
-	getJsonObjArray(data, configurableJointData, "configurableJointData", true);
-	getJsonObjArray(data, characterJointData, "characterJointData", true);
+	getJsonObjArray(data, springJointData, JSON_KEY("springJointData"), true);
+	getJsonObjArray(data, hingeJointData, JSON_KEY("hingeJointData"), true);
+	getJsonObjArray(data, configurableJointData, JSON_KEY("configurableJointData"), true);
+	getJsonObjArray(data, characterJointData, JSON_KEY("characterJointData"), true);
 }
 
 bool JsonPhysicsJoint::isConnectedToWorld() const{
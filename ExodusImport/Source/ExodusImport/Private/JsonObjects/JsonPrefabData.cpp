@@ -10,9 +10,8 @@ void JsonPrefabData::load(JsonObjPtr jsonData){
 	JSON_GET_PARAM(jsonData, guid, getString);
 	JSON_GET_PARAM(jsonData, prefabType, getString);
 
-	objects.Empty();
-	getJsonObjArray(jsonData, objects, "objects");
-	//objects
+	loadGameObjects(objects, objectArena, jsonData, JSON_KEY("objects"));
+	objectIndex.build(objects);
 }
 
 JsonPrefabData::JsonPrefabData(JsonObjPtr jsonData){
@@ -10,6 +10,8 @@ public:
 	FString prefabType;
 
 	TArray<JsonGameObject> objects;
+	JsonGameObjectArena objectArena;
+	JsonGameObjectIndex objectIndex;
 
 	bool hasObjects() const{
 		return objects.Num() > 0;
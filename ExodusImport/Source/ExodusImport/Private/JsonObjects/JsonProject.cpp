@@ -4,6 +4,6 @@
 
 void JsonProject::load(JsonObjPtr data){
 	using namespace JsonObjects;
-	getJsonObj(data, config, "config");
-	getJsonObj(data, externResources, "externResources");
+	getJsonObj(data, config, JSON_KEY("config"));
+	getJsonObj(data, externResources, JSON_KEY("externResources"));
 }
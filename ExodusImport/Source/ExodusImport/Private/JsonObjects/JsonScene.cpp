@@ -10,27 +10,9 @@ void JsonScene::load(JsonObjPtr data){
 	JSON_GET_VAR(data, path);
 	JSON_GET_VAR(data, buildIndex);
 
-	getJsonObjArray(data, objects, "objects");
+	loadGameObjects(objects, objectArena, data, JSON_KEY("objects"));
 
-	buildInstanceIdMap();
-}
-
-void JsonScene::buildInstanceIdMap(){
-	gameObjectInstanceIdMap.Empty();
-	for (const auto& obj : objects){
-		auto instId = obj.instanceId;
-		auto objId = obj.id;
-
-		auto foundId = gameObjectInstanceIdMap.Find(instId);
-		if (foundId){
-			UE_LOG(JsonLog, Warning,
-				TEXT("Duplicate instance id found. New id objectId: %d; existing objectId: %d; instanceId: %d"),
-				objId, *foundId, instId
-			);
-			gameObjectInstanceIdMap.Remove(instId);
-		}
-		gameObjectInstanceIdMap.Add(instId, objId);
-	}
+	objectIndex.build(objects);
 }
 
 bool JsonScene::containsTerrain() const{
@@ -49,7 +31,7 @@ const JsonGameObject* JsonScene::findJsonObject(JsonId id) const{
 }
 
 const JsonGameObject* JsonScene::findJsonObjectByInstId(InstanceId instId) const{
-	auto foundId = gameObjectInstanceIdMap.Find(instId);
+	auto foundId = objectIndex.findIdByInstance(instId);
 	if (foundId){
 		return findJsonObject(*foundId);
 	}
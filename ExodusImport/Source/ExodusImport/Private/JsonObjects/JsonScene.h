@@ -8,8 +8,10 @@ public:
 	int buildIndex = -1;
 	using InstanceId = int;
 	TArray<JsonGameObject> objects;
+	//Components and strings of objects. Makes the scene move-only.
+	JsonGameObjectArena objectArena;
 
-	TMap<InstanceId, JsonId> gameObjectInstanceIdMap;
+	JsonGameObjectIndex objectIndex;
 
 	bool containsTerrain() const;
 
@@ -21,6 +23,4 @@ public:
 	JsonScene(JsonObjPtr data){
 		load(data);
 	}
-protected:
-	void buildInstanceIdMap();
 };
@@ -1,6 +1,8 @@
 #include "JsonImportPrivatePCH.h"
 #include "JsonSkeleton.h"
 #include "macros.h"
+#include "JsonStreamReader.h"
+#include "Misc/SecureHash.h"
 
 using namespace JsonObjects;
 
@@ -9,7 +11,16 @@ void JsonSkeleton::load(JsonObjPtr data){
 	JSON_GET_VAR(data, name);
 	//JSON_GET_VAR(data, defaultBoneNames);
 
-	getJsonObjArray(data, bones, "bones");
+	getJsonObjArray(data, bones, JSON_KEY("bones"));
+}
+
+void JsonSkeleton::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, id);
+		JSON_STREAM_VAR(reader, field, name);
+		JSON_STREAM_VAR(reader, field, bones);
+		return false;
+	});
 }
 
 int JsonSkeleton::findBoneIndex(const FString &boneName) const{
@@ -19,3 +30,26 @@ int JsonSkeleton::findBoneIndex(const FString &boneName) const{
 	}
 	return -1;
 }
+
+FString JsonSkeleton::makeHierarchyKey() const{
+	TMap<int, FString> boneNames;
+	for(const auto &curBone: bones)
+		boneNames.Add(curBone.id, curBone.name);
+
+	StringArray links;
+	links.Reserve(bones.Num());
+	for(const auto &curBone: bones){
+		auto parentName = boneNames.Find(curBone.parentId);
+		links.Add(curBone.name + TEXT("/") + (parentName ? *parentName: FString()));
+	}
+	links.Sort();
+
+	FMD5 md5;
+	for(const auto &curLink: links){
+		FTCHARToUTF8 utf8(*curLink);
+		md5.Update((const uint8*)utf8.Get(), utf8.Length() + 1);//includes terminator, as a separator
+	}
+	uint8 digest[16];
+	md5.Final(digest);
+	return BytesToHex(digest, sizeof(digest));
+}
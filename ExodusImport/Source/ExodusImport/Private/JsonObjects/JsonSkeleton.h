@@ -10,8 +10,11 @@ public:
 
 	TArray<JsonSkeletonBone> bones;
 	int findBoneIndex(const FString &name) const;
+	//Bone names with their parent names, in any order. Skeletons with the same key can play the same clips.
+	FString makeHierarchyKey() const;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonSkeleton() = default;
 	JsonSkeleton(JsonObjPtr data){
 		load(data);
@@ -2,6 +2,7 @@
 #include "JsonSkeletonBone.h"
 #include "JsonScene.h"
 #include "macros.h"
+#include "JsonStreamReader.h"
 
 void JsonSkeletonBone::load(JsonObjPtr data){
 	using namespace JsonObjects;
@@ -13,3 +14,15 @@ void JsonSkeletonBone::load(JsonObjPtr data){
 	JSON_GET_VAR(data, local);
 	JSON_GET_VAR(data, rootRelative);
 }
+
+void JsonSkeletonBone::load(JsonStreamReader &reader){
+	reader.readObject([&](const FString &field){
+		JSON_STREAM_VAR(reader, field, name);
+		JSON_STREAM_VAR(reader, field, id);
+		JSON_STREAM_VAR(reader, field, parentId);
+		JSON_STREAM_VAR(reader, field, world);
+		JSON_STREAM_VAR(reader, field, local);
+		JSON_STREAM_VAR(reader, field, rootRelative);
+		return false;
+	});
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "JsonObjects.h"
 
+class JsonStreamReader;
+
 class JsonSkeletonBone{
 public:
 	FString name;
@@ -11,6 +13,7 @@ public:
 	FMatrix rootRelative = FMatrix::Identity;
 
 	void load(JsonObjPtr data);
+	void load(JsonStreamReader &reader);
 	JsonSkeletonBone(JsonObjPtr data){
 		load(data);
 	}
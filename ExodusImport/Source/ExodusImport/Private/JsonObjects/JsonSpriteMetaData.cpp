@@ -11,6 +11,6 @@ void JsonSpriteMetaData::load(JsonObjPtr jsonData){
 	JSON_GET_VAR(jsonData, pivot);
 	JSON_GET_VAR(jsonData, border);
 	JSON_GET_VAR(jsonData, alignment);
-	getJsonObj(jsonData, rect, "rect");
+	getJsonObj(jsonData, rect, JSON_KEY("rect"));
 }
 
@@ -0,0 +1,214 @@
+#include "JsonImportPrivatePCH.h"
+#include "JsonStreamReader.h"
+#include "getters.h"
+
+bool JsonObjects::loadJsonTextFromFile(FString &outText, const FString &filename){
+	EXODUS_IMPORT_SCOPE(FileRead);
+	if (!FFileHelper::LoadFileToString(outText, *filename)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not load json file \"%s\""), *filename);
+		return false;
+	}
+	//Exported json is plain ascii, so characters are close enough to bytes.
+	ImportProfiler::addBytesRead(outText.Len());
+
+	UE_LOG(JsonLog, Log, TEXT("Loaded json file \"%s\""), *filename);
+	return true;
+}
+
+JsonStreamReader::JsonStreamReader(const FString &jsonText, const FString &sourceName_)
+:reader(TJsonReaderFactory<>::Create(jsonText)), sourceName(sourceName_){
+}
+
+void JsonStreamReader::reportUnexpected(const TCHAR* expected) const{
+	UE_LOG(JsonLog, Warning, TEXT("Unexpected json value for \"%s\" in \"%s\", %s expected. Value skipped"),
+		*reader->GetIdentifier(), *sourceName, expected);
+}
+
+bool JsonStreamReader::readNext(){
+	if (failed)
+		return false;
+	if (!reader->ReadNext(notation) || (notation == EJsonNotation::Error)){
+		failed = true;
+		UE_LOG(JsonLog, Warning, TEXT("Json stream error in \"%s\": %s"), *sourceName, *reader->GetErrorMessage());
+		return false;
+	}
+	return true;
+}
+
+void JsonStreamReader::skipValue(){
+	if ((notation != EJsonNotation::ObjectStart) && (notation != EJsonNotation::ArrayStart))
+		return;
+
+	int depth = 1;
+	while((depth > 0) && readNext()){
+		if ((notation == EJsonNotation::ObjectStart) || (notation == EJsonNotation::ArrayStart))
+			depth++;
+		else if ((notation == EJsonNotation::ObjectEnd) || (notation == EJsonNotation::ArrayEnd))
+			depth--;
+	}
+}
+
+bool JsonStreamReader::beginArray(){
+	if (notation == EJsonNotation::ArrayStart)
+		return true;
+	if (notation != EJsonNotation::Null)
+		reportUnexpected(TEXT("array"));
+	skipValue();
+	return false;
+}
+
+bool JsonStreamReader::readValue(int32 &outValue){
+	if (notation == EJsonNotation::Number){
+		outValue = (int32)FMath::RoundToDouble(reader->GetValueAsNumber());
+		return true;
+	}
+	reportUnexpected(TEXT("number"));
+	skipValue();
+	return false;
+}
+
+bool JsonStreamReader::readValue(uint8 &outValue){
+	int32 val = 0;
+	if (!readValue(val))
+		return false;
+	outValue = (uint8)FMath::Clamp(val, 0, 255);
+	return true;
+}
+
+bool JsonStreamReader::readValue(float &outValue){
+	if (notation == EJsonNotation::Number){
+		outValue = (float)reader->GetValueAsNumber();
+		return true;
+	}
+	//nans and infinities come as strings.
+	if (notation == EJsonNotation::String){
+		outValue = JsonObjects::parseFloatString(reader->GetValueAsString());
+		return true;
+	}
+	reportUnexpected(TEXT("number"));
+	skipValue();
+	return false;
+}
+
+bool JsonStreamReader::readValue(bool &outValue){
+	if (notation == EJsonNotation::Boolean){
+		outValue = reader->GetValueAsBoolean();
+		return true;
+	}
+	reportUnexpected(TEXT("boolean"));
+	skipValue();
+	return false;
+}
+
+bool JsonStreamReader::readValue(FString &outValue){
+	if (notation == EJsonNotation::String){
+		outValue = reader->GetValueAsString();
+		return true;
+	}
+	if (notation == EJsonNotation::Null){
+		outValue.Empty();
+		return true;
+	}
+	reportUnexpected(TEXT("string"));
+	skipValue();
+	return false;
+}
+
+bool JsonStreamReader::readValue(ResId &outValue){
+	int32 val = -1;
+	if (!readValue(val))
+		return false;
+	outValue = ResId::fromIndex(val);
+	return true;
+}
+
+bool JsonStreamReader::readValue(FVector &outValue){
+	return readObject([&](const FString &fieldName){
+		if (fieldName == TEXT("x"))
+			return readValue(outValue.X);
+		if (fieldName == TEXT("y"))
+			return readValue(outValue.Y);
+		if (fieldName == TEXT("z"))
+			return readValue(outValue.Z);
+		return false;
+	});
+}
+
+bool JsonStreamReader::readValue(FMatrix &outValue){
+	/*
+	Same layout as JsonObjects::toMatrix: M[row][col] comes from "e<col><row>"
+	*/
+	return readObject([&](const FString &fieldName){
+		if ((fieldName.Len() != 3) || (FChar::ToLower(fieldName[0]) != TEXT('e')))
+			return false;
+		int col = fieldName[1] - TEXT('0');
+		int row = fieldName[2] - TEXT('0');
+		if ((col < 0) || (col > 3) || (row < 0) || (row > 3))
+			return false;
+		return readValue(outValue.M[row][col]);
+	});
+}
+
+bool JsonStreamReader::readValue(IntArray &outValue){
+	outValue.Reset();
+	if (!beginArray())
+		return false;
+	//Triangle indices and bone indexes, second hottest path after floats.
+	while(readNext()){
+		if (notation == EJsonNotation::ArrayEnd)
+			return true;
+		if (notation == EJsonNotation::Number)
+			outValue.Add((int32)FMath::RoundToDouble(reader->GetValueAsNumber()));
+		else
+			readValue(outValue.AddDefaulted_GetRef());
+	}
+	return false;
+}
+
+bool JsonStreamReader::readValue(ByteArray &outValue){
+	outValue.Reset();
+	if (!beginArray())
+		return false;
+	while(readNext()){
+		if (notation == EJsonNotation::ArrayEnd)
+			return true;
+		if (notation == EJsonNotation::Number)
+			outValue.Add((uint8)FMath::Clamp((int32)FMath::RoundToDouble(reader->GetValueAsNumber()), 0, 255));
+		else
+			readValue(outValue.AddDefaulted_GetRef());
+	}
+	return false;
+}
+
+bool JsonStreamReader::readValue(FloatArray &outValue){
+	outValue.Reset();
+	if (!beginArray())
+		return false;
+	//The hot path. Most of the mesh data goes through here.
+	while(readNext()){
+		if (notation == EJsonNotation::ArrayEnd)
+			return true;
+		if (notation == EJsonNotation::Number)
+			outValue.Add((float)reader->GetValueAsNumber());
+		else
+			readValue(outValue.AddDefaulted_GetRef());
+	}
+	return false;
+}
+
+bool JsonStreamReader::readValue(StringArray &outValue){
+	return readValue<FString>(outValue);
+}
+
+bool JsonStreamReader::readValue(MatrixArray &outValue){
+	outValue.Reset();
+	if (!beginArray())
+		return false;
+	while(readNext()){
+		if (notation == EJsonNotation::ArrayEnd)
+			return true;
+		auto &dst = outValue.Add_GetRef(FMatrix::Identity);
+		readValue(dst);
+	}
+	return false;
+}
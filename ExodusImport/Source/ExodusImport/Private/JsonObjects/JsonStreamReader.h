@@ -0,0 +1,137 @@
+#pragma once
+#include "JsonTypes.h"
+#include "Serialization/JsonReader.h"
+#include "ImportProfiler.h"
+
+/*
+Token-level reader for big extern resources (meshes, skeletons, animation clips).
+
+Going through FJsonObject turns every single number into heap-allocated FJsonValue,
+and then toFloatArray copies all of that once more. A mesh with a few hundred thousand verts
+ends up eating gigabytes that way.
+
+This one walks the token stream and writes values straight into the fields of the target object,
+no DOM is built. Field names are compared case-insensitively, same as FJsonObject lookups.
+
+Convention: when a value is "read", the reader is left on the last token of that value
+(the scalar itself, ObjectEnd or ArrayEnd).
+*/
+class JsonStreamReader{
+protected:
+	TSharedRef<TJsonReader<>> reader;
+	EJsonNotation notation = EJsonNotation::Null;
+	bool failed = false;
+	FString sourceName;
+
+	void reportUnexpected(const TCHAR* expected) const;
+	bool beginArray();
+public:
+	JsonStreamReader(const FString &jsonText, const FString &sourceName_);
+	JsonStreamReader(const JsonStreamReader&) = delete;
+	JsonStreamReader& operator=(const JsonStreamReader&) = delete;
+
+	bool readNext();
+	void skipValue();
+
+	bool hasFailed() const{
+		return failed;
+	}
+	EJsonNotation getNotation() const{
+		return notation;
+	}
+	const FString& getIdentifier() const{
+		return reader->GetIdentifier();
+	}
+	const FString& getSourceName() const{
+		return sourceName;
+	}
+
+	/*
+	Calls fieldCallback(fieldName) for every member of the current object.
+	The callback should read the value and return true, or return false to have the value skipped.
+	*/
+	template<typename Callback> bool readObject(Callback fieldCallback){
+		if (notation != EJsonNotation::ObjectStart){
+			if (notation != EJsonNotation::Null)
+				reportUnexpected(TEXT("object"));
+			skipValue();
+			return false;
+		}
+		while(readNext()){
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+			if (!fieldCallback(getIdentifier()))
+				skipValue();
+		}
+		return false;
+	}
+
+	bool readValue(int32 &outValue);
+	bool readValue(uint8 &outValue);
+	bool readValue(float &outValue);
+	bool readValue(bool &outValue);
+	bool readValue(FString &outValue);
+	bool readValue(ResId &outValue);
+	bool readValue(FVector &outValue);
+	bool readValue(FMatrix &outValue);
+
+	bool readValue(IntArray &outValue);
+	bool readValue(ByteArray &outValue);
+	bool readValue(FloatArray &outValue);
+	bool readValue(StringArray &outValue);
+	bool readValue(MatrixArray &outValue);
+
+	//Anything with load(JsonStreamReader&)
+	template<typename T> bool readValue(T &outObj){
+		if (notation != EJsonNotation::ObjectStart){
+			if (notation != EJsonNotation::Null)
+				reportUnexpected(TEXT("object"));
+			skipValue();
+			return false;
+		}
+		outObj.load(*this);
+		return !failed;
+	}
+
+	/*
+	Existing capacity is kept, so the caller can reserve the destination beforehand.
+	*/
+	template<typename T> bool readValue(TArray<T> &outValue){
+		outValue.Reset();
+		if (!beginArray())
+			return false;
+		while(readNext()){
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+			readValue(outValue.AddDefaulted_GetRef());
+		}
+		return false;
+	}
+};
+
+namespace JsonObjects{
+	bool loadJsonTextFromFile(FString &outText, const FString &filename);
+
+	/*
+	Reads root object of the file straight into outObj. outObj must have load(JsonStreamReader&).
+	*/
+	template<typename T> bool loadJsonStreamFromFile(T &outObj, const FString &filename){
+		FString jsonText;
+		if (!loadJsonTextFromFile(jsonText, filename))
+			return false;
+
+		EXODUS_IMPORT_SCOPE(JsonParse);
+		JsonStreamReader reader(jsonText, filename);
+		if (!reader.readNext() || (reader.getNotation() != EJsonNotation::ObjectStart)){
+			UE_LOG(JsonLog, Warning, TEXT("Could not parse json file \"%s\": root object not found"), *filename);
+			return false;
+		}
+
+		outObj.load(reader);
+		if (reader.hasFailed()){
+			UE_LOG(JsonLog, Warning, TEXT("Could not parse json file \"%s\""), *filename);
+			return false;
+		}
+		return true;
+	}
+}
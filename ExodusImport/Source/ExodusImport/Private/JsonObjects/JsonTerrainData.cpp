@@ -24,7 +24,7 @@ void JsonTerrainData::load(JsonObjPtr data){
 	JSON_GET_VAR(data, baseMapResolution);
 	//JSON_GET_VAR(data, bounds;
 	//writer.writeKeyVal("bounds", bounds);
-	getJsonObj(data, bounds, "bounds");
+	getJsonObj(data, bounds, JSON_KEY("bounds"));
 
 	JSON_GET_VAR(data, detailWidth);
 	JSON_GET_VAR(data, detailHeight);
@@ -35,7 +35,7 @@ void JsonTerrainData::load(JsonObjPtr data){
 
 
 	//TArray<JsonTerrainDextailPrototype> detailPrototypes;//terrainDetails --> detailPrototypes
-	getJsonObjArray(data, detailPrototypes, "detailPrototypes");
+	getJsonObjArray(data, detailPrototypes, JSON_KEY("detailPrototypes"));
 	JSON_GET_VAR(data, detailResolution);
 
 	JSON_GET_VAR(data, heightmapWidth);
@@ -49,11 +49,11 @@ void JsonTerrainData::load(JsonObjPtr data){
 	JSON_GET_VAR(data, treeInstanceCount);
 
 	//splatPrototypes --> splat prototypes
-	getJsonObjArray(data, splatPrototypes, "splatPrototypes");
+	getJsonObjArray(data, splatPrototypes, JSON_KEY("splatPrototypes"));
 	//treeInstances --> tree instances
-	getJsonObjArray(data, treeInstances , "treeInstances");
+	getJsonObjArray(data, treeInstances , JSON_KEY("treeInstances"));
 	//treePrototypes --> treePrototypes);
-	getJsonObjArray(data, treePrototypes, "treePrototypes");
+	getJsonObjArray(data, treePrototypes, JSON_KEY("treePrototypes"));
 
 	JSON_GET_VAR(data, wavingGrassAmount);
 	JSON_GET_VAR(data, wavingGrassSpeed);
@@ -24,8 +24,8 @@ void JsonTexture::load(JsonObjPtr data){
 	JSON_GET_VAR(data, textureType);
 	JSON_GET_VAR(data, normalMapFlag);
 
-	getJsonObj(data, textureParams, "texParams");
+	getJsonObj(data, textureParams, JSON_KEY("texParams"));
 	//JsonTextureParams textureParams;
 	//JsonTextureImportParams textureImportParams;
-	getJsonObj(data, textureImportParams, "texImportParams");
+	getJsonObj(data, textureImportParams, JSON_KEY("texImportParams"));
 }
@@ -27,6 +27,13 @@ public:
 	JsonTextureParams textureParams;
 	JsonTextureImportParams textureImportParams;
 
+	//Explicit importer flag when there is one, name-based guess otherwise.
+	bool isNormalMap() const{
+		if (importDataFound && normalMapFlag)
+			return true;
+		return name.EndsWith(FString("_n")) || name.EndsWith(FString("Normals"));
+	}
+
 	void load(JsonObjPtr data);
 	JsonTexture() = default;
 	JsonTexture(JsonObjPtr data){
@@ -30,7 +30,7 @@ void JsonTextureImportParams::load(JsonObjPtr data){
 	JSON_GET_VAR(data, spritePivot);
 	JSON_GET_VAR(data, spritePixelsPerUnit);
 
-	getJsonObjArray(data, spritesheet, "spritesheet");
+	getJsonObjArray(data, spritesheet, JSON_KEY("spritesheet"));
 	//TArray<JsonSpriteMetaData> spritesheet;
 
 	JSON_GET_VAR(data, sRGBTexture);
@@ -0,0 +1,51 @@
+#include "JsonImportPrivatePCH.h"
+#include "MappedFileData.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "ImportProfiler.h"
+
+MappedFileData::MappedFileData(){
+}
+
+MappedFileData::~MappedFileData(){
+	close();
+}
+
+void MappedFileData::close(){
+	data = nullptr;
+	dataSize = 0;
+	//region has to go before the file.
+	mappedRegion.Reset();
+	mappedFile.Reset();
+	fallbackData.Empty();
+}
+
+bool MappedFileData::open(const FString &filename_){
+	close();
+	filename = filename_;
+	EXODUS_IMPORT_SCOPE(FileRead);
+
+	auto &platformFile = FPlatformFileManager::Get().GetPlatformFile();
+	mappedFile.Reset(platformFile.OpenMapped(*filename));
+	if (mappedFile && (mappedFile->GetFileSize() > 0)){
+		mappedRegion.Reset(mappedFile->MapRegion(0, mappedFile->GetFileSize()));
+	}
+
+	if (mappedRegion){
+		data = mappedRegion->GetMappedPtr();
+		dataSize = mappedRegion->GetMappedSize();
+	}
+	else{
+		mappedFile.Reset();
+		UE_LOG(JsonLog, Log, TEXT("Could not map \"%s\", reading it into memory instead"), *filename);
+		if (!FFileHelper::LoadFileToArray(fallbackData, *filename)){
+			UE_LOG(JsonLog, Warning, TEXT("Could not load \"%s\""), *filename);
+			return false;
+		}
+		data = fallbackData.GetData();
+		dataSize = fallbackData.Num();
+	}
+
+	ImportProfiler::addBytesRead(dataSize);
+	return data != nullptr;
+}
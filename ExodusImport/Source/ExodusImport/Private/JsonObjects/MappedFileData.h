@@ -0,0 +1,44 @@
+#pragma once
+#include "JsonTypes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/*
+Read-only file contents, memory-mapped when the platform allows it and loaded into memory otherwise.
+
+Pointers and views into the data stay valid as long as this object lives and isn't reopened.
+*/
+class MappedFileData{
+public:
+	bool open(const FString &filename_);
+	void close();
+
+	bool isOpen() const{
+		return data != nullptr;
+	}
+	bool isMapped() const{
+		return mappedRegion.IsValid();
+	}
+	const FString& getFilename() const{
+		return filename;
+	}
+	const uint8* getData() const{
+		return data;
+	}
+	int64 getSize() const{
+		return dataSize;
+	}
+
+	MappedFileData();
+	~MappedFileData();
+	MappedFileData(const MappedFileData&) = delete;
+	MappedFileData& operator=(const MappedFileData&) = delete;
+protected:
+	FString filename;
+	TUniquePtr<IMappedFileHandle> mappedFile;
+	TUniquePtr<IMappedFileRegion> mappedRegion;
+	TArray<uint8> fallbackData;
+	const uint8* data = nullptr;
+	int64 dataSize = 0;
+};
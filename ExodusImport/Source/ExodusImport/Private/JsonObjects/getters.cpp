@@ -15,26 +15,30 @@ void JsonObjects::loadArray(JsonObjPtr data, const JsonValPtrs *&valPtrs, const
 	}
 }
 
-ResId JsonObjects::getResId(JsonObjPtr data, const char* name){
+ResId JsonObjects::getResId(JsonObjPtr data, const FString &name){
 	//It turns out that under the hood json reader treats all numbers of doubles.
 	//Double range should be sufficient to retain precision, but...
-	return ResId::fromIndex(data->GetIntegerField(FString(name)));
+	return ResId::fromIndex(data->GetIntegerField(name));
 }
 
-int32 JsonObjects::getInt(JsonObjPtr data, const char* name){
-	return data->GetIntegerField(FString(name));
+int32 JsonObjects::getInt(JsonObjPtr data, const FString &name){
+	return data->GetIntegerField(name);
 }
 
-bool JsonObjects::getBool(JsonObjPtr data, const char* name){
-	return data->GetBoolField(FString(name));
+bool JsonObjects::getBool(JsonObjPtr data, const FString &name){
+	return data->GetBoolField(name);
 }
 
-float JsonObjects::getFloat(JsonObjPtr data, const char* name){
-	return data->GetNumberField(FString(name));
+float JsonObjects::getFloat(JsonObjPtr data, const FString &name){
+	return data->GetNumberField(name);
 }
 
-float JsonObjects::getStrFloat(JsonObjPtr data, const char* name){
-	auto str = getString(data, name).ToLower();
+float JsonObjects::getStrFloat(JsonObjPtr data, const FString &name){
+	return parseFloatString(getString(data, name));
+}
+
+float JsonObjects::parseFloatString(const FString &arg){
+	auto str = arg.ToLower();
 
 	if (str == "nan")
 		return std::nan("");
@@ -44,19 +48,57 @@ float JsonObjects::getStrFloat(JsonObjPtr data, const char* name){
 		return -std::numeric_limits<float>::infinity();
 
 	return FCString::Atof(*str);
-	//return data->GetNumberField(FString(name));
 }
 
-FString JsonObjects::getString(JsonObjPtr data, const char* name){
-	return data->GetStringField(FString(name));
+FString JsonObjects::getString(JsonObjPtr data, const FString &name){
+	return data->GetStringField(name);
 }
 
-JsonObjPtr JsonObjects::getObject(JsonObjPtr data, const char* name){
-	if (!data || !data->HasField(name))
-		return 0;
-	auto result = data->GetObjectField(FString(name));
-	return result;
-	//if (!result || !result->IsvV
+JsonObjPtr JsonObjects::getObject(JsonObjPtr data, const FString &name){
+	if (!data)
+		return nullptr;
+	//single lookup instead of HasField + GetObjectField
+	auto field = data->TryGetField(name);
+	if (!field.IsValid() || (field->Type != EJson::Object))
+		return nullptr;
+	return field->AsObject();
+}
+
+namespace{
+	/*
+	Vectors, quaternions, colors and matrices are read by walking their members once.
+	Their field names are one or three characters long, so those are matched by hand 
+	instead of doing a hash lookup (and building a key string) per component.
+	*/
+	template<typename Callback> void forEachNumberField(const JsonObjPtr &obj, Callback callback){
+		for(const auto &cur: obj->Values){
+			double val = 0.0;
+			if (cur.Value.IsValid() && cur.Value->TryGetNumber(val))
+				callback(cur.Key, val);
+		}
+	}
+
+	//Index of a single-letter field within "letters", case-insensitive, or INDEX_NONE.
+	int32 getComponentIndex(const FString &key, const TCHAR *letters){
+		if (key.Len() != 1)
+			return INDEX_NONE;
+		const TCHAR c = FChar::ToLower(key[0]);
+		for(int32 i = 0; letters[i]; i++){
+			if (letters[i] == c)
+				return i;
+		}
+		return INDEX_NONE;
+	}
+
+	template<int32 NumComponents> void readComponents(const JsonObjPtr &obj, const TCHAR *letters, float (&outValues)[NumComponents]){
+		for(int32 i = 0; i < NumComponents; i++)
+			outValues[i] = 0.0f;
+		forEachNumberField(obj, [&](const FString &key, double val){
+			auto idx = getComponentIndex(key, letters);
+			if ((idx >= 0) && (idx < NumComponents))
+				outValues[idx] = (float)val;
+		});
+	}
 }
 
 FLinearColor JsonObjects::toLinearColor(const FJsonValue &data, const FLinearColor &defaultVal){
@@ -73,50 +115,42 @@ FMatrix JsonObjects::toMatrix(JsonObjPtr data, const FMatrix &defaultVal){
 	if (!data.IsValid())
 			return defaultVal;
 	FMatrix result;
-
-	result.M[0][0] = getFloat(data, "e00");
-	result.M[0][1] = getFloat(data, "e10");
-	result.M[0][2] = getFloat(data, "e20");
-	result.M[0][3] = getFloat(data, "e30");
-	result.M[1][0] = getFloat(data, "e01");
-	result.M[1][1] = getFloat(data, "e11");
-	result.M[1][2] = getFloat(data, "e21");
-	result.M[1][3] = getFloat(data, "e31");
-	result.M[2][0] = getFloat(data, "e02");
-	result.M[2][1] = getFloat(data, "e12");
-	result.M[2][2] = getFloat(data, "e22");
-	result.M[2][3] = getFloat(data, "e32");
-	result.M[3][0] = getFloat(data, "e03");
-	result.M[3][1] = getFloat(data, "e13");
-	result.M[3][2] = getFloat(data, "e23");
-	result.M[3][3] = getFloat(data, "e33");
+	FMemory::Memzero(result.M);
+
+	//M[row][col] comes from "e<col><row>"
+	forEachNumberField(data, [&](const FString &key, double val){
+		if ((key.Len() != 3) || (FChar::ToLower(key[0]) != TEXT('e')))
+			return;
+		int col = key[1] - TEXT('0');
+		int row = key[2] - TEXT('0');
+		if ((col < 0) || (col > 3) || (row < 0) || (row > 3))
+			return;
+		result.M[row][col] = (float)val;
+	});
 		
 	return result;
 }
 
-
-
 FLinearColor JsonObjects::toLinearColor(JsonObjPtr data, const FLinearColor &defaultVal){
 	FLinearColor result = defaultVal;
 	if (!data.IsValid())
 			return result;
 	
-	result.A = getFloat(data, "a");
-	result.R = getFloat(data, "r");
-	result.G = getFloat(data, "g");
-	result.B = getFloat(data, "b");
+	float rgba[4];
+	readComponents(data, TEXT("rgba"), rgba);
+	result = FLinearColor(rgba[0], rgba[1], rgba[2], rgba[3]);
 
 	return result;
 }
 
-FLinearColor JsonObjects::getLinearColor(JsonObjPtr data, const char* name, const FLinearColor &defaultVal){
+FLinearColor JsonObjects::getLinearColor(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal){
 	FLinearColor result = defaultVal;
 
 	auto colorObj = getObject(data, name);
 	return toLinearColor(colorObj, defaultVal);
 }
 
-FMatrix JsonObjects::getMatrix(JsonObjPtr data, const char* name, const FMatrix &defaultVal){
+FMatrix JsonObjects::getMatrix(JsonObjPtr data, const FString &name, const FMatrix &defaultVal){
 	FMatrix result = defaultVal;
 	auto matObj = getObject(data, name);
 	if (!matObj.IsValid())
@@ -125,46 +159,46 @@ FMatrix JsonObjects::getMatrix(JsonObjPtr data, const char* name, const FMatrix
 	return toMatrix(matObj);
 }
 
-FVector4 JsonObjects::getVector4(JsonObjPtr data, const char* name, const FVector4 &defaultVal){
+FVector4 JsonObjects::getVector4(JsonObjPtr data, const FString &name, const FVector4 &defaultVal){
 	FVector4 result = defaultVal;
 
 	auto vecObj = getObject(data, name);
 	if (!vecObj.IsValid())
 			return result;
-	result.X = getFloat(vecObj, "X");
-	result.Y = getFloat(vecObj, "Y");
-	result.Z = getFloat(vecObj, "Z");
-	result.W = getFloat(vecObj, "W");
+	float xyzw[4];
+	readComponents(vecObj, TEXT("xyzw"), xyzw);
+	result = FVector4(xyzw[0], xyzw[1], xyzw[2], xyzw[3]);
 
 	return result;
 }
 
-FVector2D JsonObjects::getVector2(JsonObjPtr data, const char* name, const FVector2D &defaultVal){
+FVector2D JsonObjects::getVector2(JsonObjPtr data, const FString &name, const FVector2D &defaultVal){
 	FVector2D result = defaultVal;
 
 	auto vecObj = getObject(data, name);
 	if (!vecObj.IsValid())
 			return result;
-	result.X = getFloat(vecObj, "X");
-	result.Y = getFloat(vecObj, "Y");
+	float xy[2];
+	readComponents(vecObj, TEXT("xy"), xy);
+	result = FVector2D(xy[0], xy[1]);
 
 	return result;
 }
 
-FVector JsonObjects::getVector(JsonObjPtr data, const char* name, const FVector &defaultVal){
+FVector JsonObjects::getVector(JsonObjPtr data, const FString &name, const FVector &defaultVal){
 	FVector result = defaultVal;
 
 	auto vecObj = getObject(data, name);
 	if (!vecObj.IsValid())
 			return result;
-	result.X = getFloat(vecObj, "X");
-	result.Y = getFloat(vecObj, "Y");
-	result.Z = getFloat(vecObj, "Z");
+	float xyz[3];
+	readComponents(vecObj, TEXT("xyz"), xyz);
+	result = FVector(xyz[0], xyz[1], xyz[2]);
 
 	return result;
 }
 
-FLinearColor JsonObjects::getGammaColorAsLinear(JsonObjPtr data, const char* name, const FLinearColor &defaultVal){
+FLinearColor JsonObjects::getGammaColorAsLinear(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal){
 	auto result = getColor(data, name, defaultVal);
 	const float gammaVal = 2.2f;
 	result.R = powf(result.R, gammaVal);
@@ -174,148 +208,199 @@ FLinearColor JsonObjects::getGammaColorAsLinear(JsonObjPtr data, const char* nam
 	return result;
 }
 
-FLinearColor JsonObjects::getColor(JsonObjPtr data, const char* name, const FLinearColor &defaultVal){
+FLinearColor JsonObjects::getColor(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal){
 	FLinearColor result = defaultVal;
 
 	auto vecObj = getObject(data, name);
 	if (!vecObj.IsValid())
 			return result;
-	result.R = getFloat(vecObj, "r");
-	result.G = getFloat(vecObj, "g");
-	result.B = getFloat(vecObj, "b");
-	result.A = getFloat(vecObj, "a");
-
-	return result;
+	return toLinearColor(vecObj, defaultVal);
 }
 
-FQuat JsonObjects::getQuat(JsonObjPtr data, const char* name, const FQuat &defaultVal){
+FQuat JsonObjects::getQuat(JsonObjPtr data, const FString &name, const FQuat &defaultVal){
 	FQuat result = defaultVal;
 
 	auto vecObj = getObject(data, name);
 	if (!vecObj.IsValid())
 			return result;
-	result.X = getFloat(vecObj, "X");
-	result.Y = getFloat(vecObj, "Y");
-	result.Z = getFloat(vecObj, "Z");
-	result.W = getFloat(vecObj, "W");
+	float xyzw[4];
+	readComponents(vecObj, TEXT("xyzw"), xyzw);
+	result = FQuat(xyzw[0], xyzw[1], xyzw[2], xyzw[3]);
 
 	return result;
 }
 
-IntArray JsonObjects::getIntArray(JsonObjPtr jsonObj, const char *name, bool optional){
-	if (optional){
-		if (!jsonObj->HasField(name))
-			return IntArray();
+namespace{
+	const JsonValPtrs* findNumberArray(JsonObjPtr jsonObj, const FString &name, bool optional){
+		if (optional){
+			if (!jsonObj->HasField(name))
+				return nullptr;
+		}
+		const JsonValPtrs* arrValues = nullptr;
+		JsonObjects::loadArray(jsonObj, arrValues, name);
+		return arrValues;
 	}
-	const JsonValPtrs* arrValues = 0;
-	loadArray(jsonObj, arrValues, name);
+
+	/*
+	One pass over the values, with no per-element growth or shared pointer copies.
+	Numbers are already doubles in FJsonValue, strings are checked for nan/inf.
+	*/
+	template<typename T, typename Converter> void decodeNumbers(const JsonValPtrs &inData, TArray<T> &outData, Converter convert){
+		const int32 num = inData.Num();
+		outData.Reset(num);
+		outData.AddUninitialized(num);
+		T* dst = outData.GetData();
+		const JsonValPtr* src = inData.GetData();
+		for(int32 i = 0; i < num; i++){
+			const FJsonValue* val = src[i].Get();
+			double number = 0.0;
+			if (val){
+				if (val->Type == EJson::Number)
+					number = val->AsNumber();
+				else if (val->Type == EJson::String)
+					number = JsonObjects::parseFloatString(val->AsString());
+			}
+			dst[i] = convert(number);
+		}
+	}
+}
+
+bool JsonObjects::getIntArray(JsonObjPtr jsonObj, const FString &name, IntArray &outData, bool optional){
+	outData.Reset();
+	auto arrValues = findNumberArray(jsonObj, name, optional);
 	if (arrValues)
-		return toIntArray(*arrValues);
-	return IntArray();
+		toIntArray(*arrValues, outData);
+	return arrValues != nullptr;
 }
 
-ByteArray JsonObjects::getByteArray(JsonObjPtr jsonObj, const char *name, bool optional){
-	if (optional){
-		if (!jsonObj->HasField(name))
-			return ByteArray();
-	}
-	const JsonValPtrs* arrValues = 0;
-	loadArray(jsonObj, arrValues, name);
+bool JsonObjects::getByteArray(JsonObjPtr jsonObj, const FString &name, ByteArray &outData, bool optional){
+	outData.Reset();
+	auto arrValues = findNumberArray(jsonObj, name, optional);
 	if (arrValues)
-		return toByteArray(*arrValues);
-	return ByteArray();
+		toByteArray(*arrValues, outData);
+	return arrValues != nullptr;
 }
 
-FloatArray JsonObjects::getFloatArray(JsonObjPtr jsonObj, const char *name, bool optional){
-	if (optional){
-		if (!jsonObj->HasField(name))
-			return FloatArray();
-	}
-	const JsonValPtrs* arrValues = 0;
-	loadArray(jsonObj, arrValues, name);
+bool JsonObjects::getFloatArray(JsonObjPtr jsonObj, const FString &name, FloatArray &outData, bool optional){
+	outData.Reset();
+	auto arrValues = findNumberArray(jsonObj, name, optional);
 	if (arrValues)
-		return toFloatArray(*arrValues);
-	return FloatArray();
+		toFloatArray(*arrValues, outData);
+	return arrValues != nullptr;
+}
+
+void JsonObjects::toFloatArray(const JsonValPtrs &inData, FloatArray &outData){
+	decodeNumbers(inData, outData, [](double val){return (float)val;});
+}
+
+void JsonObjects::toIntArray(const JsonValPtrs &inData, IntArray &outData){
+	//same rounding as FJsonValue::TryGetNumber(int32&)
+	decodeNumbers(inData, outData, [](double val){return (int32)FMath::RoundToDouble(val);});
+}
+
+void JsonObjects::toByteArray(const JsonValPtrs &inData, ByteArray &outData){
+	decodeNumbers(inData, outData, [](double val){return (uint8)FMath::Clamp((int32)FMath::RoundToDouble(val), 0, 255);});
+}
+
+IntArray JsonObjects::getIntArray(JsonObjPtr jsonObj, const FString &name, bool optional){
+	IntArray result;
+	getIntArray(jsonObj, name, result, optional);
+	return result;
+}
+
+ByteArray JsonObjects::getByteArray(JsonObjPtr jsonObj, const FString &name, bool optional){
+	ByteArray result;
+	getByteArray(jsonObj, name, result, optional);
+	return result;
+}
+
+FloatArray JsonObjects::getFloatArray(JsonObjPtr jsonObj, const FString &name, bool optional){
+	FloatArray result;
+	getFloatArray(jsonObj, name, result, optional);
+	return result;
 }
 
-void JsonObjects::getJsonValue(FLinearColor& outValue, JsonObjPtr data, const char*name){
+void JsonObjects::getJsonValue(FLinearColor& outValue, JsonObjPtr data, const FString &name){
 	outValue = getLinearColor(data, name);
 }
 
-void JsonObjects::getJsonValue(FMatrix& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FMatrix& outValue, JsonObjPtr data, const FString &name){
 	outValue = getMatrix(data, name);
 }
 
-void JsonObjects::getJsonValue(FVector2D& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FVector2D& outValue, JsonObjPtr data, const FString &name){
 	outValue = getVector2(data, name);
 }
 
-void JsonObjects::getJsonValue(FVector& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FVector& outValue, JsonObjPtr data, const FString &name){
 	outValue = getVector(data, name);
 }
 
-void JsonObjects::getJsonValue(FVector4& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FVector4& outValue, JsonObjPtr data, const FString &name){
 	outValue = getVector4(data, name);
 }
 
-void JsonObjects::getJsonValue(FQuat& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FQuat& outValue, JsonObjPtr data, const FString &name){
 	outValue = getQuat(data, name);
 }
 
-void JsonObjects::getJsonValue(int& outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(int& outValue, JsonObjPtr data, const FString &name){
 	outValue = getInt(data, name);
 }
 
-void JsonObjects::getJsonValue(ResId& outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(ResId& outValue, JsonObjPtr data, const FString &name){
 	outValue = ResId::fromIndex(getInt(data, name));
 }
 
-void JsonObjects::getJsonValue(bool& outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(bool& outValue, JsonObjPtr data, const FString &name){
 	outValue = getBool(data, name);
 }
 
-void JsonObjects::getJsonValue(float &outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(float &outValue, JsonObjPtr data, const FString &name){
 	outValue = getFloat(data, name);
 }
 
-void JsonObjects::getJsonValue(FString &outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(FString &outValue, JsonObjPtr data, const FString &name){
 	outValue = getString(data, name);
 }
 
-void JsonObjects::getJsonValue(FColor& outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(FColor& outValue, JsonObjPtr data, const FString &name){
 	outValue = getRgbColor(data, name);
 }
 
-FColor JsonObjects::getRgbColor(JsonObjPtr data, const char *name, const FColor &defaultVal){
+FColor JsonObjects::getRgbColor(JsonObjPtr data, const FString &name, const FColor &defaultVal){
 	FColor result = defaultVal;
 
 	auto colorObj = getObject(data, name);
 	if (!colorObj.IsValid())
 			return result;
-	result.A = getInt(colorObj, "a");
-	result.R = getInt(colorObj, "r");
-	result.G = getInt(colorObj, "g");
-	result.B = getInt(colorObj, "b");
+	float rgba[4];
+	readComponents(colorObj, TEXT("rgba"), rgba);
+	result.R = (uint8)FMath::Clamp(FMath::RoundToInt(rgba[0]), 0, 255);
+	result.G = (uint8)FMath::Clamp(FMath::RoundToInt(rgba[1]), 0, 255);
+	result.B = (uint8)FMath::Clamp(FMath::RoundToInt(rgba[2]), 0, 255);
+	result.A = (uint8)FMath::Clamp(FMath::RoundToInt(rgba[3]), 0, 255);
 
 	return result;
 }
 
-void JsonObjects::getJsonValue(IntArray &outValue, JsonObjPtr data, const char* name){
-	outValue = getIntArray(data, name);
+void JsonObjects::getJsonValue(IntArray &outValue, JsonObjPtr data, const FString &name){
+	getIntArray(data, name, outValue);
 }
 
-void JsonObjects::getJsonValue(StringArray &outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(StringArray &outValue, JsonObjPtr data, const FString &name){
 	outValue = getStringArray(data, name);
 }
 
-void JsonObjects::getJsonValue(FloatArray &outValue, JsonObjPtr data, const char* name){
-	outValue = getFloatArray(data, name);
+void JsonObjects::getJsonValue(FloatArray &outValue, JsonObjPtr data, const FString &name){
+	getFloatArray(data, name, outValue);
 }
 
 
 StringArray JsonObjects::toStringArray(const JsonValPtrs& inData){
 	StringArray result;
-	for(auto cur: inData){
+	result.Reserve(inData.Num());
+	for(const auto &cur: inData){
 		FString val;
 		if (cur.IsValid()){
 			cur->TryGetString(val);
@@ -327,57 +412,37 @@ StringArray JsonObjects::toStringArray(const JsonValPtrs& inData){
 
 FloatArray JsonObjects::toFloatArray(const JsonValPtrs* inData){
 	FloatArray result;
-	if (inData){
-		for(auto cur: *inData){
-			double val = 0.0;
-			if (cur.IsValid()){
-				cur->TryGetNumber(val);
-			}
-				//val = cur->AsNumber();
-			result.Add(val);
-		}
-	}
+	if (inData)
+		toFloatArray(*inData, result);
 	return result;
 }
 
-void JsonObjects::getJsonValue(ByteArray &outValue, JsonObjPtr data, const char* name){
-	outValue = getByteArray(data, name);
+void JsonObjects::getJsonValue(ByteArray &outValue, JsonObjPtr data, const FString &name){
+	getByteArray(data, name, outValue);
 }
 
-void JsonObjects::getJsonValue(LinearColorArray &outValue, JsonObjPtr data, const char* name){
+void JsonObjects::getJsonValue(LinearColorArray &outValue, JsonObjPtr data, const FString &name){
 	outValue = getLinearColorArray(data, name);
 }
 
-void JsonObjects::getJsonValue(MatrixArray &outValue, JsonObjPtr data, const char *name){
+void JsonObjects::getJsonValue(MatrixArray &outValue, JsonObjPtr data, const FString &name){
 	outValue = getMatrixArray(data, name);
 }
 
 
 IntArray JsonObjects::toIntArray(const JsonValPtrs &inData){
 	IntArray result;
-	for(auto cur: inData){
-		int32 val;
-		if (cur.IsValid()){
-			cur->TryGetNumber(val);
-		}
-		result.Add(val);
-	}
+	toIntArray(inData, result);
 	return result;
 }
 
 ByteArray JsonObjects::toByteArray(const JsonValPtrs &inData){
 	ByteArray result;
-	for(auto cur: inData){
-		uint32 val = 0;
-		if (cur.IsValid()){
-			cur->TryGetNumber(val);
-		}
-		result.Add(val);
-	}
+	toByteArray(inData, result);
 	return result;
 }
 
-StringArray JsonObjects::getStringArray(JsonObjPtr jsonObj, const char *name, bool optional){
+StringArray JsonObjects::getStringArray(JsonObjPtr jsonObj, const FString &name, bool optional){
 	if (optional){
 		if (!jsonObj->HasField(name))
 			return StringArray();
@@ -391,20 +456,14 @@ StringArray JsonObjects::getStringArray(JsonObjPtr jsonObj, const char *name, bo
 
 FloatArray JsonObjects::toFloatArray(const JsonValPtrs &inData){
 	FloatArray result;
-	for(auto cur: inData){
-		double val = 0.0;
-		if (cur.IsValid()){
-			cur->TryGetNumber(val);
-		}
-			//val = cur->AsNumber();
-		result.Add(val);
-	}
+	toFloatArray(inData, result);
 	return result;
 }
 
 LinearColorArray JsonObjects::toLinearColorArray(const JsonValPtrs &inData){
 	LinearColorArray result;
-	for(auto cur: inData){
+	result.Reserve(inData.Num());
+	for(const auto &cur: inData){
 		FLinearColor val;
 		if (cur.IsValid())
 			val = toLinearColor(*cur);
@@ -415,7 +474,8 @@ LinearColorArray JsonObjects::toLinearColorArray(const JsonValPtrs &inData){
 
 MatrixArray JsonObjects::toMatrixArray(const JsonValPtrs &inData){
 	MatrixArray result;
-	for(auto cur: inData){
+	result.Reserve(inData.Num());
+	for(const auto &cur: inData){
 		FMatrix val = FMatrix::Identity;
 		if (cur.IsValid()){
 			val = toMatrix(*cur);
@@ -426,7 +486,7 @@ MatrixArray JsonObjects::toMatrixArray(const JsonValPtrs &inData){
 }
 
 
-LinearColorArray JsonObjects::getLinearColorArray(JsonObjPtr jsonObj, const char *name){
+LinearColorArray JsonObjects::getLinearColorArray(JsonObjPtr jsonObj, const FString &name){
 	const JsonValPtrs* arrValues = 0;
 	loadArray(jsonObj, arrValues, name);
 	if (arrValues)
@@ -434,7 +494,7 @@ LinearColorArray JsonObjects::getLinearColorArray(JsonObjPtr jsonObj, const char
 	return LinearColorArray();
 }
 
-MatrixArray JsonObjects::getMatrixArray(JsonObjPtr data, const char *name, bool optional){
+MatrixArray JsonObjects::getMatrixArray(JsonObjPtr data, const FString &name, bool optional){
 	if (optional){
 		if (!data->HasField(name))
 			return MatrixArray();
@@ -2,15 +2,24 @@
 #include "JsonTypes.h"
 #include <functional>
 
+/*
+Field name as a static FString, created once per call site. 
+
+Getters take field names as const FString&, and FJsonObject lookups need FString keys anyway, 
+so passing a string literal builds (and frees) a temporary key on every lookup. 
+With thousands of objects in a scene that's a lot of tiny allocations.
+*/
+#define JSON_KEY(str) ([]() -> const FString&{static const FString jsonFieldKey(TEXT(str)); return jsonFieldKey;}())
+
 namespace JsonObjects{
-	template<typename T> TArray<T> getJsonObjArray(JsonObjPtr jsonData, const char* name){
+	template<typename T> TArray<T> getJsonObjArray(JsonObjPtr jsonData, const FString &name){
 		TArray<T> result;
 		getJsonObjArray<T>(jsonData, result, name);
 		return result;
 	}
 
-	template<typename T> void getJsonValArray(JsonObjPtr jsonData, TArray<T>& result, const char* name, std::function<T(JsonValPtr, int)> converter, bool optional = false){
-		result.Empty();
+	template<typename T> void getJsonValArray(JsonObjPtr jsonData, TArray<T>& result, const FString &name, std::function<T(JsonValPtr, int)> converter, bool optional = false){
+		result.Reset();
 		if (optional){	
 			if (!jsonData->HasField(name))
 				return;
@@ -19,32 +28,33 @@ namespace JsonObjects{
 			return;
 		}
 
-		auto arrayVal = jsonData->GetArrayField(name);
+		const auto &arrayVal = jsonData->GetArrayField(name);
 
 		if (arrayVal.Num() <= 0)
 			return;
 		
+		result.Reserve(arrayVal.Num());
 		for (int i = 0; i < arrayVal.Num(); i++){
-			auto jsonVal = arrayVal[i];
+			const auto &jsonVal = arrayVal[i];
 			if (converter){
 				result.Add(converter(jsonVal, i));
 			}
 			else{
-				result.Add(T());
+				result.AddDefaulted();
 			}
 		}
 	}
 
-	template<typename T> void getJsonObjArray(JsonObjPtr jsonData, TArray<T>& result, const char* name, std::function<T(JsonObjPtr, int)> converter){
+	template<typename T> void getJsonObjArray(JsonObjPtr jsonData, TArray<T>& result, const FString &name, std::function<T(JsonObjPtr, int)> converter){
 		getJsonValArray<T>(jsonData, result, name, 
-			[&](JsonValPtr val, int idx){
+			[&](JsonValPtr jsonVal, int idx){
 				auto jsonObj = jsonVal->AsObject();
 				if (!jsonObj.IsValid()){	
-					UE_LOG(JsonLog, Warning, TEXT("Could not retrieve array index %d from \"%s\""), idx, name);
+					UE_LOG(JsonLog, Warning, TEXT("Could not retrieve array index %d from \"%s\""), idx, *name);
 					return T();
 				}
 				if (!converter){
-					UE_LOG(JsonLog, Warning, TEXT("Converter not assigned to retrieve data[%d] from \"%s\""), idx, name);
+					UE_LOG(JsonLog, Warning, TEXT("Converter not assigned to retrieve data[%d] from \"%s\""), idx, *name);
 					return T();
 				}
 				return converter(jsonObj, idx);
@@ -52,37 +62,66 @@ namespace JsonObjects{
 		);
 	}
 
-	template<typename T> void getJsonObjArray(JsonObjPtr jsonData, TArray<T>& result, const char* name, bool optional = false){
-		result.Empty();
+	/*
+	Elements are constructed in place, existing capacity of result is reused.
+	*/
+	template<typename T> void getJsonObjArray(JsonObjPtr jsonData, TArray<T>& result, const FString &name, bool optional = false){
+		result.Reset();
 		if (optional){
 			if (!jsonData->HasField(name))
 				return;
 		}
-		auto arrayVal = jsonData->GetArrayField(name);
+		const auto &arrayVal = jsonData->GetArrayField(name);
 
 		if (arrayVal.Num() <= 0)
 			return;
 		
+		result.Reserve(arrayVal.Num());
 		for (int i = 0; i < arrayVal.Num(); i++){
-			auto jsonVal = arrayVal[i];
-			auto jsonObj = jsonVal->AsObject();
+			const auto &jsonVal = arrayVal[i];
+			const auto &jsonObj = jsonVal->AsObject();
+			if (!jsonObj.IsValid()){	
+				UE_LOG(JsonLog, Warning, TEXT("Could not retrieve index %d from \"%s\""), i, *name);
+				result.AddDefaulted();
+				continue;
+			}
+			result.Emplace(jsonObj);
+		}
+	}
+
+	/*
+	Same as above, but appends to result instead of replacing its contents. Returns number of added elements.
+	*/
+	template<typename T> int32 appendJsonObjArray(JsonObjPtr jsonData, TArray<T>& result, const FString &name, bool optional = false){
+		const JsonValPtrs* arrayVal = nullptr;
+		if (!jsonData->TryGetArrayField(name, arrayVal)){
+			if (!optional)
+				UE_LOG(JsonLog, Warning, TEXT("Could not get val array %s"), *name);
+			return 0;
+		}
+
+		const int32 first = result.Num();
+		result.Reserve(first + arrayVal->Num());
+		for (int i = 0; i < arrayVal->Num(); i++){
+			const auto &jsonObj = (*arrayVal)[i]->AsObject();
 			if (!jsonObj.IsValid()){	
-				UE_LOG(JsonLog, Warning, TEXT("Could not retrieve index %d from \"%s\""), i, name);
-				result.Add(T());
+				UE_LOG(JsonLog, Warning, TEXT("Could not retrieve index %d from \"%s\""), i, *name);
+				result.AddDefaulted();
 				continue;
 			}
-			result.Add(T(jsonObj));
+			result.Emplace(jsonObj);
 		}
+		return result.Num() - first;
 	}
 
-	template<typename T> void getJsonObj(JsonObjPtr jsonData, T& result, const char* name){
+	template<typename T> void getJsonObj(JsonObjPtr jsonData, T& result, const FString &name){
 		if (!jsonData || !jsonData->HasField(name))
 			return;
 		auto obj = jsonData->GetObjectField(name);
 		result = T(obj);
 	}
 
-	template<typename T> T getJsonObj(JsonObjPtr jsonData, const char* name){
+	template<typename T> T getJsonObj(JsonObjPtr jsonData, const FString &name){
 		if (!jsonData || !jsonData->HasField(name))
 			return T();
 		
@@ -93,20 +132,36 @@ namespace JsonObjects{
 	void loadArray(JsonObjPtr data, const JsonValPtrs *&valPtrs, const FString &name, const FString &warnName);
 	void loadArray(JsonObjPtr data, const JsonValPtrs *&valPtrs, const FString &name);
 
-	int32 getInt(JsonObjPtr data, const char* name);
-	ResId getResId(JsonObjPtr data, const char* name);
-	bool getBool(JsonObjPtr data, const char* name);
-	float getFloat(JsonObjPtr data, const char* name);
-	float getStrFloat(JsonObjPtr data, const char* name);
-	FString getString(JsonObjPtr data, const char* name);
-	JsonObjPtr getObject(JsonObjPtr data, const char* name);
-
-	IntArray getIntArray(JsonObjPtr data, const char *name, bool optional = false);
-	ByteArray getByteArray(JsonObjPtr jsonObj, const char *name, bool optional = false);
-	StringArray getStringArray(JsonObjPtr data, const char *name, bool optional = false);
-	FloatArray getFloatArray(JsonObjPtr data, const char *name, bool optional = false);
-	LinearColorArray getLinearColorArray(JsonObjPtr data, const char *name);
-	MatrixArray getMatrixArray(JsonObjPtr data, const char *name, bool optional = false);
+	int32 getInt(JsonObjPtr data, const FString &name);
+	ResId getResId(JsonObjPtr data, const FString &name);
+	bool getBool(JsonObjPtr data, const FString &name);
+	float getFloat(JsonObjPtr data, const FString &name);
+	float getStrFloat(JsonObjPtr data, const FString &name);
+	FString getString(JsonObjPtr data, const FString &name);
+	JsonObjPtr getObject(JsonObjPtr data, const FString &name);
+
+	/*
+	Bulk numeric decoding. The destination is sized once and filled in place, its capacity is kept,
+	so loaders can decode straight into their own (possibly pre-reserved) buffers. 
+	Returns false if the array was not there.
+	*/
+	bool getIntArray(JsonObjPtr data, const FString &name, IntArray &outData, bool optional = false);
+	bool getByteArray(JsonObjPtr data, const FString &name, ByteArray &outData, bool optional = false);
+	bool getFloatArray(JsonObjPtr data, const FString &name, FloatArray &outData, bool optional = false);
+
+	void toFloatArray(const JsonValPtrs &inData, FloatArray &outData);
+	void toIntArray(const JsonValPtrs &inData, IntArray &outData);
+	void toByteArray(const JsonValPtrs &inData, ByteArray &outData);
+
+	//"nan", "inf" and friends, which are exported as strings.
+	float parseFloatString(const FString &str);
+
+	IntArray getIntArray(JsonObjPtr data, const FString &name, bool optional = false);
+	ByteArray getByteArray(JsonObjPtr jsonObj, const FString &name, bool optional = false);
+	StringArray getStringArray(JsonObjPtr data, const FString &name, bool optional = false);
+	FloatArray getFloatArray(JsonObjPtr data, const FString &name, bool optional = false);
+	LinearColorArray getLinearColorArray(JsonObjPtr data, const FString &name);
+	MatrixArray getMatrixArray(JsonObjPtr data, const FString &name, bool optional = false);
 
 	//this needs cleanup
 	FloatArray toFloatArray(const JsonValPtrs &inData);
@@ -122,38 +177,38 @@ namespace JsonObjects{
 	FMatrix toMatrix(JsonObjPtr data, const FMatrix &defaultVal = FMatrix());
 	FMatrix toMatrix(const FJsonValue &data, const FMatrix &defaultVal = FMatrix());
 	
-	void getJsonValue(FLinearColor& outValue, JsonObjPtr data, const char*name);
-	void getJsonValue(FMatrix& outValue, JsonObjPtr data, const char *name);
-	void getJsonValue(FVector2D& outValue, JsonObjPtr data, const char *name);
-	void getJsonValue(FVector& outValue, JsonObjPtr data, const char *name);
-	void getJsonValue(FVector4& outValue, JsonObjPtr data, const char *name);
-	void getJsonValue(FQuat& outValue, JsonObjPtr data, const char *name);
-
-
-	void getJsonValue(int& outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(ResId& outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(bool& outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(float &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(FString &outValue, JsonObjPtr data, const char* name);
-	//JsonObjPtr getObject(JsonObjPtr data, const char* name);
-	void getJsonValue(IntArray &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(StringArray &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(FloatArray &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(LinearColorArray &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(ByteArray &outValue, JsonObjPtr data, const char* name);
-	void getJsonValue(MatrixArray &outValue, JsonObjPtr data, const char *name);
-
-	void getJsonValue(FColor& outValue, JsonObjPtr data, const char *name);
-	FColor getRgbColor(JsonObjPtr data, const char *name, const FColor &defaultVal = FColor());
-
-	FLinearColor getLinearColor(JsonObjPtr data, const char* name, const FLinearColor &defaultVal = FLinearColor());
-	FMatrix getMatrix(JsonObjPtr data, const char* name, const FMatrix &defaultVal = FMatrix::Identity);
-	FVector2D getVector2(JsonObjPtr data, const char* name, const FVector2D &defaultVal = FVector2D());
-	FVector getVector(JsonObjPtr data, const char* name, const FVector &defaultVal = FVector());
-	FVector4 getVector4(JsonObjPtr data, const char* name, const FVector4 &defaultVal = FVector4());
-	FLinearColor getColor(JsonObjPtr data, const char* name, const FLinearColor &defaultVal = FLinearColor());
-
-	FLinearColor getGammaColorAsLinear(JsonObjPtr data, const char* name, const FLinearColor &defaultVal = FLinearColor());
-
-	FQuat getQuat(JsonObjPtr data, const char* name, const FQuat &defaultVal = FQuat());
+	void getJsonValue(FLinearColor& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FMatrix& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FVector2D& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FVector& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FVector4& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FQuat& outValue, JsonObjPtr data, const FString &name);
+
+
+	void getJsonValue(int& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(ResId& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(bool& outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(float &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FString &outValue, JsonObjPtr data, const FString &name);
+	//JsonObjPtr getObject(JsonObjPtr data, const FString &name);
+	void getJsonValue(IntArray &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(StringArray &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(FloatArray &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(LinearColorArray &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(ByteArray &outValue, JsonObjPtr data, const FString &name);
+	void getJsonValue(MatrixArray &outValue, JsonObjPtr data, const FString &name);
+
+	void getJsonValue(FColor& outValue, JsonObjPtr data, const FString &name);
+	FColor getRgbColor(JsonObjPtr data, const FString &name, const FColor &defaultVal = FColor());
+
+	FLinearColor getLinearColor(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal = FLinearColor());
+	FMatrix getMatrix(JsonObjPtr data, const FString &name, const FMatrix &defaultVal = FMatrix::Identity);
+	FVector2D getVector2(JsonObjPtr data, const FString &name, const FVector2D &defaultVal = FVector2D());
+	FVector getVector(JsonObjPtr data, const FString &name, const FVector &defaultVal = FVector());
+	FVector4 getVector4(JsonObjPtr data, const FString &name, const FVector4 &defaultVal = FVector4());
+	FLinearColor getColor(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal = FLinearColor());
+
+	FLinearColor getGammaColorAsLinear(JsonObjPtr data, const FString &name, const FLinearColor &defaultVal = FLinearColor());
+
+	FQuat getQuat(JsonObjPtr data, const FString &name, const FQuat &defaultVal = FQuat());
 }
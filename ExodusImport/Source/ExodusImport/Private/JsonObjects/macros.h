@@ -3,23 +3,23 @@
 #include "getters.h"
 #include "loggers.h"
 
-#define JSON_GET_AUTO_PARAM2_LOG(obj, varName, paramName, op) auto varName = op(obj, #paramName); JsonObjects::logValue(#paramName, varName);
-#define JSON_GET_AUTO_PARAM_LOG(obj, name, op) auto name = op(obj, #name); JsonObjects::logValue(#name, name);
+#define JSON_GET_AUTO_PARAM2_LOG(obj, varName, paramName, op) auto varName = op(obj, JSON_KEY(#paramName)); JsonObjects::logValue(#paramName, varName);
+#define JSON_GET_AUTO_PARAM_LOG(obj, name, op) auto name = op(obj, JSON_KEY(#name)); JsonObjects::logValue(#name, name);
 
-#define JSON_GET_AUTO_PARAM2_NOLOG(obj, varName, paramName, op) auto varName = op(obj, #paramName);
-#define JSON_GET_AUTO_PARAM_NOLOG(obj, name, op) auto name = op(obj, #name);
+#define JSON_GET_AUTO_PARAM2_NOLOG(obj, varName, paramName, op) auto varName = op(obj, JSON_KEY(#paramName));
+#define JSON_GET_AUTO_PARAM_NOLOG(obj, name, op) auto name = op(obj, JSON_KEY(#name));
 
-#define JSON_GET_PARAM2_LOG(obj, varName, paramName, op) varName = op(obj, #paramName); JsonObjects::logValue(#paramName, varName);
-#define JSON_GET_PARAM_LOG(obj, name, op) name = op(obj, #name); JsonObjects::logValue(#name, name);
+#define JSON_GET_PARAM2_LOG(obj, varName, paramName, op) varName = op(obj, JSON_KEY(#paramName)); JsonObjects::logValue(#paramName, varName);
+#define JSON_GET_PARAM_LOG(obj, name, op) name = op(obj, JSON_KEY(#name)); JsonObjects::logValue(#name, name);
 
-#define JSON_GET_PARAM2_NOLOG(obj, varName, paramName, op) varName = op(obj, #paramName);
-#define JSON_GET_PARAM_NOLOG(obj, name, op) name = op(obj, #name);
+#define JSON_GET_PARAM2_NOLOG(obj, varName, paramName, op) varName = op(obj, JSON_KEY(#paramName));
+#define JSON_GET_PARAM_NOLOG(obj, name, op) name = op(obj, JSON_KEY(#name));
 
-#define JSON_GET_VAR_LOG(obj, name) JsonObjects::getJsonValue(name, obj, #name); JsonObjects::logValue(#name, name);
-#define JSON_GET_VAR2_LOG(obj, name, paramName) JsonObjects::getJsonValue(name, obj, #paramName); JsonObjects::logValue(#paramName, name);
+#define JSON_GET_VAR_LOG(obj, name) JsonObjects::getJsonValue(name, obj, JSON_KEY(#name)); JsonObjects::logValue(#name, name);
+#define JSON_GET_VAR2_LOG(obj, name, paramName) JsonObjects::getJsonValue(name, obj, JSON_KEY(#paramName)); JsonObjects::logValue(#paramName, name);
 
-#define JSON_GET_VAR_NOLOG(obj, name) JsonObjects::getJsonValue(name, obj, #name);
-#define JSON_GET_VAR2_NOLOG(obj, name, paramName) JsonObjects::getJsonValue(name, obj, #paramName);
+#define JSON_GET_VAR_NOLOG(obj, name) JsonObjects::getJsonValue(name, obj, JSON_KEY(#name));
+#define JSON_GET_VAR2_NOLOG(obj, name, paramName) JsonObjects::getJsonValue(name, obj, JSON_KEY(#paramName));
 
 #ifdef JSON_ENABLE_VALUE_LOGGING
 
@@ -45,5 +45,10 @@
 
 #endif
 
-#define JSON_GET_OBJ(data, objName) JsonObjects::getJsonObj(data, objName, #objName);
-#define JSON_GET_ARRAY(data, objName) JsonObjects::getJsonObjArray(data, objName, #objName);
+#define JSON_GET_OBJ(data, objName) JsonObjects::getJsonObj(data, objName, JSON_KEY(#objName));
+#define JSON_GET_ARRAY(data, objName) JsonObjects::getJsonObjArray(data, objName, JSON_KEY(#objName));
+
+/*
+For load(JsonStreamReader&) field callbacks. Reads the field into the member with the same name.
+*/
+#define JSON_STREAM_VAR(reader, fieldName, name) if (fieldName == TEXT(#name)) return reader.readValue(name);
@@ -1,6 +1,10 @@
 #include "JsonImportPrivatePCH.h"
 #include "terrainTools.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Math/VectorRegister.h"
 
 using namespace JsonTerrainTools;
 
@@ -12,20 +16,6 @@ constexpr float intToVertCoord(int x, float stripSize){
 	return ((float)x) * stripSize;
 }
 
-FVector2D intToSplatCoord(const FIntPoint xy, const FVector2D &pixelSize){
-	return FVector2D(
-		intToSplatCoord(xy.X, pixelSize.X),
-		intToSplatCoord(xy.Y, pixelSize.Y)
-	);
-}
-
-FVector2D intToVertCoord(const FIntPoint &xy, const FVector2D &stripSize){
-	return FVector2D(
-		intToVertCoord(xy.X, stripSize.X),
-		intToVertCoord(xy.Y, stripSize.Y)
-	);
-}
-
 constexpr float splatToPixCoord(float x, float pixelScale){
 	return x * pixelScale - 0.5f;
 }
@@ -34,316 +24,271 @@ constexpr float vertToPixCoord(float x, float pixelScale){
 	return x * pixelScale;
 }
 
-FVector2D splatToPixCoord(const FVector2D &xy, const FVector2D &pixelScale){
-	return FVector2D(
-		splatToPixCoord(xy.X, pixelScale.X),
-		splatToPixCoord(xy.Y, pixelScale.Y)
-	);
-}
-
-FVector2D vertToPixCoord(const FVector2D &xy, const FVector2D &pixelScale){
-	return FVector2D(
-		vertToPixCoord(xy.X, pixelScale.X),
-		vertToPixCoord(xy.Y, pixelScale.Y)
-	);
-}
-
-//uses linear interpolation internally. As this is how unity does it.
-bool JsonTerrainTools::rescaleSplatMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui){
-	if (dst.isEmpty() || src.isEmpty())
-		return false;
-
-	const FVector2D srcPixelScale = FVector2D((float)src.getWidth(), (float)src.getHeight());
-	const FVector2D dstPixelScale = FVector2D((float)dst.getWidth(), (float)dst.getHeight());
-
-	const FVector2D srcPixelSize = FVector2D(1.0f, 1.0f)/srcPixelScale;
-	const FVector2D dstPixelSize = FVector2D(1.0f, 1.0f)/dstPixelScale;
-
-	const int32 minSrcY = 0;
-	const int32 maxSrcY = src.getHeight() - 1;
-	const int32 minSrcX = 0;
-	const int32 maxSrcX = src.getWidth() - 1;
-
-	TUniquePtr<FScopedSlowTask> guiTask;
-	if (gui){
-		guiTask = MakeUnique<FScopedSlowTask>(dst.getHeight());
+namespace{
+	/*
+	How destination pixels map onto source ones. 
+	Splat maps store pixel centers, height maps store vertices, so the two end up half a pixel apart.
+	*/
+	enum class CoordMapping{
+		SplatToSplat, VertToSplat, VertToVert
+	};
+
+	float dstToSrcCoord(CoordMapping mapping, int32 dstIndex, int32 dstSize, int32 srcSize){
+		switch(mapping){
+			case CoordMapping::SplatToSplat:
+				return splatToPixCoord(intToSplatCoord(dstIndex, 1.0f/(float)dstSize), (float)srcSize);
+			case CoordMapping::VertToSplat:
+				if (dstSize < 2)
+					return splatToPixCoord(0.0f, (float)srcSize);
+				return splatToPixCoord(intToVertCoord(dstIndex, 1.0f/(float)(dstSize - 1)), (float)srcSize);
+			case CoordMapping::VertToVert:
+			default:
+				if (dstSize < 2)
+					return 0.0f;
+				return vertToPixCoord(intToVertCoord(dstIndex, 1.0f/(float)(dstSize - 1)), (float)(srcSize - 1));
+		}
 	}
 
-	for(int32 dstY = 0; dstY < dst.getHeight(); dstY++){
-		float* dstRowData = dst.getRow(dstY);
-
-		auto dstV = intToSplatCoord(dstY, dstPixelSize.Y);
-		auto srcY = splatToPixCoord(dstV, srcPixelScale.Y);
-
-		auto srcYBase = FMath::FloorToInt(srcY);
-		auto srcY0 = FMath::Clamp(srcYBase, minSrcY, maxSrcY);
-		auto srcY1 = FMath::Clamp(srcYBase + 1, minSrcY, maxSrcY);
-		auto yLerp = FMath::Frac(srcY);
-
-		auto srcRowY0 = src.getRow(srcY0);
-		auto srcRowY1 = src.getRow(srcY1);
-
-		for(int32 dstX = 0; dstX < dst.getWidth(); dstX++){
-			auto dstU = intToSplatCoord(dstX, dstPixelSize.X);
-			auto srcX = splatToPixCoord(dstU, srcPixelScale.X);
+	/*
+	Source indices and weights for every destination row or column. 
+	They're the same for all rows, so they're computed once instead of per pixel.
 
-			auto srcXBase = FMath::FloorToInt(srcX);
-			auto srcX0 = FMath::Clamp(srcXBase, minSrcX, maxSrcX);
-			auto srcX1 = FMath::Clamp(srcXBase + 1, minSrcX, maxSrcX);
+	Can cover only a part of the destination (dstFirst, dstCount), entries are then indexed from dstFirst.
+	*/
+	struct ResampleAxis{
+		int32 numTaps = 2;
+		IntArray indices;//numTaps per entry
+		FloatArray weights;//numTaps per entry
 
-			auto xLerp = FMath::Frac(srcX);
-
-			auto val = FMath::Lerp(
-				FMath::Lerp(srcRowY0[srcX0], srcRowY0[srcX1], xLerp),
-				FMath::Lerp(srcRowY1[srcX0], srcRowY1[srcX1], xLerp),
-				yLerp
-			);
-
-			dstRowData[dstX] = val;//1.0f;
+		const int32* getIndices(int32 dstIndex) const{
+			return indices.GetData() + dstIndex * numTaps;
 		}
-		if (gui){
-			guiTask->EnterProgressFrame(1.0f);
+		const float* getWeights(int32 dstIndex) const{
+			return weights.GetData() + dstIndex * numTaps;
 		}
-	}
-
-	return true;
-}
-
-//uses linear interpolation internally. As this is how unity does it.
-bool JsonTerrainTools::scaleSplatMapToHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui){
-	if (dst.isEmpty() || src.isEmpty())
-		return false;
 
-	const FVector2D srcPixelScale = FVector2D((float)src.getWidth(), (float)src.getHeight());
-	const FVector2D dstPixelScale = FVector2D((float)(dst.getWidth() - 1), (float)(dst.getHeight() - 1));
+		//Source range (max exclusive) the entries read from.
+		void getSourceRange(int32 &outMin, int32 &outMax) const{
+			outMin = MAX_int32;
+			outMax = 0;
+			for(auto idx: indices){
+				outMin = FMath::Min(outMin, idx);
+				outMax = FMath::Max(outMax, idx + 1);
+			}
+			outMin = FMath::Min(outMin, outMax);
+		}
 
-	const FVector2D srcPixelSize = FVector2D(1.0f, 1.0f)/srcPixelScale;
-	const FVector2D dstPixelSize = FVector2D(1.0f, 1.0f)/dstPixelScale;
+		//For sources that only hold a window starting at srcOffset.
+		void rebase(int32 srcOffset){
+			for(auto &idx: indices)
+				idx -= srcOffset;
+		}
 
-	const int32 minSrcY = 0;
-	const int32 maxSrcY = src.getHeight() - 1;
-	const int32 minSrcX = 0;
-	const int32 maxSrcX = src.getWidth() - 1;
+		ResampleAxis(CoordMapping mapping, ResampleFilter filter, int32 dstSize, int32 srcSize)
+		:ResampleAxis(mapping, filter, dstSize, srcSize, 0, dstSize){
+		}
 
-	TUniquePtr<FScopedSlowTask> guiTask;
-	if (gui){
-		guiTask = MakeUnique<FScopedSlowTask>(dst.getHeight());
+		ResampleAxis(CoordMapping mapping, ResampleFilter filter, int32 dstSize, int32 srcSize, int32 dstFirst, int32 dstCount){
+			numTaps = (filter == ResampleFilter::CatmullRom) ? 4: 2;
+			indices.SetNumUninitialized(dstCount * numTaps);
+			weights.SetNumUninitialized(dstCount * numTaps);
+			const int32 firstTap = (numTaps == 4) ? -1: 0;
+			const int32 maxSrc = srcSize - 1;
+
+			for(int32 entry = 0; entry < dstCount; entry++){
+				const float srcCoord = dstToSrcCoord(mapping, dstFirst + entry, dstSize, srcSize);
+				const int32 srcBase = FMath::FloorToInt(srcCoord);
+				const float t = FMath::Clamp(FMath::Frac(srcCoord), 0.0f, 1.0f);
+
+				int32* curIndices = indices.GetData() + entry * numTaps;
+				float* curWeights = weights.GetData() + entry * numTaps;
+				for(int32 tap = 0; tap < numTaps; tap++){
+					curIndices[tap] = FMath::Clamp(srcBase + firstTap + tap, 0, maxSrc);
+				}
+				if (numTaps == 4){
+					catmullRomUniformWeights(t, curWeights);
+				}
+				else{
+					curWeights[0] = 1.0f - t;
+					curWeights[1] = t;
+				}
+			}
+		}
+	};
+
+	/*
+	Vertical pass. Weighted sum of numTaps source rows, contiguous, so it is done 4 floats at a time.
+	For cubic filter the result is kept between the two middle rows. Plain catmull-rom goes above/below them
+	next to sharp changes, which on heightmaps shows up as spikes along ridges and cliffs.
+	*/
+	void blendRows(float* dst, const float* const* rows, const float* weights, int32 numTaps, int32 num){
+		const bool clampToMiddle = (numTaps == 4);
+		int32 x = 0;
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+		VectorRegister weightRegs[4];
+		for(int32 tap = 0; tap < numTaps; tap++)
+			weightRegs[tap] = VectorSetFloat1(weights[tap]);
+
+		for(; (x + 4) <= num; x += 4){
+			VectorRegister acc = VectorMultiply(VectorLoad(rows[0] + x), weightRegs[0]);
+			for(int32 tap = 1; tap < numTaps; tap++){
+				acc = VectorMultiplyAdd(VectorLoad(rows[tap] + x), weightRegs[tap], acc);
+			}
+			if (clampToMiddle){
+				const VectorRegister a = VectorLoad(rows[1] + x);
+				const VectorRegister b = VectorLoad(rows[2] + x);
+				acc = VectorMin(VectorMax(acc, VectorMin(a, b)), VectorMax(a, b));
+			}
+			VectorStore(acc, dst + x);
+		}
+#endif
+		for(; x < num; x++){
+			float acc = 0.0f;
+			for(int32 tap = 0; tap < numTaps; tap++)
+				acc += rows[tap][x] * weights[tap];
+			if (clampToMiddle)
+				acc = FMath::Clamp(acc, FMath::Min(rows[1][x], rows[2][x]), FMath::Max(rows[1][x], rows[2][x]));
+			dst[x] = acc;
+		}
 	}
 
-	for(int32 dstY = 0; dstY < dst.getHeight(); dstY++){
-		float* dstRowData = dst.getRow(dstY);
-
-		//This is extremely error-prone and should be probably moved into DataPlane class
-		auto dstV = intToVertCoord(dstY, dstPixelSize.Y);
-		auto srcY = splatToPixCoord(dstV, srcPixelScale.Y);
-
-		auto srcYBase = FMath::FloorToInt(srcY);
-		auto srcY0 = FMath::Clamp(srcYBase, minSrcY, maxSrcY);
-		auto srcY1 = FMath::Clamp(srcYBase + 1, minSrcY, maxSrcY);
-		auto yLerp = FMath::Frac(srcY);
-
-		auto srcRowY0 = src.getRow(srcY0);
-		auto srcRowY1 = src.getRow(srcY1);
-
-		for(int32 dstX = 0; dstX < dst.getWidth(); dstX++){
-			auto dstU = intToVertCoord(dstX, dstPixelSize.X);
-			auto srcX = splatToPixCoord(dstU, srcPixelScale.X);
-
-			auto srcXBase = FMath::FloorToInt(srcX);
-			auto srcX0 = FMath::Clamp(srcXBase, minSrcX, maxSrcX);
-			auto srcX1 = FMath::Clamp(srcXBase + 1, minSrcX, maxSrcX);
-
-			auto xLerp = FMath::Frac(srcX);
-
-			auto val = FMath::Lerp(
-				FMath::Lerp(srcRowY0[srcX0], srcRowY0[srcX1], xLerp),
-				FMath::Lerp(srcRowY1[srcX0], srcRowY1[srcX1], xLerp),
-				yLerp
-			);
-
-			dstRowData[dstX] = val;//1.0f;
+	//Horizontal pass. Gathers from the blended row through the lookup table.
+	void sampleColumns(float* dst, const float* blendedRow, const ResampleAxis &xAxis, int32 num){
+		if (xAxis.numTaps == 4){
+			for(int32 x = 0; x < num; x++){
+				const int32* idx = xAxis.getIndices(x);
+				const float* w = xAxis.getWeights(x);
+				const float a = blendedRow[idx[1]];
+				const float b = blendedRow[idx[2]];
+				const float val = blendedRow[idx[0]] * w[0] + a * w[1] + b * w[2] + blendedRow[idx[3]] * w[3];
+				dst[x] = FMath::Clamp(val, FMath::Min(a, b), FMath::Max(a, b));
+			}
+			return;
 		}
-		if (gui){
-			guiTask->EnterProgressFrame(1.0f);
+		for(int32 x = 0; x < num; x++){
+			const int32* idx = xAxis.getIndices(x);
+			const float* w = xAxis.getWeights(x);
+			dst[x] = blendedRow[idx[0]] * w[0] + blendedRow[idx[1]] * w[1];
 		}
 	}
 
-	return true;
-}
-
-float filterNearest(float a, float b, float t){
-	return (t < 0.5f) ? a: b;
-}
-
-float filterLinear(float a, float b, float t){
-	return FMath::Lerp(a, b, t);
-}
-
-bool JsonTerrainTools::rescaleHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui){
-	if (dst.isEmpty() || src.isEmpty())
-		return false;
-
-	const FVector2D srcPixelScale = FVector2D((float)(src.getWidth() - 1), (float)(src.getHeight() - 1));
-	const FVector2D dstPixelScale = FVector2D((float)(dst.getWidth() - 1), (float)(dst.getHeight() - 1));
-
-	const FVector2D srcPixelSize = FVector2D(1.0f, 1.0f)/srcPixelScale;
-	const FVector2D dstPixelSize = FVector2D(1.0f, 1.0f)/dstPixelScale;
-
-
-	const int32 minSrcY = 0;
-	const int32 maxSrcY = src.getHeight() - 1;
-	const int32 minSrcX = 0;
-	const int32 maxSrcX = src.getWidth() - 1;
+	/*
+	Rows are handed out in chunks, each worker has its own scratch row.
+	
+	Workers never touch the slow task (it is game thread only), they bump rowsDone, 
+	and the calling thread polls it while the work runs in the background.
+	*/
+	const int32 resampleRowsPerChunk = 16;
+
+	template<typename RowFunc> void processRowsParallel(int32 numRows, bool gui, RowFunc rowFunc){
+		const int32 numChunks = (numRows + resampleRowsPerChunk - 1) / resampleRowsPerChunk;
+		FThreadSafeCounter rowsDone;
+
+		auto runChunks = [&](){
+			ParallelFor(numChunks, [&](int32 chunkIndex){
+				FloatArray scratchRow;
+				const int32 firstRow = chunkIndex * resampleRowsPerChunk;
+				const int32 lastRow = FMath::Min(firstRow + resampleRowsPerChunk, numRows);
+				for(int32 y = firstRow; y < lastRow; y++){
+					rowFunc(y, scratchRow);
+				}
+				rowsDone.Add(lastRow - firstRow);
+			});
+		};
+
+		if (!gui || !IsInGameThread() || !FPlatformProcess::SupportsMultithreading()){
+			runChunks();
+			return;
+		}
 
-	TUniquePtr<FScopedSlowTask> guiTask;
-	if (gui){
-		guiTask = MakeUnique<FScopedSlowTask>(dst.getHeight());
+		FScopedSlowTask guiTask((float)numRows);
+		auto future = Async(EAsyncExecution::TaskGraph, runChunks);
+		int32 rowsReported = 0;
+		auto reportProgress = [&](){
+			const int32 curRows = rowsDone.GetValue();
+			if (curRows > rowsReported){
+				guiTask.EnterProgressFrame((float)(curRows - rowsReported));
+				rowsReported = curRows;
+			}
+		};
+		while(!future.WaitFor(FTimespan::FromMilliseconds(50.0))){
+			reportProgress();
+		}
+		reportProgress();
 	}
 
-	for(int32 dstY = 0; dstY < dst.getHeight(); dstY++){
-		float* dstRowData = dst.getRow(dstY);
+	void resampleRows(FloatPlane2D &dst, const FloatPlane2D &src, const ResampleAxis &xAxis, const ResampleAxis &yAxis, bool gui){
+		const int32 srcWidth = src.getWidth();
+		const int32 dstWidth = dst.getWidth();
 
-		auto dstV = intToVertCoord(dstY, dstPixelSize.Y);
-		auto srcY = vertToPixCoord(dstV, srcPixelScale.Y);
+		processRowsParallel(dst.getHeight(), gui, [&](int32 dstY, FloatArray &scratchRow){
+			scratchRow.SetNumUninitialized(srcWidth, false);
 
-		auto srcYBase = FMath::FloorToInt(srcY);
-		auto yLerp = FMath::Frac(srcY);
+			const int32* rowIndices = yAxis.getIndices(dstY);
+			const float* srcRows[4];
+			for(int32 tap = 0; tap < yAxis.numTaps; tap++)
+				srcRows[tap] = src.getRow(rowIndices[tap]);
 
-		auto srcY0 = FMath::Clamp(srcYBase + 0, minSrcY, maxSrcY);
-		auto srcY1 = FMath::Clamp(srcYBase + 1, minSrcY, maxSrcY);
+			blendRows(scratchRow.GetData(), srcRows, yAxis.getWeights(dstY), yAxis.numTaps, srcWidth);
+			sampleColumns(dst.getRow(dstY), scratchRow.GetData(), xAxis, dstWidth);
+		});
+	}
 
-		auto srcRowY0 = src.getRow(srcY0);
-		auto srcRowY1 = src.getRow(srcY1);
+	bool resamplePlane(FloatPlane2D &dst, const FloatPlane2D &src, CoordMapping mapping, ResampleFilter filter, bool gui){
+		if (dst.isEmpty() || src.isEmpty())
+			return false;
 
-		for(int32 dstX = 0; dstX < dst.getWidth(); dstX++){
-			auto dstU = intToVertCoord(dstX, dstPixelSize.X);
-			auto srcX = vertToPixCoord(dstU, srcPixelScale.X);
+		const ResampleAxis xAxis(mapping, filter, dst.getWidth(), src.getWidth());
+		const ResampleAxis yAxis(mapping, filter, dst.getHeight(), src.getHeight());
+		resampleRows(dst, src, xAxis, yAxis, gui);
+		return true;
+	}
 
-			auto srcXBase = FMath::FloorToInt(srcX);
-			auto xLerp = FMath::Clamp(FMath::Frac(srcX), 0.0f, 1.0f);
+	bool resamplePlaneRegion(FloatPlane2D &dst, const FIntPoint &fullDstSize, const FIntRect &dstRegion, 
+			const FIntPoint &srcSize, const SourceWindowFunc &fetchSource, CoordMapping mapping, ResampleFilter filter, bool gui){
+		check(fetchSource);
+		if ((dstRegion.Area() <= 0) || (srcSize.X <= 0) || (srcSize.Y <= 0))
+			return false;
 
-			auto srcX0 = FMath::Clamp(srcXBase + 0, minSrcX, maxSrcX);
-			auto srcX1 = FMath::Clamp(srcXBase + 1, minSrcX, maxSrcX);
+		ResampleAxis xAxis(mapping, filter, fullDstSize.X, srcSize.X, dstRegion.Min.X, dstRegion.Width());
+		ResampleAxis yAxis(mapping, filter, fullDstSize.Y, srcSize.Y, dstRegion.Min.Y, dstRegion.Height());
 
-			auto vy0 = filterLinear(srcRowY0[srcX0], srcRowY0[srcX1], xLerp);
-			auto vy1 = filterLinear(srcRowY1[srcX0], srcRowY1[srcX1], xLerp);
-			auto val = filterLinear(vy0, vy1, yLerp);
-			//I tried more advanced interpolation, but it, sadly, causes overshoot at ridges.
+		FIntRect srcWindow;
+		xAxis.getSourceRange(srcWindow.Min.X, srcWindow.Max.X);
+		yAxis.getSourceRange(srcWindow.Min.Y, srcWindow.Max.Y);
+		xAxis.rebase(srcWindow.Min.X);
+		yAxis.rebase(srcWindow.Min.Y);
 
-			dstRowData[dstX] = val;//1.0f;
-		}
+		FloatPlane2D src;
+		fetchSource(src, srcWindow);
+		check((src.getWidth() == srcWindow.Width()) && (src.getHeight() == srcWindow.Height()));
 
-		if (gui){
-			guiTask->EnterProgressFrame(1.0f);
-		}
+		dst.resize(dstRegion.Width(), dstRegion.Height());
+		resampleRows(dst, src, xAxis, yAxis, gui);
+		return true;
 	}
-
-	return true;
 }
-#if 0
-//uses linear interpolation internally
-bool JsonTerrainTools::rescaleHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui){
-	if (dst.isEmpty() || src.isEmpty())
-		return false;
-
-	const FVector2D srcPixelScale = FVector2D((float)(src.getWidth() - 1), (float)(src.getHeight() - 1));
-	const FVector2D dstPixelScale = FVector2D((float)(dst.getWidth() - 1), (float)(dst.getHeight() - 1));
-
-	const FVector2D srcPixelSize = FVector2D(1.0f, 1.0f)/srcPixelScale;
-	const FVector2D dstPixelSize = FVector2D(1.0f, 1.0f)/dstPixelScale;
-
 
-	const int32 minSrcY = 0;
-	const int32 maxSrcY = src.getHeight() - 1;
-	const int32 minSrcX = 0;
-	const int32 maxSrcX = src.getWidth() - 1;
+//uses linear interpolation by default. As this is how unity does it.
+bool JsonTerrainTools::rescaleSplatMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui, ResampleFilter filter){
+	return resamplePlane(dst, src, CoordMapping::SplatToSplat, filter, gui);
+}
 
-	TUniquePtr<FScopedSlowTask> guiTask;
-	if (gui){
-		guiTask = MakeUnique<FScopedSlowTask>(dst.getHeight());
-	}
+bool JsonTerrainTools::scaleSplatMapToHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui, ResampleFilter filter){
+	//Destination is vertices, source is pixels.
+	return resamplePlane(dst, src, CoordMapping::VertToSplat, filter, gui);
+}
 
-	for(int32 dstY = 0; dstY < dst.getHeight(); dstY++){
-		float* dstRowData = dst.getRow(dstY);
-
-		auto dstV = intToVertCoord(dstY, dstPixelSize.Y);
-		auto srcY = vertToPixCoord(dstV, srcPixelScale.Y);
-
-		auto srcYBase = FMath::FloorToInt(srcY);
-		auto yLerp = FMath::Frac(srcY);
-
-		auto srcY0 = FMath::Clamp(srcYBase - 1, minSrcY, maxSrcY);
-		auto srcY1 = FMath::Clamp(srcYBase + 0, minSrcY, maxSrcY);
-		auto srcY2 = FMath::Clamp(srcYBase + 1, minSrcY, maxSrcY);
-		auto srcY3 = FMath::Clamp(srcYBase + 2, minSrcY, maxSrcY);
-
-		auto srcRowY0 = src.getRow(srcY0);
-		auto srcRowY1 = src.getRow(srcY1);
-		auto srcRowY2 = src.getRow(srcY2);
-		auto srcRowY3 = src.getRow(srcY3);
-
-		for(int32 dstX = 0; dstX < dst.getWidth(); dstX++){
-			auto dstU = intToVertCoord(dstX, dstPixelSize.X);
-			auto srcX = vertToPixCoord(dstU, srcPixelScale.X);
-
-			auto srcXBase = FMath::FloorToInt(srcX);
-			auto xLerp = FMath::Clamp(FMath::Frac(srcX), 0.0f, 1.0f);
-
-			auto srcX0 = FMath::Clamp(srcXBase - 1, minSrcX, maxSrcX);
-			auto srcX1 = FMath::Clamp(srcXBase + 0, minSrcX, maxSrcX);
-			auto srcX2 = FMath::Clamp(srcXBase + 1, minSrcX, maxSrcX);
-			auto srcX3 = FMath::Clamp(srcXBase + 2, minSrcX, maxSrcX);
-
-			/*
-			auto vy0 = interpolateCatmullRom(srcRowY0, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy1 = interpolateCatmullRom(srcRowY1, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy2 = interpolateCatmullRom(srcRowY2, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy3 = interpolateCatmullRom(srcRowY3, srcX0, srcX1, srcX2, srcX3, xLerp);
-
-			auto val = interpolateCatmullRom(
-				vy0, vy1, vy2, vy3, yLerp
-			);
-			*/
-			/*
-			auto vy1 = filterNearest(srcRowY1[srcX1], srcRowY1[srcX2], xLerp);
-			auto vy2 = filterNearest(srcRowY2[srcX1], srcRowY2[srcX2], xLerp);
-			auto val = filterNearest(vy1, vy2, yLerp);
-			*/
-
-			/*
-			auto vy1 = filterLinear(srcRowY1[srcX1], srcRowY1[srcX2], xLerp);
-			auto vy2 = filterLinear(srcRowY2[srcX1], srcRowY2[srcX2], xLerp);
-			auto val = filterLinear(vy1, vy2, yLerp);
-			*/
-
-			auto vy0 = interpolateCatmullRom(srcRowY0, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy1 = interpolateCatmullRom(srcRowY1, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy2 = interpolateCatmullRom(srcRowY2, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy3 = interpolateCatmullRom(srcRowY3, srcX0, srcX1, srcX2, srcX3, xLerp);
-
-			auto val = interpolateCatmullRom(
-				vy0, vy1, vy2, vy3, yLerp
-			);
-			/*
-			auto vy0 = interpolateCatmullRomUniform(srcRowY0, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy1 = interpolateCatmullRomUniform(srcRowY1, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy2 = interpolateCatmullRomUniform(srcRowY2, srcX0, srcX1, srcX2, srcX3, xLerp);
-			auto vy3 = interpolateCatmullRomUniform(srcRowY3, srcX0, srcX1, srcX2, srcX3, xLerp);
-
-			auto val = interpolateCatmullRomUniform(
-				vy0, vy1, vy2, vy3, yLerp
-			);
-			*/
-
-
-			dstRowData[dstX] = val;//1.0f;
-		}
+bool JsonTerrainTools::rescaleHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui, ResampleFilter filter){
+	return resamplePlane(dst, src, CoordMapping::VertToVert, filter, gui);
+}
 
-		if (gui){
-			guiTask->EnterProgressFrame(1.0f);
-		}
-	}
+bool JsonTerrainTools::scaleSplatMapToHeightMapRegion(FloatPlane2D &dst, const FIntPoint &fullDstSize, const FIntRect &dstRegion, 
+		const FIntPoint &srcSize, const SourceWindowFunc &fetchSource, bool gui, ResampleFilter filter){
+	return resamplePlaneRegion(dst, fullDstSize, dstRegion, srcSize, fetchSource, CoordMapping::VertToSplat, filter, gui);
+}
 
-	return true;
+bool JsonTerrainTools::rescaleHeightMapRegion(FloatPlane2D &dst, const FIntPoint &fullDstSize, const FIntRect &dstRegion, 
+		const FIntPoint &srcSize, const SourceWindowFunc &fetchSource, bool gui, ResampleFilter filter){
+	return resamplePlaneRegion(dst, fullDstSize, dstRegion, srcSize, fetchSource, CoordMapping::VertToVert, filter, gui);
 }
-#endif
\ No newline at end of file
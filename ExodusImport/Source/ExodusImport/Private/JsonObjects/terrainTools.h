@@ -2,19 +2,53 @@
 
 #include "JsonTypes.h"
 #include "DataPlane2D.h"
+#include <functional>
 
 using FloatPlane2D = DataPlane2D<float>;
 namespace JsonTerrainTools{
+	/*
+	Linear is what unity uses, and it is the default everywhere.
+	CatmullRom is smoother, and is clamped to the two middle samples, so it doesn't overshoot at ridges.
+	Only used for height maps, when enabled with JsonImporter::setSmoothLandscapeResampling.
+	*/
+	enum class ResampleFilter{
+		Linear, CatmullRom
+	};
+
+	/*
+	All of these work on whole rows: source rows are blended first (vectorized), then columns are picked
+	using lookup tables built once per call. Destination rows are split between task graph workers.
+
+	With gui set, progress is reported through FScopedSlowTask. Workers only bump a counter, 
+	the slow task is ticked from the calling thread while it waits for them.
+	*/
+
 	//For remapping unity terrain masks onto unreal data layout
-	bool scaleSplatMapToHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false);
+	bool scaleSplatMapToHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false, 
+		ResampleFilter filter = ResampleFilter::Linear);
 
-	//uses linear interpolation internally. As this is how unity does it.
-	bool rescaleSplatMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false);
+	//uses linear interpolation by default. As this is how unity does it.
+	bool rescaleSplatMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false, 
+		ResampleFilter filter = ResampleFilter::Linear);
 
-	//uses linear interpolation internally
-	bool rescaleHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false);
+	//uses linear interpolation by default
+	bool rescaleHeightMap(FloatPlane2D &dst, const FloatPlane2D &src, bool gui = false, 
+		ResampleFilter filter = ResampleFilter::Linear);
 
-	//This is broken.
+	/*
+	Region versions of the above, for converting a large terrain tile by tile.
+
+	dst receives only dstRegion (max exclusive) of a destination that is fullDstSize large, pixels are the same 
+	as in a full resample. Source is srcSize large, but only the window the region reads from is requested 
+	through fetchSource (window is max exclusive, outWindow must be resized to it). 
+	*/
+	using SourceWindowFunc = std::function<void(FloatPlane2D &outWindow, const FIntRect &window)>;
+
+	bool scaleSplatMapToHeightMapRegion(FloatPlane2D &dst, const FIntPoint &fullDstSize, const FIntRect &dstRegion, 
+		const FIntPoint &srcSize, const SourceWindowFunc &fetchSource, bool gui = false, ResampleFilter filter = ResampleFilter::Linear);
+
+	bool rescaleHeightMapRegion(FloatPlane2D &dst, const FIntPoint &fullDstSize, const FIntRect &dstRegion, 
+		const FIntPoint &srcSize, const SourceWindowFunc &fetchSource, bool gui = false, ResampleFilter filter = ResampleFilter::Linear);
 
 	//https://en.wikipedia.org/wiki/Cubic_Hermite_spline
 	inline constexpr float interpolateHermite(float p0, float p1, float m0, float m1, float t){
@@ -92,7 +126,7 @@ namespace JsonTerrainTools{
 	}
 
 	inline constexpr float interpolateCatmullRomUniform(const float* data, int32 idx0, int32 idx1, int32 idx2, int32 idx3, float t){
-		return interpolateCatmullRom(
+		return interpolateCatmullRomUniform(
 			data[idx0],
 			data[idx1],
 			data[idx2],
@@ -100,4 +134,17 @@ namespace JsonTerrainTools{
 			t
 		);
 	}
+
+	/*
+	Same curve as interpolateCatmullRomUniform, as weights of p0..p3. Resampling uses these,
+	since t is the same for a whole row or column.
+	*/
+	inline void catmullRomUniformWeights(float t, float* outWeights){
+		const float t2 = t*t;
+		const float t3 = t2*t;
+		outWeights[0] = 0.5f * (-t + 2.0f*t2 - t3);
+		outWeights[1] = 0.5f * (2.0f - 5.0f*t2 + 3.0f*t3);
+		outWeights[2] = 0.5f * (t + 4.0f*t2 - 3.0f*t3);
+		outWeights[3] = 0.5f * (-t2 + t3);
+	}
 }
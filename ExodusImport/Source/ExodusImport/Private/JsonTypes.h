@@ -28,6 +28,11 @@ using StringArray = TArray<FString>;
 using LinearColorArray = TArray<FLinearColor>;
 using MatrixArray = TArray<FMatrix>;
 
+//Read-only views. Data may live in a TArray or in a memory-mapped file.
+using FloatArrayView = TArrayView<const float>;
+using IntArrayView = TArrayView<const int32>;
+using ByteArrayView = TArrayView<const uint8>;
+
 enum class DesiredObjectType{
 	Default = 0,
 	Actor, Component
@@ -155,13 +155,22 @@ UMaterialInstanceConstant* MaterialBuilder::createMaterialInstance(const FString
 	auto matPath = FPaths::GetPath(pkgPath);
 
 	auto matFactory = makeFactoryRootGuard<UMaterialInstanceConstantFactoryNew>();
+	bool createdNew = false;
 	auto matInst = createAssetObject<UMaterialInstanceConstant>(pkgName, &matPath, importer, 
 		[&](UMaterialInstanceConstant* inst){
+			if (!createdNew){
+				//existing instance being rebuilt, new ones are configured by the factory below
+				inst->ClearParameterValuesEditorOnly();
+				inst->SetParentEditorOnly(baseMaterial);
+				if (postConfig)
+					postConfig(inst);
+			}
 			inst->PreEditChange(0);
 			inst->PostEditChange();
 			inst->MarkPackageDirty();
 		}, 
 		[&](UPackage* pkg, auto sanitizedName) -> auto{
+			createdNew = true;
 			matFactory->InitialParent = baseMaterial;
 			auto result = (UMaterialInstanceConstant*)matFactory->FactoryCreateNew(
 				UMaterialInstanceConstant::StaticClass(), pkg, 
@@ -174,7 +183,7 @@ UMaterialInstanceConstant* MaterialBuilder::createMaterialInstance(const FString
 				postConfig(result);
 
 			return result;
-		}, RF_Standalone|RF_Public
+		}, RF_Standalone|RF_Public, !(importer && importer->isRebuildingChangedAssets())
 	);
 	
 	if (!matInst){
@@ -10,9 +10,35 @@ class UMaterial;
 class UMaterialInterface;
 class JsonImporter;
 
+/*
+What the build phase of a static mesh needs, once json mesh itself is gone.
+*/
+struct StaticMeshBuildInfo{
+	int32 meshId = -1;
+	FString name;
+	bool convexCollider = false;
+	bool triangleCollider = false;
+
+	StaticMeshBuildInfo() = default;
+	StaticMeshBuildInfo(const JsonMesh &jsonMesh)
+	:meshId(jsonMesh.id.toIndex()), name(jsonMesh.name), 
+	convexCollider(jsonMesh.convexCollider), triangleCollider(jsonMesh.triangleCollider){
+	}
+};
+
 class MeshBuilder{
 public:
+	//fillStaticMesh + buildStaticMesh + setupStaticMeshCollision
 	void setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, std::function<void(TArray<FStaticMaterial> &meshMaterials)> materialSetup);
+	/*
+	Only writes raw mesh, materials and build settings. The mesh is not usable until it is built,
+	either with the two functions below or by StaticMeshBatchBuilder.
+	*/
+	void fillStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, std::function<void(TArray<FStaticMaterial> &meshMaterials)> materialSetup);
+	//Returns false and logs the errors if the build failed
+	static bool buildStaticMesh(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo);
+	static void logStaticMeshBuildErrors(const StaticMeshBuildInfo &buildInfo, const TArray<FText> &buildErrors);
+	static void setupStaticMeshCollision(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo);
 	void generateBillboardMesh(UStaticMesh *staticMesh, UMaterialInterface *billboardMaterial);
 	MeshBuilder() = default;
 protected:
@@ -4,7 +4,7 @@
 
 using namespace UnrealUtilities;
 
-void MeshBuilderUtils::processTangent(int originalIndex, const FloatArray &normFloats, const FloatArray &tangentFloats, bool hasNormals, bool hasTangents,
+void MeshBuilderUtils::processTangent(int originalIndex, FloatArrayView normFloats, FloatArrayView tangentFloats, bool hasNormals, bool hasTangents,
 		std::function<void(const FVector&)> normCallback, std::function<void(const FVector&, const FVector&)> tanCallback){
 	if (!hasNormals)
 		return;
@@ -93,9 +93,16 @@ void SkeletalMeshBuilder::setupReferenceSkeleton(FReferenceSkeleton &refSkeleton
 void SkeletalMeshBuildData::processWedgeData(const JsonMesh &jsonMesh){
 	const auto numTexCoords = jsonMesh.getNumTexCoords();
 
-	check(hasNormals == (jsonMesh.normals.Num() != 0));
-	check(hasTangents == (jsonMesh.tangents.Num() != 0));
-	check(hasColors == (jsonMesh.colors.Num() != 0));
+	const auto normalFloats = jsonMesh.getNormals();
+	const auto tangentFloats = jsonMesh.getTangents();
+	const auto colorBytes = jsonMesh.getColors();
+	check(hasNormals == (normalFloats.Num() != 0));
+	check(hasTangents == (tangentFloats.Num() != 0));
+	check(hasColors == (colorBytes.Num() != 0));
+
+	FloatArrayView uvFloats[MAX_TEXCOORDS];
+	for(int i = 0; i < MAX_TEXCOORDS; i++)
+		uvFloats[i] = jsonMesh.getUv(i);
 	/*
 	auto hasNormals = jsonMesh.normals.Num() != 0;
 	auto hasTangents = jsonMesh.tangents.Num() != 0;
@@ -103,8 +110,8 @@ void SkeletalMeshBuildData::processWedgeData(const JsonMesh &jsonMesh){
 	*/
 
 	for(int subMeshIndex = 0; subMeshIndex < jsonMesh.subMeshes.Num(); subMeshIndex++){
-		const auto &curSubMesh = jsonMesh.subMeshes[subMeshIndex];
-		for(int vertIndexOffset = 0; (vertIndexOffset + 2) < curSubMesh.triangles.Num(); vertIndexOffset += 3){
+		const auto trigs = jsonMesh.getTriangles(subMeshIndex);
+		for(int vertIndexOffset = 0; (vertIndexOffset + 2) < trigs.Num(); vertIndexOffset += 3){
 			auto& dstFace = meshFaces.AddDefaulted_GetRef();
 			dstFace.MeshMaterialIndex = subMeshIndex;
 			dstFace.SmoothingGroups = 0;
@@ -115,22 +122,22 @@ void SkeletalMeshBuildData::processWedgeData(const JsonMesh &jsonMesh){
 				auto curWedgeIndex = meshWedges.Num();
 
 				auto& dstWedge = meshWedges.AddDefaulted_GetRef();
-				auto srcVertIdx = curSubMesh.triangles[srcIdx];
+				auto srcVertIdx = trigs[srcIdx];
 				dstWedge.iVertex = srcVertIdx;
 
 				if (hasColors)
-					dstWedge.Color = getIdxColor(jsonMesh.colors, srcVertIdx);
+					dstWedge.Color = getIdxColor(colorBytes, srcVertIdx);
 
 				if (numTexCoords >= 1)
-					dstWedge.UVs[0] = unityUvToUnreal(getIdxVector2(jsonMesh.uv0, srcVertIdx));
+					dstWedge.UVs[0] = unityUvToUnreal(getIdxVector2(uvFloats[0], srcVertIdx));
 				if (numTexCoords >= 2)
-					dstWedge.UVs[1] = unityUvToUnreal(getIdxVector2(jsonMesh.uv1, srcVertIdx));
+					dstWedge.UVs[1] = unityUvToUnreal(getIdxVector2(uvFloats[1], srcVertIdx));
 				if (numTexCoords >= 3)
-					dstWedge.UVs[2] = unityUvToUnreal(getIdxVector2(jsonMesh.uv2, srcVertIdx));
+					dstWedge.UVs[2] = unityUvToUnreal(getIdxVector2(uvFloats[2], srcVertIdx));
 				if (numTexCoords >= 4)
-					dstWedge.UVs[3] = unityUvToUnreal(getIdxVector2(jsonMesh.uv3, srcVertIdx));
+					dstWedge.UVs[3] = unityUvToUnreal(getIdxVector2(uvFloats[3], srcVertIdx));
 
-				processTangent(srcVertIdx, jsonMesh.normals, jsonMesh.tangents, hasNormals, hasTangents, 
+				processTangent(srcVertIdx, normalFloats, tangentFloats, hasNormals, hasTangents, 
 					[&](const auto &norm){
 						dstFace.TangentZ[dstFaceIdx] = norm;
 					},
@@ -151,9 +158,9 @@ void SkeletalMeshBuildData::processWedgeData(const JsonMesh &jsonMesh){
 }
 
 void SkeletalMeshBuildData::startWithMesh(const JsonMesh &jsonMesh){
-	hasNormals = jsonMesh.normals.Num() != 0;
-	hasTangents = jsonMesh.tangents.Num() != 0;
-	hasColors = jsonMesh.colors.Num() != 0;
+	hasNormals = jsonMesh.hasNormals();
+	hasTangents = jsonMesh.hasTangents();
+	hasColors = jsonMesh.hasColors();
 }
 
 void SkeletalMeshBuildData::buildSkeletalMesh(FSkeletalMeshLODModel &lodModel, const FReferenceSkeleton &refSkeleton, const JsonMesh &jsonMesh){
@@ -212,96 +219,137 @@ void SkeletalMeshBuildData::computeBoundingBox(USkeletalMesh *skelMesh, const Js
 	skelMesh->SetImportedBounds(FBoxSphereBounds(boundBox));
 }
 
-struct SkeletalMeshInfluence{
-	int boneIndex = 0;
-	float weight = 0.0f;
-	int intWeight = 0;
-	void recomputeInt(){
-		intWeight = (int)(255.0f * weight);
-	}
-	void recomputeFloat(){
-		weight = ((float)intWeight)/255.0f;
-	}
-	SkeletalMeshInfluence() = default;
-	SkeletalMeshInfluence(int boneIndex_, float weight_)
-	:boneIndex(boneIndex_), weight(weight_){
-		intWeight = (int)(weight * 255.0f);//truncate
-	}
-};
-
-using SkeletalMeshInfluenceArray = TArray<SkeletalMeshInfluence>;
-using BoneInfluenceMap = TMap<int, SkeletalMeshInfluenceArray>;
-
-float getTotalWeight(const SkeletalMeshInfluenceArray &arr){
-	float result = 0.0f;
-	for(const auto &cur: arr){
-		result += cur.weight;
-	}
-	return result;
-}
+/*
+Skin influences of the whole mesh, in flat arrays with fixed stride of maxInfluencesPerVertex per vertex.
 
-int getTotalIntWeight(const SkeletalMeshInfluenceArray &arr){
-	int result = 0;
-	for(const auto &cur: arr){
-		result += cur.intWeight;
-	}
-	return result;
-}
+Slots of each vertex are kept sorted from strongest to weakest as influences are added,
+so top-N selection happens on insertion and nothing is allocated per vertex.
+*/
+struct SkinInfluenceBuffer{
+	static const int32 maxInfluencesPerVertex = 8;
+
+	int32 numVerts = 0;
+	TArray<int32> bones;
+	TArray<float> weights;
+	TArray<uint8> quantized;
+	TArray<uint8> counts;
+
+	void reset(int32 numVerts_){
+		numVerts = numVerts_;
+		const int32 numSlots = numVerts * maxInfluencesPerVertex;
+		bones.SetNumUninitialized(numSlots);
+		weights.SetNumZeroed(numSlots);
+		quantized.SetNumZeroed(numSlots);
+		counts.SetNumZeroed(numVerts);
+	}
+
+	void add(int32 vertIndex, int32 boneIndex, float weight){
+		const int32 base = vertIndex * maxInfluencesPerVertex;
+		int32 *vertBones = bones.GetData() + base;
+		float *vertWeights = weights.GetData() + base;
+		int32 count = counts[vertIndex];
+
+		//The same bone can show up twice when several mesh bones were remapped onto one skeleton bone.
+		int32 slot = INDEX_NONE;
+		for(int32 i = 0; i < count; i++){
+			if (vertBones[i] == boneIndex){
+				slot = i;
+				weight += vertWeights[i];
+				break;
+			}
+		}
+		if (slot == INDEX_NONE){
+			if (count < maxInfluencesPerVertex){
+				slot = count++;
+				counts[vertIndex] = (uint8)count;
+			}
+			else if (weight > vertWeights[count - 1]){
+				slot = count - 1;//weakest one goes away
+			}
+			else
+				return;
+		}
 
-void printBoneInfluenceMap(const BoneInfluenceMap &boneInfluences){
-	for(auto &cur: boneInfluences){
-		UE_LOG(JsonLog, Log, TEXT("Influence for vert %d: %f (%d)"), cur.Key, getTotalWeight(cur.Value), getTotalIntWeight(cur.Value));
-		for(int i = 0; i < cur.Value.Num(); i++){
-			UE_LOG(JsonLog, Log, TEXT("Influence %d/%d: %f (%d)"), i, cur.Value.Num(), cur.Value[i].weight, cur.Value[i].intWeight);
+		//bubble towards the front so slots stay sorted by weight
+		for(; (slot > 0) && (vertWeights[slot - 1] < weight); slot--){
+			vertBones[slot] = vertBones[slot - 1];
+			vertWeights[slot] = vertWeights[slot - 1];
 		}
+		vertBones[slot] = boneIndex;
+		vertWeights[slot] = weight;
 	}
-}
 
-void normalizeInfluenceMap(BoneInfluenceMap &boneInfluences){
-	for(auto &cur: boneInfluences){
-		if (cur.Value.Num() == 0)
-			continue;
-
-		for(auto &infl: cur.Value){
-			infl.weight = FMath::Clamp(infl.weight, 0.0f, 1.0f);
-			infl.recomputeInt();
-		}
+	/*
+	Normalizes weights of every vertex and quantizes them to bytes which add up to exactly 255.
+	Truncated values are topped up by the largest remainder, so the result is as close to the float weights as bytes allow.
+	*/
+	void normalizeAndQuantize(){
+		for(int32 vertIndex = 0; vertIndex < numVerts; vertIndex++){
+			const int32 count = counts[vertIndex];
+			if (count == 0)
+				continue;
+			const int32 base = vertIndex * maxInfluencesPerVertex;
+			float *vertWeights = weights.GetData() + base;
+			uint8 *vertQuantized = quantized.GetData() + base;
+
+			float total = 0.0f;
+			for(int32 i = 0; i < maxInfluencesPerVertex; i++)
+				total += vertWeights[i];//unused slots are zero
+
+			const float scale = (total > 0.0f) ? 255.0f/total: 0.0f;
+			float remainders[maxInfluencesPerVertex];
+			int32 intTotal = 0;
+			for(int32 i = 0; i < maxInfluencesPerVertex; i++){
+				const float scaled = vertWeights[i] * scale;
+				const float truncated = FMath::FloorToFloat(scaled);
+				remainders[i] = scaled - truncated;
+				vertQuantized[i] = (uint8)truncated;
+				intTotal += (int32)truncated;
+			}
 
-		float totalFloat = getTotalWeight(cur.Value);
-		if ((totalFloat > 1.0f) && (totalFloat != 0.0f)){
-			float scale = 1.0f/totalFloat;
-			for(auto &infl: cur.Value){
-				infl.weight *= scale;
-				infl.recomputeInt();
+			if (total <= 0.0f){
+				vertQuantized[0] = 255;
+				intTotal = 255;
 			}
-		}
 
-		int totalInt = getTotalIntWeight(cur.Value);
-		check((totalInt >= 0) && (totalInt <= 255));//This shouldn't fire at this point, but you never know.
+			for(int32 extra = 255 - intTotal; extra > 0; extra--){
+				int32 best = 0;
+				for(int32 i = 1; i < count; i++){
+					if (remainders[i] > remainders[best])
+						best = i;
+				}
+				vertQuantized[best]++;
+				remainders[best] = -1.0f;
+			}
 
-		auto extra = 255 - totalInt;
-		if (extra > 0){
-			auto& largest = cur.Value[0];
-			largest.intWeight += extra;
-			largest.recomputeFloat();
+			for(int32 i = 0; i < maxInfluencesPerVertex; i++)
+				vertWeights[i] = (float)vertQuantized[i] / 255.0f;
 		}
+	}
 
-		for(auto &infl: cur.Value){
-			infl.recomputeFloat();
-		}
+	int32 getTotalInfluences() const{
+		int32 result = 0;
+		for(auto cur: counts)
+			result += cur;
+		return result;
 	}
-}
+};
 
 //#define EXODUS_SKELETAL_MESH_SKIN_LOGGING
 
 void SkeletalMeshBuildData::processPositionsAndWeights(const JsonMesh &jsonMesh, const TMap<int, int> &meshToSkeletonBoneMap, StringArray &remapErrors){
 	const int jsonInfluencesPerVertex = 4;
 
-	bool hasBones = jsonMesh.boneIndexes.Num() > 0;
+	const auto vertFloats = jsonMesh.getVerts();
+	const auto boneIndexes = jsonMesh.getBoneIndexes();
+	const auto boneWeights = jsonMesh.getBoneWeights();
+	bool hasBones = boneIndexes.Num() > 0;
 
 	//vertices themselves
+	meshPoints.Reserve(meshPoints.Num() + jsonMesh.vertexCount);
+	pointToOriginalMap.Reserve(pointToOriginalMap.Num() + jsonMesh.vertexCount);
 	for(int vertIndex = 0; vertIndex < jsonMesh.vertexCount; vertIndex++){
-		auto srcVert = getIdxVector3(jsonMesh.verts, vertIndex);
+		auto srcVert = getIdxVector3(vertFloats, vertIndex);
 		meshPoints.Add(unityPosToUe(srcVert));
 		pointToOriginalMap.Add(vertIndex);
 	}
@@ -309,30 +357,38 @@ void SkeletalMeshBuildData::processPositionsAndWeights(const JsonMesh &jsonMesh,
 	/*
 	the mapping to uint8 for bone weights is troublesome.
 	*/
-	TMap<int, SkeletalMeshInfluenceArray> boneInfluences;
+	SkinInfluenceBuffer influences;
+	influences.reset(jsonMesh.vertexCount);
 	if (hasBones){
+		//Bone remap is looked up once per mesh bone rather than once per influence
+		int32 maxMeshBone = -1;
+		for(int32 i = 0; i < boneIndexes.Num(); i++)
+			maxMeshBone = FMath::Max(maxMeshBone, (int32)boneIndexes[i]);
+		TArray<int32> boneRemap;
+		boneRemap.SetNumUninitialized(maxMeshBone + 1);
+		for(int32 meshBoneIdx = 0; meshBoneIdx <= maxMeshBone; meshBoneIdx++){
+			auto foundIdx = meshToSkeletonBoneMap.Find(meshBoneIdx);
+			boneRemap[meshBoneIdx] = foundIdx ? *foundIdx: INDEX_NONE;
+		}
+
 		for(int vertIndex = 0; vertIndex < jsonMesh.vertexCount; vertIndex++){
 			for(int inflIndex = 0; inflIndex < jsonInfluencesPerVertex; inflIndex++){
 				auto dataOffset = inflIndex + vertIndex * jsonInfluencesPerVertex;
-				auto meshBoneIdx = jsonMesh.boneIndexes[dataOffset]; 
-				auto boneWeight = jsonMesh.boneWeights[dataOffset];
+				auto meshBoneIdx = boneIndexes[dataOffset]; 
+				auto boneWeight = boneWeights[dataOffset];
 				//There actually ARE negative weight somewhere, andd they cause mesh spikes.
-				if (boneWeight <= 0.0f)
+				if ((boneWeight <= 0.0f) || (meshBoneIdx < 0))
 					continue;
 
-				auto skelBoneIdx = meshBoneIdx;
-				auto foundIdx = meshToSkeletonBoneMap.Find(meshBoneIdx);
-				if (!foundIdx){
+				auto skelBoneIdx = boneRemap[meshBoneIdx];
+				if (skelBoneIdx == INDEX_NONE){
 					remapErrors.Add(
 						FString::Printf(TEXT("Could not remap mesh bone index %d in vertex influence, errors are possible"),
 							meshBoneIdx));
-				}
-				else{
-					skelBoneIdx = *foundIdx;
+					skelBoneIdx = meshBoneIdx;
 				}
 
-				SkeletalMeshInfluence tmpInfluence(skelBoneIdx, boneWeight);
-				boneInfluences.FindOrAdd(vertIndex).Add(tmpInfluence);
+				influences.add(vertIndex, skelBoneIdx, FMath::Min(boneWeight, 1.0f));
 			}
 		}
 	}
@@ -352,100 +408,46 @@ void SkeletalMeshBuildData::processPositionsAndWeights(const JsonMesh &jsonMesh,
 			remappedIndex = *foundIdx;
 		}
 		for(int vertIndex = 0; vertIndex < jsonMesh.vertexCount; vertIndex++){
-			SkeletalMeshInfluence tmpInfluence(remappedIndex, 1.0f);
-			boneInfluences.FindOrAdd(vertIndex).Add(tmpInfluence);
+			influences.add(vertIndex, remappedIndex, 1.0f);
 		}
 	}
 
-#ifdef EXODUS_SKELETAL_MESH_SKIN_LOGGING
-	UE_LOG(JsonLog, Log, TEXT("Pre-sort bone influences on %s(%d)"), *jsonMesh.name, jsonMesh.id);
-	printBoneInfluenceMap(boneInfluences);
-#endif
-
-	//Sorting the influences from strongest to weakest
-	for(auto &cur: boneInfluences){
-		Algo::SortBy(cur.Value, [](const SkeletalMeshInfluence &arg){return -arg.weight;});
-	}
-
-#ifdef EXODUS_SKELETAL_MESH_SKIN_LOGGING
-	UE_LOG(JsonLog, Log, TEXT("Post-sort bone influences on %s(%d)"), *jsonMesh.name, jsonMesh.id);
-	printBoneInfluenceMap(boneInfluences);
-#endif
-
-	normalizeInfluenceMap(boneInfluences);
-
-#ifdef EXODUS_SKELETAL_MESH_SKIN_LOGGING
-	UE_LOG(JsonLog, Log, TEXT("Post-normalization bone influences on %s(%d)"), *jsonMesh.name, jsonMesh.id);
-	printBoneInfluenceMap(boneInfluences);
-#endif
+	influences.normalizeAndQuantize();
 
-	for(const auto &cur: boneInfluences){
-		float total = 0.0f;
-		for(const auto &infl: cur.Value){
+	meshInfluences.Reserve(meshInfluences.Num() + influences.getTotalInfluences());
+	for(int vertIndex = 0; vertIndex < jsonMesh.vertexCount; vertIndex++){
+		const int32 base = vertIndex * SkinInfluenceBuffer::maxInfluencesPerVertex;
+		const int32 count = influences.counts[vertIndex];
+		for(int32 i = 0; i < count; i++){
 			auto &dstInfl = meshInfluences.AddDefaulted_GetRef();
-			dstInfl.VertIndex = cur.Key;
-			dstInfl.BoneIndex = infl.boneIndex;//meshBoneIdx;
-			dstInfl.Weight = infl.weight;// * 2.0f;
-			total += infl.weight;
-
-			if (total >= 256.0f/255.0f){
-				UE_LOG(JsonLog, Log, TEXT("Total overflow: %f on vertex %d"), total, dstInfl.VertIndex);
-			}
+			dstInfl.VertIndex = vertIndex;
+			dstInfl.BoneIndex = influences.bones[base + i];
+			dstInfl.Weight = influences.weights[base + i];
 		}
 	}
 
 #ifdef EXODUS_SKELETAL_MESH_SKIN_LOGGING
-	for(auto& cur: boneInfluences){
-		auto &influences = cur.Value;
-		
-		auto totalInt = getTotalIntWeight(influences);
-		auto totalFloat = getTotalWeight(influences);
-		if (totalFloat != 1.0f){
-			UE_LOG(JsonLog, Warning, TEXT("Invalid total bone on vertex %d, mesh %s (%d), value %f"),
-				cur.Key, *jsonMesh.name, jsonMesh.id, totalFloat);
-		}
-		if (totalInt != 255){
-			UE_LOG(JsonLog, Warning, TEXT("Invalid total int bone on vertex %d, mesh %s (%d), value %d"),
-				cur.Key, *jsonMesh.name, jsonMesh.id, totalInt);
-			if (totalInt > 255){
-				UE_LOG(JsonLog, Warning, TEXT("Value is too large and will result in wraparound!"));
-			}
-		}
-	}
-
-	for(const auto &cur: summaryIntWeightMap){
-		if ((cur.Value > 255) || (cur.Value < 0)){
-			UE_LOG(JsonLog, Warning, TEXT("Invalid total int weight %d on vertex %d, mesh %s (%d)"),
-				cur.Value, cur.Key, *jsonMesh.name, jsonMesh.id)
-		}
-	}
-
 	for(int vertIndex = 0; vertIndex < jsonMesh.vertexCount; vertIndex++){
-		if (!summaryWeightMap.Contains(vertIndex)){
-			UE_LOG(JsonLog, Warning, TEXT("Unbound skin vertex %d on mesh %s(%d)"), vertIndex, *jsonMesh.name, jsonMesh.id);
+		const int32 base = vertIndex * SkinInfluenceBuffer::maxInfluencesPerVertex;
+		const int32 count = influences.counts[vertIndex];
+		if (count == 0){
+			UE_LOG(JsonLog, Warning, TEXT("Unbound skin vertex %d on mesh %s(%d)"), vertIndex, *jsonMesh.name, (int)jsonMesh.id);
+			continue;
 		}
-	}
-
-	for(const auto &cur: summaryWeightMap){
-		auto &curIndexes = cur.Value;
-		for(const auto influeneIndexes: curIndexes){
+		int32 totalInt = 0;
+		for(int32 i = 0; i < count; i++){
+			UE_LOG(JsonLog, Log, TEXT("Vertex %d influence %d/%d: bone %d, %f (%d)"), 
+				vertIndex, i, count, influences.bones[base + i], influences.weights[base + i], (int)influences.quantized[base + i]);
+			totalInt += influences.quantized[base + i];
 		}
-	}
-
-	for(const auto &cur: summaryWeightMap){
-		if (cur.Value > 1.0f){
-			UE_LOG(JsonLog, Warning, TEXT("Bone weight value %f is too high on vertex %d, mesh %s (%d)"),
-				cur.Value, cur.Key, *jsonMesh.name, jsonMesh.id)
-		}
-		if (cur.Value < 1.0f){
-			UE_LOG(JsonLog, Warning, TEXT("Bone weight value %f is too low on vertex %d, mesh %s (%d)"),
-				cur.Value, cur.Key, *jsonMesh.name, jsonMesh.id)
+		if (totalInt != 255){
+			UE_LOG(JsonLog, Warning, TEXT("Invalid total int weight %d on vertex %d, mesh %s (%d)"),
+				totalInt, vertIndex, *jsonMesh.name, (int)jsonMesh.id);
 		}
 	}
 #endif
 }
 
-
 void SkeletalMeshBuilder::registerPreviewMesh(USkeleton *skel, USkeletalMesh *mesh, const JsonMesh &jsonMesh){
 	check(skel);
 	check(mesh);
@@ -503,11 +505,17 @@ void SkeletalMeshBuilder::registerPreviewMesh(USkeleton *skel, USkeletalMesh *me
 	Amusingly, the most useful file in figuring out how skeletal mesh configuraiton is supposed to work 
 */
 void SkeletalMeshBuilder::setupSkeletalMesh(USkeletalMesh *skelMesh, const JsonMesh &jsonMesh, const JsonImporter *importer, std::function<void(TArray<FSkeletalMaterial> &meshMaterials)> materialSetup, std::function<void(const JsonSkeleton&, USkeleton*)> onNewSkeleton){
+	EXODUS_IMPORT_SCOPE(SkeletalMesh);
 	check(skelMesh);
 	check(importer);
 	
 	auto importModel = skelMesh->GetImportedModel();
-	check(importModel->LODModels.Num() == 0);
+	if (importModel->LODModels.Num() > 0){
+		//Rebuilding an existing mesh, old render data and morphs have to go.
+		skelMesh->ReleaseResources();
+		FlushRenderingCommands();
+		skelMesh->UnregisterAllMorphTarget();
+	}
 	importModel->LODModels.Empty();
 
 //#if (ENGINE_MAJOR_VERSION >= 4) && (ENGINE_MINOR_VERSION >= 22)
@@ -520,9 +528,9 @@ void SkeletalMeshBuilder::setupSkeletalMesh(USkeletalMesh *skelMesh, const JsonM
 	//I suppose it does same thing as calling new and then Add()
 	auto &lodModel = importModel->LODModels[0];
 
-	auto hasNormals = jsonMesh.normals.Num() != 0;
-	skelMesh->SetHasVertexColors(jsonMesh.colors.Num() != 0);
-	auto hasTangents = jsonMesh.tangents.Num() != 0;
+	auto hasNormals = jsonMesh.hasNormals();
+	skelMesh->SetHasVertexColors(jsonMesh.hasColors());
+	auto hasTangents = jsonMesh.hasTangents();
 
 //#if !((ENGINE_MAJOR_VERSION >= 4) && (ENGINE_MINOR_VERSION >= 24))
 #ifndef EXODUS_UE_VER_4_24_GE
@@ -602,7 +610,7 @@ void SkeletalMeshBuilder::setupSkeletalMesh(USkeletalMesh *skelMesh, const JsonM
 			skelName, &desiredDir, importer, 
 			[&](auto arg){
 				arg->MergeAllBonesToBoneTree(skelMesh);
-			}, RF_Standalone|RF_Public
+			}, nullptr, RF_Standalone|RF_Public, !importer->isRebuildingChangedAssets()
 		);
 		if (onNewSkeleton)
 			onNewSkeleton(*jsonSkel, skeleton);
@@ -630,57 +638,83 @@ void SkeletalMeshBuilder::setupSkeletalMesh(USkeletalMesh *skelMesh, const JsonM
 	skelMesh->PostLoad();
 }
 
+/*
+Unity blend shape frames become morph targets. Only vertices that actually move are stored,
+so a facial shape costs as much as the face, not the whole body.
+
+Unreal morphs have no in-between frames, a morph is a single delta scaled linearly by its curve.
+Only the last frame (full weight) is imported, under the blend shape name, so curves referencing the shape find it.
+In-between frames are skipped: as separate targets nothing would ever drive them.
+*/
 void SkeletalMeshBuildData::processBlendShapes(USkeletalMesh *skelMesh, const JsonMesh &jsonMesh){
+	if (jsonMesh.blendShapes.Num() == 0)
+		return;
+
 	bool needMorphInvalidate = false;
 
+	auto importData = skelMesh->GetImportedModel();
+	const auto &lodModel = importData->LODModels[0];//TODO:  lod support.
+	const float posThresholdSq = FMath::Square(morphPositionThreshold);
+	const float normThresholdSq = FMath::Square(morphNormalThreshold);
+
+	int32 numTotalDeltas = 0;
+	int32 numTotalMorphs = 0;
+	TArray<FMorphTargetDelta> deltas;
 	for(int blendShapeIndex = 0; blendShapeIndex < jsonMesh.blendShapes.Num(); blendShapeIndex++){
-		UE_LOG(JsonLog, Log, TEXT("Processing blend shape %d out of %d"), blendShapeIndex, jsonMesh.blendShapes.Num());
 		const auto &curBlendShape = jsonMesh.blendShapes[blendShapeIndex];
-		for(int blendFrameIndex = 0; blendFrameIndex < curBlendShape.frames.Num(); blendFrameIndex++){
-			auto morphName = FString::Printf(TEXT("%s_%s_s%d_f%d"), 
-				*jsonMesh.name, *curBlendShape.name, blendShapeIndex, blendFrameIndex);
-
-			const auto &blendFrame = curBlendShape.frames[blendFrameIndex];
-
-			auto morphTarget = NewObject<UMorphTarget>(skelMesh->GetOuter(), *morphName);
-			FAssetRegistryModule::AssetCreated(morphTarget);
-			morphTargets.Add(morphTarget);
-
-			TArray<FMorphTargetDelta> deltas;
-
-			auto importData = skelMesh->GetImportedModel();
-			const auto &lodModel = importData->LODModels[0];//TODO:  lod support.
-
-			FString modelData;
+		if (curBlendShape.frames.Num() == 0)
+			continue;
+		const int blendFrameIndex = curBlendShape.frames.Num() - 1;
+		if (blendFrameIndex > 0){
+			UE_LOG(JsonLog, Warning, TEXT("Blend shape %s (%d) of mesh %s has %d in-between frames, they are not imported"),
+				*curBlendShape.name, blendShapeIndex, *jsonMesh.name, blendFrameIndex);
+		}
 
-			//UE_LOG(JsonLog, Log, TEXT("Dumping model: %s"), *modelData);
+		const auto &blendFrame = curBlendShape.frames[blendFrameIndex];
+		const bool hasDeltaNormals = blendFrame.deltaNormals.Num() > 0;
 
-			for(int meshVertIdx = 0; meshVertIdx < lodModel.MeshToImportVertexMap.Num(); meshVertIdx++){
-				auto origVertIdx = lodModel.MeshToImportVertexMap[meshVertIdx];
+		deltas.Reset();
+		//Mesh morph references the NEW (render) verts, and not the original ones.
+		for(int meshVertIdx = 0; meshVertIdx < lodModel.MeshToImportVertexMap.Num(); meshVertIdx++){
+			auto pointIdx = lodModel.MeshToImportVertexMap[meshVertIdx];
+			if (!pointToOriginalMap.IsValidIndex(pointIdx))
+				continue;
+			auto origVertIdx = pointToOriginalMap[pointIdx];
 
-				auto& dstDelta = deltas.AddDefaulted_GetRef();
-				dstDelta.SourceIdx = meshVertIdx;//Aaand nope. That was some stupid error. Mesh morph references the NEW verts, and not the original one...
-				auto unityDeltaPos = getIdxVector3(blendFrame.deltaVerts, origVertIdx);
-				auto unityDeltaNorm = getIdxVector3(blendFrame.deltaNormals, origVertIdx);
+			auto posDelta = unityPosToUe(getIdxVector3(blendFrame.deltaVerts, origVertIdx));
+			auto normDelta = hasDeltaNormals ? unityVecToUe(getIdxVector3(blendFrame.deltaNormals, origVertIdx)): FVector::ZeroVector;
+			if ((posDelta.SizeSquared() <= posThresholdSq) && (normDelta.SizeSquared() <= normThresholdSq))
+				continue;
 
-				dstDelta.PositionDelta = unityPosToUe(unityDeltaPos);
-				dstDelta.TangentZDelta = unityVecToUe(unityDeltaNorm);
-			}
-			//lodModel.MeshToImportVertexMap
-			//UE_LOG(JsonLog, Log, TEXT("Printing original vertices. Total number: %d"), lodModel.RawPointIndices.Nu
+			auto& dstDelta = deltas.AddDefaulted_GetRef();
+			dstDelta.SourceIdx = meshVertIdx;
+			dstDelta.PositionDelta = posDelta;
+			dstDelta.TangentZDelta = normDelta;
+		}
 
-			morphTarget->PopulateDeltas(deltas, 0, lodModel.Sections);
+		if (deltas.Num() == 0){
+			UE_LOG(JsonLog, Log, TEXT("Blend shape %s (%d) of mesh %s moves nothing, skipped"),
+				*curBlendShape.name, blendShapeIndex, *jsonMesh.name);
+			continue;
+		}
 
-			morphTarget->MarkPackageDirty();
+		auto morphTarget = NewObject<UMorphTarget>(skelMesh, *curBlendShape.name);
+		morphTargets.Add(morphTarget);
+		morphTarget->PopulateDeltas(deltas, 0, lodModel.Sections);
 
-			auto registrationResult = skelMesh->RegisterMorphTarget(morphTarget);
-			needMorphInvalidate = needMorphInvalidate | registrationResult;
-			UE_LOG(JsonLog, Log, TEXT("Registration result: %d. Target %s (%d), frame %d"),
-				(int)registrationResult, *curBlendShape.name, blendShapeIndex, blendFrameIndex);
-		}
+		auto registrationResult = skelMesh->RegisterMorphTarget(morphTarget);
+		needMorphInvalidate = needMorphInvalidate | registrationResult;
+		numTotalDeltas += deltas.Num();
+		numTotalMorphs++;
+		UE_LOG(JsonLog, Log, TEXT("Registration result: %d. Target %s (%d), frame %d, %d of %d vertices"),
+			(int)registrationResult, *curBlendShape.name, blendShapeIndex, blendFrameIndex, 
+			deltas.Num(), lodModel.MeshToImportVertexMap.Num());
 	}
+	UE_LOG(JsonLog, Log, TEXT("Mesh %s: %d morph targets, %d deltas total (%d per morph if dense)"),
+		*jsonMesh.name, numTotalMorphs, numTotalDeltas, lodModel.MeshToImportVertexMap.Num());
 
 	if (needMorphInvalidate){
+		skelMesh->MarkPackageDirty();
 		skelMesh->InitMorphTargetsAndRebuildRenderData();
 	}
 }
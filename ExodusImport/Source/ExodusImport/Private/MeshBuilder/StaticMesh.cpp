@@ -7,8 +7,16 @@
 #include "PhysicsEngine/BodySetup.h"
 
 void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, std::function<void(TArray<FStaticMaterial> &meshMaterial)> materialSetup){
+	fillStaticMesh(mesh, jsonMesh, materialSetup);
+	StaticMeshBuildInfo buildInfo(jsonMesh);
+	if (buildStaticMesh(mesh, buildInfo))
+		setupStaticMeshCollision(mesh, buildInfo);
+}
+
+void MeshBuilder::fillStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, std::function<void(TArray<FStaticMaterial> &meshMaterial)> materialSetup){
 	using namespace UnrealUtilities;
 	using namespace MeshBuilderUtils;
+	EXODUS_IMPORT_SCOPE(StaticMesh);
 
 	check(mesh);
 
@@ -36,34 +44,36 @@ void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, s
 	srcModel.RawMeshBulkData->LoadRawMesh(newRawMesh);
 	newRawMesh.VertexPositions.SetNum(0);
 
-	UE_LOG(JsonLog, Log, TEXT("Num normal floats: %d"), jsonMesh.verts.Num());
-	bool hasNormals = jsonMesh.normals.Num() != 0;
+	const auto vertFloats = jsonMesh.getVerts();
+	const auto normalFloats = jsonMesh.getNormals();
+	const auto tangentFloats = jsonMesh.getTangents();
+	const auto colorBytes = jsonMesh.getColors();
+
+	UE_LOG(JsonLog, Log, TEXT("Num normal floats: %d"), normalFloats.Num());
+	bool hasNormals = normalFloats.Num() != 0;
 	UE_LOG(JsonLog, Log, TEXT("has normals: %d"), (int)hasNormals);
-	bool hasColors = jsonMesh.colors.Num() > 0;
-	bool hasTangents = jsonMesh.tangents.Num() != 0;
+	bool hasColors = colorBytes.Num() > 0;
+	bool hasTangents = tangentFloats.Num() != 0;
 	UE_LOG(JsonLog, Log, TEXT("hasColors: %d; hasTangents: %d"), (int)hasColors, (int)hasNormals);
 
 	{//why?
 		UE_LOG(JsonLog, Log, TEXT("Generating mesh"));
-		UE_LOG(JsonLog, Log, TEXT("Num vert floats: %d"), jsonMesh.verts.Num());//vertFloats.Num());
-		for(int i = 0; (i + 2) < jsonMesh.verts.Num(); i += 3){
-			FVector unityPos(jsonMesh.verts[i], jsonMesh.verts[i+1], jsonMesh.verts[i+2]);
+		UE_LOG(JsonLog, Log, TEXT("Num vert floats: %d"), vertFloats.Num());
+		newRawMesh.VertexPositions.Reserve(vertFloats.Num() / 3);
+		for(int i = 0; (i + 2) < vertFloats.Num(); i += 3){
+			FVector unityPos(vertFloats[i], vertFloats[i+1], vertFloats[i+2]);
 			newRawMesh.VertexPositions.Add(unityPosToUe(unityPos));
 		}
 		UE_LOG(JsonLog, Log, TEXT("Num verts: %d"), newRawMesh.VertexPositions.Num());
 
-		//const auto &normalFloats = jsonMesh.normals;
-
 		const int32 maxUvs = 8;
-		const TArray<float>* uvFloats[maxUvs] = {
-			&jsonMesh.uv0, &jsonMesh.uv1, &jsonMesh.uv2, &jsonMesh.uv3, 
-			&jsonMesh.uv4, &jsonMesh.uv5, &jsonMesh.uv6, &jsonMesh.uv7
-		};
+		FloatArrayView uvFloats[maxUvs];
 
 		bool hasUvs[maxUvs];
 		for(int32 i = 0; i < maxUvs; i++){
-			hasUvs[i] = uvFloats[i]->Num() != 0;
-			UE_LOG(JsonLog, Log, TEXT("Uv floats[%d]: %d, hasUvs: %d"), i, uvFloats[i]->Num(), (int)hasUvs[i]);
+			uvFloats[i] = jsonMesh.getUv(i);
+			hasUvs[i] = uvFloats[i].Num() != 0;
+			UE_LOG(JsonLog, Log, TEXT("Uv floats[%d]: %d, hasUvs: %d"), i, uvFloats[i].Num(), (int)hasUvs[i]);
 		}
 
 		if (!hasUvs[0]){
@@ -87,16 +97,14 @@ void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, s
 			int32 nextMatIndex = 0;
 
 			for(int subMeshIndex = 0; subMeshIndex < jsonMesh.subMeshes.Num(); subMeshIndex++){
-				const auto& curSubMesh = jsonMesh.subMeshes[subMeshIndex];
-
-				const auto& trigs = curSubMesh.triangles;
+				const auto trigs = jsonMesh.getTriangles(subMeshIndex);
 				UE_LOG(JsonLog, Log, TEXT("Num triangle verts %d"), trigs.Num());
 
 				auto processTriangleIndex = [&](int32 trigVertIdx){
 					auto origIndex = trigs[trigVertIdx];
 					newRawMesh.WedgeIndices.Add(origIndex);
 
-					processTangent(origIndex, jsonMesh.normals, jsonMesh.tangents, hasNormals, hasTangents, 
+					processTangent(origIndex, normalFloats, tangentFloats, hasNormals, hasTangents, 
 						[&](const auto& norm){
 							newRawMesh.WedgeTangentZ.Add(norm);
 						},
@@ -110,23 +118,23 @@ void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, s
 						if (!hasUvs[uvIndex]){
 							if (uvIndex != 0)
 								continue;
-							auto tmpPos = getIdxVector3(jsonMesh.verts, origIndex);
+							auto tmpPos = getIdxVector3(vertFloats, origIndex);
 							FVector2D tmpUv(tmpPos.X, tmpPos.Y);
 							newRawMesh.WedgeTexCoords[uvIndex].Add(tmpUv);
 							continue;
 						}
 
-						auto tmpUv = getIdxVector2(*uvFloats[uvIndex], origIndex);
+						auto tmpUv = getIdxVector2(uvFloats[uvIndex], origIndex);
 						tmpUv.Y = 1.0f - tmpUv.Y;
 						newRawMesh.WedgeTexCoords[uvIndex].Add(tmpUv);
 					}
 
 					if (hasColors){
 						FColor col32(
-							jsonMesh.colors[origIndex * 4], 
-							jsonMesh.colors[origIndex * 4 + 1], 
-							jsonMesh.colors[origIndex * 4 + 2], 
-							jsonMesh.colors[origIndex * 4 + 3]
+							colorBytes[origIndex * 4], 
+							colorBytes[origIndex * 4 + 1], 
+							colorBytes[origIndex * 4 + 2], 
+							colorBytes[origIndex * 4 + 3]
 						);
 
 						//srgb conversion, though?
@@ -178,23 +186,42 @@ void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, s
 	srcModel.BuildSettings.bRecomputeNormals = false;//!hasNormals; //Why??
 	srcModel.BuildSettings.bRecomputeTangents = !(hasTangents && hasNormals);//true;
 
+//#if (ENGINE_MAJOR_VERSION >= 4) && (ENGINE_MINOR_VERSION >= 22)
+#ifdef EXODUS_UE_VER_4_22_GE
+	srcModel.StaticMeshOwner = mesh;
+#endif
+}
+
+void MeshBuilder::logStaticMeshBuildErrors(const StaticMeshBuildInfo &buildInfo, const TArray<FText> &buildErrors){
+	if (buildErrors.Num() == 0)
+		return;
+	FString errMsg;
+	for (const FText& err : buildErrors){
+		errMsg += FString::Printf(TEXT("MeshBuildError: %s"), *(err.ToString()));
+		//UE_LOG(JsonLog, Error, TEXT("MeshBuildError: %s"), *(err.ToString()));
+	}
+	UE_LOG(JsonLog, Warning, TEXT("Build errors while loading mesh %d(\"%s\"):\n%s"), buildInfo.meshId, *buildInfo.name, *errMsg);
+}
+
+bool MeshBuilder::buildStaticMesh(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo){
+	EXODUS_IMPORT_SCOPE(StaticMesh);
+	check(mesh);
 	TArray<FText> buildErrors;
 	mesh->Build(false, &buildErrors);
-	if (buildErrors.Num() > 0){
-		FString errMsg;
-		for (FText& err : buildErrors){
-			errMsg += FString::Printf(TEXT("MeshBuildError: %s"), *(err.ToString()));
-			//UE_LOG(JsonLog, Error, TEXT("MeshBuildError: %s"), *(err.ToString()));
-		}
-		UE_LOG(JsonLog, Warning, TEXT("Build errors while loading mesh %d(\"%s\"):\n%s"), (int)jsonMesh.id, *jsonMesh.name, *errMsg);
-	}
-	else{
+	logStaticMeshBuildErrors(buildInfo, buildErrors);
+	return buildErrors.Num() == 0;
+}
+
+void MeshBuilder::setupStaticMeshCollision(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo){
+	check(mesh);
+	{
+		EXODUS_IMPORT_SCOPE(Collision);
 		TArray<FVector> verts(KDopDir18, 18);
 		GenerateKDopAsSimpleCollision(mesh, verts);
 
 		UBodySetup* bodySetup = mesh->GetBodySetup();
 		if (!bodySetup || (bodySetup && (bodySetup->AggGeom.GetElementCount() == 0))){
-			UE_LOG(JsonLog, Warning, TEXT("Could not generate convex collision for mesh %d(\"%s\"):\nRebuilding as a box."), (int)jsonMesh.id, *jsonMesh.name);
+			UE_LOG(JsonLog, Warning, TEXT("Could not generate convex collision for mesh %d(\"%s\"):\nRebuilding as a box."), buildInfo.meshId, *buildInfo.name);
 			GenerateBoxAsSimpleCollision(mesh);
 		}
 
@@ -215,20 +242,15 @@ void MeshBuilder::setupStaticMesh(UStaticMesh *mesh, const JsonMesh &jsonMesh, s
 
 			I wish there was a separation between mesh and collider, though.
 			*/
-			if (jsonMesh.convexCollider){
+			if (buildInfo.convexCollider){
 				bodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
 			}
-			else if (jsonMesh.triangleCollider){
+			else if (buildInfo.triangleCollider){
 				bodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
 			}
 		}
-		if (!bodySetup && (jsonMesh.convexCollider || jsonMesh.triangleCollider)){
-			UE_LOG(JsonLog, Warning, TEXT("Could not setup collision flags for mesh %d(\"%s\") - body setup not generated"), (int)jsonMesh.id, *jsonMesh.name);
+		if (!bodySetup && (buildInfo.convexCollider || buildInfo.triangleCollider)){
+			UE_LOG(JsonLog, Warning, TEXT("Could not setup collision flags for mesh %d(\"%s\") - body setup not generated"), buildInfo.meshId, *buildInfo.name);
 		}
 	}
-
-//#if (ENGINE_MAJOR_VERSION >= 4) && (ENGINE_MINOR_VERSION >= 22)
-#ifdef EXODUS_UE_VER_4_22_GE
-	srcModel.StaticMeshOwner = mesh;
-#endif
 }
@@ -0,0 +1,88 @@
+#include "JsonImportPrivatePCH.h"
+#include "StaticMeshBatchBuilder.h"
+#include "UnrealVersionUtilities.h"
+#include "Engine/StaticMesh.h"
+
+StaticMeshBatchBuilder::~StaticMeshBatchBuilder(){
+	if (pending.Num() > 0){
+		UE_LOG(JsonLog, Warning, TEXT("Static mesh batch destroyed with %d meshes not built, building them now"), pending.Num());
+		flush();
+	}
+}
+
+void StaticMeshBatchBuilder::add(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo){
+	check(mesh);
+	PendingMesh newMesh;
+	newMesh.mesh = mesh;
+	newMesh.buildInfo = buildInfo;
+	pending.Add(newMesh);
+
+	if (pending.Num() >= maxBatchSize)
+		flush();
+}
+
+bool StaticMeshBatchBuilder::isBuilt(UStaticMesh *mesh){
+	return mesh && (mesh->GetNumLODs() > 0);
+}
+
+int32 StaticMeshBatchBuilder::flush(){
+	if (pending.Num() == 0)
+		return 0;
+
+	TArray<PendingMesh> curBatch = MoveTemp(pending);
+	pending.Reset();
+
+	TArray<UStaticMesh*> meshes;
+	meshes.Reserve(curBatch.Num());
+	for(const auto &cur: curBatch){
+		if (auto *mesh = cur.mesh.Get())
+			meshes.Add(mesh);
+	}
+
+	UE_LOG(JsonLog, Log, TEXT("Building %d static meshes"), meshes.Num());
+	int32 numFailed = 0;
+	TSet<UStaticMesh*> failedMeshes;
+#ifdef EXODUS_UE_VER_4_26_GE
+	{
+		EXODUS_IMPORT_SCOPE(StaticMesh);
+		TArray<FText> batchErrors;
+		UStaticMesh::BatchBuild(meshes, true, &batchErrors);
+
+		for(const auto &cur: curBatch){
+			auto *mesh = cur.mesh.Get();
+			if (!mesh || isBuilt(mesh))
+				continue;
+			//Only way to find out what went wrong with this particular one.
+			if (!MeshBuilder::buildStaticMesh(mesh, cur.buildInfo))
+				failedMeshes.Add(mesh);
+		}
+
+		if ((batchErrors.Num() > 0) && (failedMeshes.Num() == 0)){
+			StaticMeshBuildInfo batchInfo;
+			batchInfo.name = FString::Printf(TEXT("batch of %d meshes"), meshes.Num());
+			MeshBuilder::logStaticMeshBuildErrors(batchInfo, batchErrors);
+		}
+	}
+#else
+	for(const auto &cur: curBatch){
+		auto *mesh = cur.mesh.Get();
+		if (mesh && !MeshBuilder::buildStaticMesh(mesh, cur.buildInfo))
+			failedMeshes.Add(mesh);
+	}
+#endif
+
+	for(const auto &cur: curBatch){
+		auto *mesh = cur.mesh.Get();
+		if (!mesh){
+			UE_LOG(JsonLog, Warning, TEXT("Static mesh %d(\"%s\") was gone before it was built"), cur.buildInfo.meshId, *cur.buildInfo.name);
+			numFailed++;
+			continue;
+		}
+		if (failedMeshes.Contains(mesh)){
+			numFailed++;
+			continue;
+		}
+		MeshBuilder::setupStaticMeshCollision(mesh, cur.buildInfo);
+	}
+	return numFailed;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "JsonLog.h"
+
+/*
+Path of an imported asset, plus the object itself once it is known.
+
+Assets are created with RF_Standalone, so a weak pointer is enough - it only goes stale
+if the asset was deleted/reloaded in the meantime, and then the path is loaded again.
+*/
+template<typename T> struct ResolvedObjectRef{
+	FString path;
+	mutable TWeakObjectPtr<T> object;
+	mutable bool loadFailed = false;
+
+	bool isSet() const{
+		return !path.IsEmpty();
+	}
+
+	void set(const FString &path_, T *object_ = nullptr){
+		path = path_;
+		object = object_;
+		loadFailed = false;
+	}
+
+	T* resolve() const{
+		if (T* result = object.Get())
+			return result;
+		if (path.IsEmpty() || loadFailed)
+			return nullptr;
+
+		T* result = LoadObject<T>(nullptr, *path);
+		if (!result){
+			UE_LOG(JsonLog, Warning, TEXT("Could not load \"%s\""), *path);
+			loadFailed = true;
+		}
+		object = result;
+		return result;
+	}
+};
+
+/*
+Imported assets indexed by resource id.
+
+Resource ids are indexes into JsonExternResourceList arrays, so they're dense and a flat array is enough.
+Lookups happen per renderer and per material slot during scene import,
+so they shouldn't hash anything or call LoadObject after the first time.
+*/
+template<typename T> class ResolvedObjectTable{
+protected:
+	TArray<ResolvedObjectRef<T>> entries;
+public:
+	void empty(){
+		entries.Empty();
+	}
+
+	void reserve(int32 count){
+		entries.Reserve(count);
+	}
+
+	bool contains(int32 id) const{
+		return entries.IsValidIndex(id) && entries[id].isSet();
+	}
+
+	const FString* findPath(int32 id) const{
+		return contains(id) ? &entries[id].path: nullptr;
+	}
+
+	void add(int32 id, const FString &path, T *object = nullptr){
+		check(id >= 0);
+		if (id >= entries.Num())
+			entries.SetNum(id + 1);
+		entries[id].set(path, object);
+	}
+
+	void add(int32 id, T *object){
+		check(object);
+		add(id, object->GetPathName(), object);
+	}
+
+	T* resolve(int32 id) const{
+		if (!contains(id))
+			return nullptr;
+		return entries[id].resolve();
+	}
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include "JsonTypes.h"
+
+/*
+Content-addressed deduplication of extern resources.
+
+Unity projects tend to carry the same texture in several folders, or the same mesh data under several model files.
+Each of those gets its own resource id, and without this each one would become a separate unreal asset.
+
+Loaders compute a content key on the worker thread (texture bytes plus settings that change the asset,
+mesh channels, submeshes, materials and skinning data), and the first resource with a given key becomes canonical.
+Resources with the same key later on are not built, their ids are pointed at canonical assets instead.
+
+The key deliberately doesn't include names or paths, those don't change what ends up in the asset.
+*/
+class ResourceDeduplicator{
+public:
+	struct MergedResource{
+		FString type;
+		int32 id = -1;
+		int32 canonicalId = -1;
+		FString name;
+		FString canonicalName;
+	};
+
+	void clear(){
+		canonicalIds.Empty();
+		canonicalNames.Empty();
+		merged.Empty();
+	}
+
+	//INDEX_NONE when nothing with the same content was built yet.
+	int32 findCanonical(const FString &type, const FString &contentKey) const{
+		if (contentKey.IsEmpty())
+			return INDEX_NONE;
+		auto found = canonicalIds.Find(makeKey(type, contentKey));
+		return found ? *found: INDEX_NONE;
+	}
+
+	//Call once the asset actually exists, so a failed import doesn't swallow its duplicates.
+	void addCanonical(const FString &type, const FString &contentKey, int32 id, const FString &name){
+		if (contentKey.IsEmpty())
+			return;
+		auto key = makeKey(type, contentKey);
+		if (canonicalIds.Contains(key))
+			return;
+		canonicalIds.Add(key, id);
+		canonicalNames.Add(key, name);
+	}
+
+	void addMerged(const FString &type, const FString &contentKey, int32 id, const FString &name){
+		MergedResource result;
+		result.type = type;
+		result.id = id;
+		result.name = name;
+		auto key = makeKey(type, contentKey);
+		if (auto found = canonicalIds.Find(key))
+			result.canonicalId = *found;
+		if (auto found = canonicalNames.Find(key))
+			result.canonicalName = *found;
+		UE_LOG(JsonLog, Log, TEXT("%s %d (%s) has the same content as %d (%s), reusing its assets"),
+			*type, id, *name, result.canonicalId, *result.canonicalName);
+		merged.Add(result);
+	}
+
+	const TArray<MergedResource>& getMerged() const{
+		return merged;
+	}
+
+	int32 getNumMerged(const FString &type) const{
+		int32 result = 0;
+		for(const auto &cur: merged){
+			if (cur.type == type)
+				result++;
+		}
+		return result;
+	}
+protected:
+	TMap<FString, int32> canonicalIds;
+	TMap<FString, FString> canonicalNames;
+	TArray<MergedResource> merged;
+
+	static FString makeKey(const FString &type, const FString &contentKey){
+		return type + TEXT(":") + contentKey;
+	}
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "Async/Async.h"
+#include "Misc/Optional.h"
+
+/*
+Two-stage loading of extern resources.
+
+parseFunc(index) runs on task graph workers: reads the file, parses json, fills plain json structs.
+It must not touch UObjects or importer state that is being modified.
+
+consumeFunc(index, result) runs on the calling (game) thread strictly in index order,
+so resources that reference earlier ones still see them created. That's where UObjects are made.
+
+Only a limited number of items is parsed ahead of the consumer, so a few thousand meshes
+won't end up sitting in memory at once, while file io and parsing still overlap with asset creation.
+*/
+template<typename ResultType, typename ParseFunc, typename ConsumeFunc>
+void runResourceParsePipeline(int32 numItems, ParseFunc parseFunc, ConsumeFunc consumeFunc){
+	if (numItems <= 0)
+		return;
+
+	if (!FPlatformProcess::SupportsMultithreading()){
+		for(int32 i = 0; i < numItems; i++){
+			const ResultType result = parseFunc(i);
+			consumeFunc(i, result);
+		}
+		return;
+	}
+
+	const int32 maxItemsAhead = FMath::Max(2, FTaskGraphInterface::Get().GetNumWorkerThreads() * 2);
+	TArray<TFuture<ResultType>> futures;
+	futures.SetNum(numItems);
+
+	int32 numLaunched = 0;
+	auto launchUpTo = [&](int32 lastIndex){
+		lastIndex = FMath::Min(lastIndex, numItems - 1);
+		for(; numLaunched <= lastIndex; numLaunched++){
+			auto index = numLaunched;
+			futures[index] = Async(EAsyncExecution::TaskGraph, [parseFunc, index](){
+				return parseFunc(index);
+			});
+		}
+	};
+
+	launchUpTo(maxItemsAhead - 1);
+	for(int32 i = 0; i < numItems; i++){
+		auto &curFuture = futures[i];
+		curFuture.Wait();
+		consumeFunc(i, curFuture.Get());
+		curFuture.Reset();//done with it, free the parsed data.
+		launchUpTo(i + maxItemsAhead);
+	}
+}
+
+/*
+Most of the loaders parse "one file - one json struct", and failed files are just skipped.
+contentHash is computed on the worker as well, see ImportManifest.
+contentKey is optional, only set for resources that can be deduplicated, see ResourceDeduplicator.
+*/
+template<typename JsonType> struct ParsedResource{
+	TOptional<JsonType> data;
+	FString contentHash;
+	FString contentKey;
+
+	bool isValid() const{
+		return data.IsSet();
+	}
+	const JsonType& get() const{
+		return data.GetValue();
+	}
+
+	ParsedResource() = default;
+	ParsedResource(JsonType &&data_)
+	:data(MoveTemp(data_)){
+	}
+};
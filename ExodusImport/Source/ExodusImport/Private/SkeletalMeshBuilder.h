@@ -20,6 +20,9 @@ struct SkeletalMeshBuildData{
 	bool hasTangents = false;
 
 	TArray<UMorphTarget*> morphTargets;
+	//Blend shape deltas at or below these (unreal units / normal length) are not stored
+	float morphPositionThreshold = 0.001f;
+	float morphNormalThreshold = 0.001f;
 
 	TArray<SkeletalMeshImportData::FVertInfluence> meshInfluences;
 	TArray<SkeletalMeshImportData::FMeshWedge> meshWedges;
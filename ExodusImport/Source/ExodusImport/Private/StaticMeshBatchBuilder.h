@@ -0,0 +1,50 @@
+#pragma once
+
+#include "JsonTypes.h"
+#include "MeshBuilder.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UStaticMesh;
+
+/*
+Second half of static mesh import.
+
+MeshBuilder::fillStaticMesh only writes source data, meshes are then queued here and built in batches.
+On 4.26+ a batch goes through UStaticMesh::BatchBuild, which builds render data of all meshes in parallel.
+Older engines have no batched build, so meshes are built one by one, same as before.
+
+Simple collision is generated afterwards, on the game thread, because it touches body setups.
+
+BatchBuild reports errors for the whole batch, so meshes that came out without render data
+are built once more on their own, which gives per-mesh errors in the log.
+
+Meshes are flushed every maxBatchSize entries, so raw meshes of the whole project don't pile up before the build.
+*/
+class StaticMeshBatchBuilder{
+public:
+	void add(UStaticMesh *mesh, const StaticMeshBuildInfo &buildInfo);
+	//Builds everything queued so far. Returns number of meshes that failed to build.
+	int32 flush();
+
+	int32 getNumPending() const{
+		return pending.Num();
+	}
+
+	StaticMeshBatchBuilder(int32 maxBatchSize_ = 64)
+	:maxBatchSize(FMath::Max(1, maxBatchSize_)){
+	}
+	~StaticMeshBatchBuilder();
+	StaticMeshBatchBuilder(const StaticMeshBatchBuilder&) = delete;
+	StaticMeshBatchBuilder& operator=(const StaticMeshBatchBuilder&) = delete;
+protected:
+	struct PendingMesh{
+		TWeakObjectPtr<UStaticMesh> mesh;
+		StaticMeshBuildInfo buildInfo;
+	};
+
+	int32 maxBatchSize = 64;
+	TArray<PendingMesh> pending;
+
+	//true if the mesh ended up with render data
+	static bool isBuilt(UStaticMesh *mesh);
+};
@@ -2,6 +2,8 @@
 #include "TerrainBuilder.h"
 #include "Landscape.h"
 #include "LandscapeInfo.h"
+#include "LandscapeStreamingProxy.h"
+#include "Async/ParallelFor.h"
 #include "LandscapeLayerInfoObject.h"
 #include "JsonImporter.h"
 
@@ -257,45 +259,165 @@ void TerrainBuilder::processFoliageTreeActors(ALandscape *landscape){
 		//for(const auto& curInstance: terrainData.treeInstances)
 	}
 
-	auto objPos = jsonGameObj.ueWorldMatrix.GetOrigin();
-
-	for(int instanceIndex = 0; instanceIndex < terrainData.treeInstances.Num(); instanceIndex++){
-		UE_LOG(JsonLogTerrain, Log, TEXT("Processing tree instance %d"), instanceIndex);
-		auto srcInst = terrainData.treeInstances[instanceIndex];
-		auto protoIndex = srcInst.prototypeIndex;
-		auto foundFoliage = foliageTypes.Find(protoIndex);
-		auto *foundMeshInfo = foliageMeshInfos.Find(protoIndex);
-		if (!foundFoliage || !foundMeshInfo){
-			UE_LOG(JsonLogTerrain, Warning, TEXT("Could not find foliage %d for instance %d while processing terrain %s"),
-				protoIndex, instanceIndex, *terrainData.name);
+	auto objPos = jsonGameObj.getUeWorldMatrix().GetOrigin();
+
+	/*
+	Instances are converted all at once, grouped by prototype, and each group goes to the foliage in one call.
+	Adding them one by one made the foliage component update per instance, which dominated import time on forests.
+	*/
+	const auto& srcInstances = terrainData.treeInstances;
+	TArray<FFoliageInstance> dstInstances;
+	dstInstances.SetNum(srcInstances.Num());
+	ParallelFor(srcInstances.Num(), [&](int32 instanceIndex){
+		const auto &srcInst = srcInstances[instanceIndex];
+		auto &dstInst = dstInstances[instanceIndex];
+		auto scale = FVector(srcInst.widthScale, srcInst.widthScale, srcInst.heightScale);
+		dstInst.DrawScale3D = scale * 0.1f; //??why??
+		//Hmm. Instance coordinates are within 0..1 range on terrain. 
+		dstInst.Location = terrainData.getNormalizedPosAsWorld(srcInst.position, objPos);//unityPosToUe(treePos);
+	});
+
+	TMap<int32, TArray<const FFoliageInstance*>> instancesByPrototype;
+	int32 numSkipped = 0;
+	for(int instanceIndex = 0; instanceIndex < srcInstances.Num(); instanceIndex++){
+		auto protoIndex = srcInstances[instanceIndex].prototypeIndex;
+		if (!foliageTypes.Contains(protoIndex) || !foliageMeshInfos.Contains(protoIndex)){
+			numSkipped++;
 			continue;
 		}
-		
-		auto meshInfo = *foundMeshInfo;
-		auto foliageType = *foundFoliage;
-
-		auto srcPos = srcInst.position;
-		UE_LOG(JsonLogTerrain, Log, TEXT("Src coord %f %f %f"), srcPos.X, srcPos.Y, srcPos.Z);
-
-		FFoliageInstance dstInst;
+		instancesByPrototype.FindOrAdd(protoIndex).Add(&dstInstances[instanceIndex]);
+	}
+	if (numSkipped > 0){
+		UE_LOG(JsonLogTerrain, Warning, TEXT("%d tree instances of terrain %s reference missing foliage prototypes and were skipped"),
+			numSkipped, *terrainData.name);
+	}
 
-		auto scale = FVector(srcInst.widthScale, srcInst.widthScale, srcInst.heightScale);
+	for(const auto &protoInstances: instancesByPrototype){
+		auto meshInfo = foliageMeshInfos[protoInstances.Key];
+		auto foliageType = foliageTypes[protoInstances.Key];
+		const auto &instances = protoInstances.Value;
+		UE_LOG(JsonLogTerrain, Log, TEXT("Adding %d instances of tree prototype %d"), instances.Num(), protoInstances.Key);
+#if defined(EXODUS_UE_VER_4_26_GE)
+		meshInfo->AddInstances(ifa, foliageType, instances);
+#elif defined(EXODUS_UE_VER_4_24_GE)
+		meshInfo->AddInstances(ifa, foliageType, TSet<const FFoliageInstance*>(instances));
+#else
+		//No batched add on older engines.
+		for(auto *curInst: instances){
+	#if (ENGINE_MAJOR_VERSION == 4) && (ENGINE_MINOR_VERSION >= 23)
+			meshInfo->AddInstance(ifa, foliageType, *curInst);
+	#else
+			meshInfo->AddInstance(ifa, foliageType, *curInst, true);
+	#endif
+		}
+#endif
+	}
+}
 
-		dstInst.DrawScale3D = scale * 0.1f; //??why??
+/*
+region is in landscape vertices, max inclusive. heights and layers hold exactly that region.
+Data is moved into the import containers, nothing is copied on the way to the engine.
 
-		auto treePos = terrainData.getNormalizedPosAsWorld(srcInst.position, objPos);
-		UE_LOG(JsonLogTerrain, Log, TEXT("Dst coord %f %f %f"), treePos.X, treePos.Y, treePos.Z);
-		//Hmm. Instance coordinates are within 0..1 range on terrain. 
-		dstInst.Location = treePos;//unityPosToUe(treePos);
+Import assigns landscapeGuid to the proxy, so every tile of one landscape must get the same guid,
+otherwise each tile ends up with a ULandscapeInfo of its own.
+*/
+static void importLandscapeRegion(ALandscapeProxy *proxy, const FGuid &landscapeGuid, const FIntRect &region, int32 sectionsPerComp, int32 quadsPerSection, 
+		TArray<uint16> &&heights, TArray<FLandscapeImportLayerInfo> &&layers){
+	check(proxy);
 #if (ENGINE_MAJOR_VERSION == 4) && (ENGINE_MINOR_VERSION >= 23)
-		meshInfo->AddInstance(ifa, foliageType, dstInst);
+	TMap<FGuid, TArray<uint16>> heightLayerData;
+	heightLayerData.Add(FGuid(), MoveTemp(heights));
+	TMap<FGuid, TArray<FLandscapeImportLayerInfo>> importLayerMap;
+	importLayerMap.Add(FGuid(), MoveTemp(layers));
+	proxy->Import(landscapeGuid,
+		region.Min.X, region.Min.Y, region.Max.X, region.Max.Y, sectionsPerComp, quadsPerSection,
+		heightLayerData, TEXT(""),
+		importLayerMap, ELandscapeImportAlphamapType::Additive);
 #else
-		meshInfo->AddInstance(ifa, foliageType, dstInst, true);
+	proxy->Import(landscapeGuid,
+		region.Min.X, region.Min.Y, region.Max.X, region.Max.Y, sectionsPerComp, quadsPerSection, 
+		heights.GetData(), TEXT(""), 
+		layers, ELandscapeImportAlphamapType::Additive);
 #endif
+}
+
+//#define TERRAIN_SAVE_DEBUG_IMAGES
+
+/*
+Layer list with LayerData taken from converted data. layerHeaders only supply names and layer infos, 
+alpha maps come first, then detail maps, same order they're declared in buildTerrain.
+*/
+static TArray<FLandscapeImportLayerInfo> makeImportLayers(const TArray<FLandscapeImportLayerInfo> &layerHeaders, JsonConvertedTerrain &converted){
+	check(layerHeaders.Num() == converted.alphaMaps.Num() + converted.detailMaps.Num());
+	TArray<FLandscapeImportLayerInfo> result;
+	result.Reserve(layerHeaders.Num());
+	for(int32 i = 0; i < layerHeaders.Num(); i++){
+		const auto &srcLayer = layerHeaders[i];
+		auto &dstLayer = result.AddDefaulted_GetRef();
+		dstLayer.LayerName = srcLayer.LayerName;
+		dstLayer.LayerInfo = srcLayer.LayerInfo;
+		dstLayer.SourceFilePath = srcLayer.SourceFilePath;
+		auto &srcPlane = (i < converted.alphaMaps.Num()) ? converted.alphaMaps[i]: converted.detailMaps[i - converted.alphaMaps.Num()];
+	#ifdef TERRAIN_SAVE_DEBUG_IMAGES
+		auto fullDstPath = FPaths::Combine(TEXT("D:\\work\\EpicGames\\debug"), 
+			srcLayer.LayerName.ToString() + FString::Printf(TEXT("_%dx%d"), srcPlane.getWidth(), srcPlane.getHeight()) + TEXT(".raw"));
+		srcPlane.saveToRaw(fullDstPath);
+	#endif
+		dstLayer.LayerData = srcPlane.releaseArray();
+	}
+	return result;
+}
+
+/*
+Neighboring tiles share their border row/column of vertices, and every tile is resampled against 
+the full landscape size, so heights and weights along the seams are identical.
+
+Each tile is converted from the mapped source data right before its import and freed after, 
+only the source window the tile reads from gets copied. Peak memory is one tile, not the whole landscape.
+
+ALandscapeProxy::Import creates components and textures, which is game thread work, so tiles themselves go one by one.
+Resampling within a tile is spread across workers.
+*/
+void TerrainBuilder::importLandscapeTiles(ALandscape *landscape, const JsonTerrainTileConverter &converter, const TArray<FLandscapeImportLayerInfo> &layerHeaders, 
+		int32 sectionsPerComp, int32 quadsPerSection, int32 tileComponents){
+	check(landscape);
+	check(tileComponents > 0);
+	const FGuid landscapeGuid = landscape->GetLandscapeGuid();
+	const auto vertSize = converter.getVertSize();
+	const int32 tileQuads = tileComponents * sectionsPerComp * quadsPerSection;
+	const int32 numTilesX = FMath::DivideAndRoundUp(vertSize.X - 1, tileQuads);
+	const int32 numTilesY = FMath::DivideAndRoundUp(vertSize.Y - 1, tileQuads);
+	UE_LOG(JsonLogTerrain, Log, TEXT("Splitting landscape %d x %d into %d x %d tiles of %d components"), 
+		vertSize.X, vertSize.Y, numTilesX, numTilesY, tileComponents);
+
+	for(int32 tileY = 0; tileY < numTilesY; tileY++){
+		for(int32 tileX = 0; tileX < numTilesX; tileX++){
+			FIntRect region(tileX * tileQuads, tileY * tileQuads, 
+				FMath::Min((tileX + 1) * tileQuads, vertSize.X - 1), FMath::Min((tileY + 1) * tileQuads, vertSize.Y - 1));
+
+			JsonConvertedTerrain tileData;
+			converter.convertRegion(tileData, region);
+			auto tileLayers = makeImportLayers(layerHeaders, tileData);
+
+			ALandscapeProxy *proxy = landscape;
+			if ((tileX != 0) || (tileY != 0)){
+				auto *tile = workData.world->SpawnActor<ALandscapeStreamingProxy>();
+				tile->GetSharedProperties(landscape);
+				tile->LandscapeActor = landscape;
+				tile->SetActorLabel(FString::Printf(TEXT("%s_Tile_%d_%d"), *landscape->GetActorLabel(), tileX, tileY));
+				landscapeTiles.Add(tile);
+				proxy = tile;
+			}
+			UE_LOG(JsonLogTerrain, Log, TEXT("Importing landscape tile %d, %d: (%d, %d) - (%d, %d)"), 
+				tileX, tileY, region.Min.X, region.Min.Y, region.Max.X, region.Max.Y);
+			importLandscapeRegion(proxy, landscapeGuid, region, sectionsPerComp, quadsPerSection, 
+				tileData.heightMap.releaseArray(), MoveTemp(tileLayers));
+		}
 	}
 }
 
 ALandscape* TerrainBuilder::buildTerrain(){
+	EXODUS_IMPORT_SCOPE(Landscape);
 	FString terrPath, terrFileName, terrExt;
 	FPaths::Split(terrainData.exportPath, terrPath, terrFileName, terrExt);
 	auto terrainDataPath = FPaths::Combine(terrPath, terrFileName + TEXT("_Data"));
@@ -306,11 +428,13 @@ ALandscape* TerrainBuilder::buildTerrain(){
 	auto fullExportPath = FPaths::Combine(assetRootPath, terrainData.exportPath);
 	if (!binaryTerrain.load(fullExportPath)){
 		UE_LOG(JsonLogTerrain, Error, TEXT("Could not load binary terrain \"%s\", aborting"), *fullExportPath);
+		return nullptr;
 	}
-	JsonConvertedTerrain convertedTerrain;
-	convertedTerrain.assignFrom(binaryTerrain);
-
-	const auto& heightMapData = convertedTerrain.heightMap;
+	const int32 tileComponents = importer->getLandscapeTileComponents();
+	//Nothing is converted yet, that happens either for the whole landscape or tile by tile, see below.
+	JsonTerrainTileConverter converter(binaryTerrain, (tileComponents > 0) ? 
+		(int32)JsonTerrainConstants::maxTiledComponentsPerDimension: (int32)JsonTerrainConstants::maxComponentsPerDimension,
+		importer->isSmoothLandscapeResampling() ? JsonTerrainTools::ResampleFilter::CatmullRom: JsonTerrainTools::ResampleFilter::Linear);
 
 	ALandscape * result = nullptr;
 	const int32 xComps = 1;
@@ -321,52 +445,35 @@ ALandscape* TerrainBuilder::buildTerrain(){
 	int32 xSize = xComps * quadsPerComp + 1;
 	int32 ySize = yComps * quadsPerComp + 1;
 
-	xSize = heightMapData.getWidth();
-	ySize = heightMapData.getHeight();
+	xSize = converter.getVertSize().X;
+	ySize = converter.getVertSize().Y;
 
+	//Layer names and infos only, data is filled in per converted region (makeImportLayers).
 	//normal layers
-#if (ENGINE_MAJOR_VERSION == 4) && (ENGINE_MINOR_VERSION >= 23)
-	TMap<FGuid, TArray<FLandscapeImportLayerInfo>> importLayerMap;
-	auto& importLayers = importLayerMap.Add(FGuid());
-#else
 	TArray<FLandscapeImportLayerInfo> importLayers;
-#endif
-	if (convertedTerrain.alphaMaps.Num() > 0){
-		for(int i = 0; i < convertedTerrain.alphaMaps.Num(); i++){
-			auto layerName = terrainData.getLayerName(i);
-			auto layerInfoObj = createTerrainLayerInfo(i, false, terrainDataPath);
-
-			auto &newLayer = importLayers.AddDefaulted_GetRef();
-			newLayer.LayerName = *layerName;
-			newLayer.LayerData = convertedTerrain.alphaMaps[i].getArrayCopy();
-			newLayer.LayerInfo = layerInfoObj;
-			newLayer.SourceFilePath = TEXT("");
-		}
+	for(int i = 0; i < converter.getNumAlphaMaps(); i++){
+		auto layerName = terrainData.getLayerName(i);
+		auto layerInfoObj = createTerrainLayerInfo(i, false, terrainDataPath);
+
+		auto &newLayer = importLayers.AddDefaulted_GetRef();
+		newLayer.LayerName = *layerName;
+		newLayer.LayerInfo = layerInfoObj;
+		newLayer.SourceFilePath = TEXT("");
 	}
 
-//#define TERRAIN_SAVE_DEBUG_IMAGES
-
 	//grass
 	grassTypes.Empty();
-	if (convertedTerrain.detailMaps.Num() > 0){
-		for(int i = 0; i < convertedTerrain.detailMaps.Num(); i++){
-			auto layerName = terrainData.getGrassLayerName(i);
-			auto layerInfoObj = createTerrainLayerInfo(i, true, terrainDataPath);
-
-			auto &newLayer = importLayers.AddDefaulted_GetRef();
-			newLayer.LayerName = *layerName;
-			auto& detail = convertedTerrain.detailMaps[i];
-			newLayer.LayerData = detail.getArrayCopy();
-			newLayer.LayerInfo = layerInfoObj;
-			newLayer.SourceFilePath = TEXT("");
-		#ifdef TERRAIN_SAVE_DEBUG_IMAGES
-			auto fullDstPath = FPaths::Combine(TEXT("D:\\work\\EpicGames\\debug"), layerName + FString::Printf(TEXT("_%dx%d"), xSize, ySize) + TEXT(".raw"));
-			detail.saveToRaw(fullDstPath);
-		#endif
-
-			auto newGrassType = createGrassType(i, terrainDataPath);
-			grassTypes.Add(newGrassType);
-		}
+	for(int i = 0; i < converter.getNumDetailMaps(); i++){
+		auto layerName = terrainData.getGrassLayerName(i);
+		auto layerInfoObj = createTerrainLayerInfo(i, true, terrainDataPath);
+
+		auto &newLayer = importLayers.AddDefaulted_GetRef();
+		newLayer.LayerName = *layerName;
+		newLayer.LayerInfo = layerInfoObj;
+		newLayer.SourceFilePath = TEXT("");
+
+		auto newGrassType = createGrassType(i, terrainDataPath);
+		grassTypes.Add(newGrassType);
 	}
 
 	auto terrainVertSize = FIntPoint(xSize, ySize);
@@ -374,7 +481,7 @@ ALandscape* TerrainBuilder::buildTerrain(){
 	UMaterial *terrainMaterial = materialBuilder.createTerrainMaterial(this, terrainVertSize, terrainDataPath);
 
 	FTransform terrainTransform;
-	FMatrix terrainMatrix = jsonGameObj.ueWorldMatrix;
+	FMatrix terrainMatrix = jsonGameObj.getUeWorldMatrix();
 
 	auto ueWorldSize = unitySizeToUe(terrainData.worldSize);
 	UE_LOG(JsonLogTerrain, Log, TEXT("Terrain size: %f %f %f"), ueWorldSize.X, ueWorldSize.Y, ueWorldSize.Z);
@@ -397,7 +504,6 @@ ALandscape* TerrainBuilder::buildTerrain(){
 	auto terrainScale = FVector::ZeroVector;//halfWorldSize * 0.001f;
 	logValue(TEXT("Terrain ueWorldSize: "), ueWorldSize);
 	UE_LOG(JsonLogTerrain, Log, TEXT("Terrain xSize: %d; ySize: %d"), xSize, ySize);
-	UE_LOG(JsonLogTerrain, Log, TEXT("Terrain hMap width: %d; height: %d"), heightMapData.getWidth(), heightMapData.getHeight());
 	auto sizeDefault = FVector(100.0f * (float)(xSize - 1), 100.0f * (float)(ySize - 1), 25600.0f * 2.0f);
 	terrainScale = 100.0f * ueWorldSize / sizeDefault;
 	terrainScale.Z *= 2.0f;
@@ -433,29 +539,43 @@ ALandscape* TerrainBuilder::buildTerrain(){
 	landProxy->LandscapeMaterial = terrainMaterial;
 	landProxy->LandscapeHoleMaterial = terrainMaterial;
 
-#if (ENGINE_MAJOR_VERSION == 4) && (ENGINE_MINOR_VERSION >= 23)
-	TMap<FGuid, TArray<uint16>> heightLayerData;
-	heightLayerData.Add(FGuid(), heightMapData.getArray());//Ouch. Need optimization, excessive copying here.
-	landProxy->Import(FGuid::NewGuid(),
-		0, 0, xSize - 1, ySize - 1, sectionsPerComp, quadsPerSection,
-		heightLayerData, TEXT(""),
-		importLayerMap, ELandscapeImportAlphamapType::Additive);
-#else
-	landProxy->Import(FGuid::NewGuid(),
-		0, 0, xSize - 1, ySize - 1, sectionsPerComp, quadsPerSection, 
-		heightMapData.getData(), TEXT(""), 
-		importLayers, ELandscapeImportAlphamapType::Additive);
-#endif
-
 	for(int i = 0; i < importLayers.Num(); i++){
 		auto &curLayer = importLayers[i];
 		UE_LOG(JsonLogTerrain, Log, TEXT("Checking layer %d: %x"), i, curLayer.LayerInfo);
 	}
 
+	landscapeTiles.Empty();
+	const int32 tileQuads = tileComponents * quadsPerComp;
+	if ((tileComponents > 0) && (((xSize - 1) > tileQuads) || ((ySize - 1) > tileQuads))){
+		importLandscapeTiles(result, converter, importLayers, sectionsPerComp, quadsPerSection, tileComponents);
+	}
+	else{
+		JsonConvertedTerrain convertedTerrain;
+		converter.convertRegion(convertedTerrain, converter.getFullRegion(), true);
+		importLandscapeRegion(landProxy, guid, converter.getFullRegion(), sectionsPerComp, quadsPerSection, 
+			convertedTerrain.heightMap.releaseArray(), makeImportLayers(importLayers, convertedTerrain));
+	}
+	//landscape has its own copy now, no need to hold on to source data during foliage setup.
+	importLayers.Empty();
+	binaryTerrain.clear();
+
 	ULandscapeInfo *landscapeInfo  = result->CreateLandscapeInfo();
+	for(int32 tileIndex = landscapeTiles.Num() - 1; tileIndex >= 0; tileIndex--){
+		//Tiles share the landscape guid, so this only registers them with the landscape's info.
+		auto *tile = landscapeTiles[tileIndex];
+		auto *tileInfo = tile->CreateLandscapeInfo();
+		if (tileInfo != landscapeInfo){
+			UE_LOG(JsonLogTerrain, Warning, TEXT("Landscape tile \"%s\" did not end up in the landscape info of \"%s\", removing it"), 
+				*tile->GetActorLabel(), *result->GetActorLabel());
+			tile->Destroy();
+			landscapeTiles.RemoveAt(tileIndex);
+		}
+	}
 	landscapeInfo->UpdateLayerInfoMap(result);
 
 	result->SetActorTransform(terrainTransform);
+	for(auto *tile: landscapeTiles)
+		tile->SetActorTransform(terrainTransform);
 
 	processFoliageTreeActors(result);
 
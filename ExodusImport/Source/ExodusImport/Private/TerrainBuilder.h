@@ -8,10 +8,14 @@
 
 class JsonImporter;
 class ALandscape;
+class ALandscapeProxy;
+class ALandscapeStreamingProxy;
+struct FLandscapeImportLayerInfo;
 class ULandscapeGrassType;
 class ULandscapeLayerInfoObject;
 class UStaticMesh;
 class UMaterialInstanceConstant;
+class JsonTerrainTileConverter;
 
 class TerrainBuilder{
 protected:
@@ -20,6 +24,8 @@ protected:
 	//FString terrainDataPath;
 public:
 	TArray<ULandscapeGrassType*> grassTypes;
+	//Streaming proxies sharing the landscape guid. Only filled when the importer has landscape tiling enabled.
+	TArray<ALandscapeStreamingProxy*> landscapeTiles;
 	const JsonGameObject &jsonGameObj;
 	const JsonTerrain &jsonTerrain;
 	const JsonTerrainData &terrainData;
@@ -50,6 +56,14 @@ protected:
 		const FString &terrainDataPath);
 	void processFoliageTreeActors(ALandscape *landscape);
 
+	/*
+	Splits the landscape into tiles of tileComponents x tileComponents components, each converted on its own.
+	First tile goes into the landscape itself, the rest into streaming proxies.
+	layerHeaders only provide layer names and infos.
+	*/
+	void importLandscapeTiles(ALandscape *landscape, const JsonTerrainTileConverter &converter, const TArray<FLandscapeImportLayerInfo> &layerHeaders, 
+		int32 sectionsPerComp, int32 quadsPerSection, int32 tileComponents);
+
 	UStaticMesh* createBillboardMesh(const FString &baseName, const JsonTerrainDetailPrototype &detPrototype, int layerIndex, const FString &terrainDataPath);
 	UStaticMesh* createGrassMesh(const FString &baseName, const JsonTerrainDetailPrototype &detPrototype, int layerIndex, const FString &terrainDataPath);
 	//UStaticMesh* TerrainBuilder::createTreeMesh(const FString &baseName, const JsonTerrainDetailPrototype &detPrototype, int layerIndex, const FString &terrainDataPath);
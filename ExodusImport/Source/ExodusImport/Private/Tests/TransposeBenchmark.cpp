@@ -0,0 +1,85 @@
+#include "JsonImportPrivatePCH.h"
+#include "TransposeBenchmark.h"
+#include "JsonLog.h"
+#include "JsonObjects/DataPlane2D.h"
+#include "HAL/IConsoleManager.h"
+
+//What transpose2dData used to be, minus the destination stride bug (it only worked for square planes).
+template<typename T> static void transposeNaive(T* transposed, const T* src, int32 srcWidth, int32 srcHeight){
+	auto srcRowData = src;
+	auto dstRowData = transposed;
+	for(int32 y = 0; y < srcHeight; y++){
+		auto srcPixData = srcRowData;
+		auto dstPixData = dstRowData;
+		for(int32 x = 0; x < srcWidth; x++){
+			*dstPixData = *srcPixData;
+			srcPixData ++;
+			dstPixData += srcHeight;
+		}
+		srcRowData += srcWidth;
+		dstRowData ++;
+	}
+}
+
+template<typename Func> static double measureMs(int32 numRepeats, Func func){
+	double best = DBL_MAX;
+	for(int32 i = 0; i < numRepeats; i++){
+		auto start = FPlatformTime::Seconds();
+		func();
+		best = FMath::Min(best, FPlatformTime::Seconds() - start);
+	}
+	return best * 1000.0;
+}
+
+void TransposeBenchmark::runSize(int32 width, int32 height, int32 numRepeats){
+	DataPlane2D<float> src(width, height);
+	auto *srcData = src.getData();
+	for(int32 i = 0; i < src.getNumElements(); i++)
+		srcData[i] = (float)i;
+
+	DataPlane2D<float> naiveResult(height, width);
+	DataPlane2D<float> tiledResult(height, width);
+
+	auto naiveMs = measureMs(numRepeats, [&](){
+		transposeNaive(naiveResult.getData(), src.getData(), width, height);
+	});
+	auto tiledMs = measureMs(numRepeats, [&](){
+		src.getTransposed(tiledResult);
+	});
+
+	double inPlaceMs = 0.0;
+	bool inPlaceMatches = true;
+	if (width == height){
+		auto inPlace = src;
+		inPlaceMs = measureMs(1, [&](){
+			inPlace.transpose();
+		});
+		inPlaceMatches = FMemory::Memcmp(inPlace.getData(), naiveResult.getData(), inPlace.getByteSize()) == 0;
+	}
+
+	bool matches = FMemory::Memcmp(naiveResult.getData(), tiledResult.getData(), tiledResult.getByteSize()) == 0;
+	auto megabytes = (double)src.getByteSize() / (1024.0 * 1024.0);
+	UE_LOG(JsonLog, Display, TEXT("Transpose %5d x %5d (%7.1f MB): naive %8.2f ms, tiled %8.2f ms (x%.2f), in place %8.2f ms; %s"),
+		width, height, megabytes, naiveMs, tiledMs, (tiledMs > 0.0) ? naiveMs / tiledMs: 0.0, inPlaceMs,
+		(matches && inPlaceMatches) ? TEXT("results match"): TEXT("RESULTS DIFFER"));
+}
+
+void TransposeBenchmark::run(){
+	UE_LOG(JsonLog, Display, TEXT("Transpose benchmark, best of several runs"));
+	const int32 sizes[] = {257, 513, 1025, 2049, 4097};
+	for(auto size: sizes){
+		runSize(size, size, (size > 2049) ? 3: 10);
+	}
+	//non-square planes, for the sake of correctness
+	runSize(1024, 512, 10);
+	runSize(333, 1027, 10);
+}
+
+static FAutoConsoleCommand transposeBenchmarkCommand(
+	TEXT("Exodus.TransposeBenchmark"),
+	TEXT("Times terrain plane transposition, see TransposeBenchmark.h"),
+	FConsoleCommandDelegate::CreateLambda([](){
+		TransposeBenchmark benchmark;
+		benchmark.run();
+	})
+);
@@ -0,0 +1,15 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/*
+Compares tiled DataPlaneUtility::transpose2dData against the old row-by-row loop on terrain-sized planes.
+Also checks that both produce the same data.
+
+Run from the editor console: Exodus.TransposeBenchmark
+*/
+class TransposeBenchmark{
+public:
+	void run();
+protected:
+	void runSize(int32 width, int32 height, int32 numRepeats);
+};
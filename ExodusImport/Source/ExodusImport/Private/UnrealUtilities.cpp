@@ -5,6 +5,8 @@
 #include "UnrealEd/Public/PackageTools.h"
 #include "AssetRegistry/Public/AssetRegistryModule.h"
 #include "Components/SceneComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "StaticMeshResources.h"
 
 using namespace UnrealUtilities;
 
@@ -30,6 +32,24 @@ UPackage* UnrealUtilities::createAssetPackage(const FString &objectName, const F
 	return newPackage;
 }	
 
+UnrealUtilities::AssetRebuildScope::AssetRebuildScope(UObject *asset_)
+:asset(asset_){
+	check(asset);
+	if (auto *staticMesh = Cast<UStaticMesh>(asset)){
+		staticMeshContext = MakeUnique<FStaticMeshComponentRecreateRenderStateContext>(staticMesh);
+	}
+	else if (auto *skelMesh = Cast<USkeletalMesh>(asset)){
+		skinnedMeshContext = MakeUnique<FSkinnedMeshComponentRecreateRenderStateContext>(skelMesh);
+	}
+	asset->PreEditChange(nullptr);
+}
+
+UnrealUtilities::AssetRebuildScope::~AssetRebuildScope(){
+	asset->PostEditChange();
+	asset->MarkPackageDirty();
+	//contexts are released after this, recreating render state with the rebuilt data.
+}
+
 void UnrealUtilities::addSourceModel(UStaticMesh* mesh){
 	check(mesh);
 #ifdef EXODUS_UE_VER_4_24_GE
@@ -300,25 +320,25 @@ FMatrix UnrealUtilities::unityWorldToUe(const FMatrix &unityWorld){
 	return ueMatrix;
 }
 
-FVector2D UnrealUtilities::getIdxVector2(const TArray<float>& floats, int32 idx){
+FVector2D UnrealUtilities::getIdxVector2(FloatArrayView floats, int32 idx){
 	if (floats.Num() <= (idx*2 + 1))
 		return FVector2D();
 	return FVector2D(floats[idx*2], floats[idx*2+1]);
 };
 
-FVector UnrealUtilities::getIdxVector3(const TArray<float>& floats, int32 idx){
+FVector UnrealUtilities::getIdxVector3(FloatArrayView floats, int32 idx){
 	if (floats.Num() <= (idx*3 + 2))
 		return FVector();
 	return FVector(floats[idx*3], floats[idx*3+1], floats[idx*3+2]);
 };
 
-FVector4 UnrealUtilities::getIdxVector4(const TArray<float>& floats, int32 idx){
+FVector4 UnrealUtilities::getIdxVector4(FloatArrayView floats, int32 idx){
 	if (floats.Num() <= (idx*4 + 3))
 		return FVector();
 	return FVector4(floats[idx*4], floats[idx*4+1], floats[idx*4+2], floats[idx*4+3]);
 };
 
-FColor UnrealUtilities::getIdxColor(const TArray<uint8>& colors, int32 idx){
+FColor UnrealUtilities::getIdxColor(ByteArrayView colors, int32 idx){
 	return FColor(
 		colors[idx * 4], 
 		colors[idx * 4 + 1], 
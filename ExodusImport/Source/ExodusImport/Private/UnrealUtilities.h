@@ -9,10 +9,13 @@
 #include <functional>
 #include "JsonObjects/loggers.h"
 #include "UnrealVersionUtilities.h"
+#include "ImportProfiler.h"
 
 class JsonImporter;
 class UStaticMesh;
 class USceneComponent;
+class FStaticMeshComponentRecreateRenderStateContext;
+class FSkinnedMeshComponentRecreateRenderStateContext;
 
 namespace UnrealUtilities{
 	FVector getUnityUpVector();
@@ -57,10 +60,10 @@ namespace UnrealUtilities{
 	FMatrix unityWorldToUe(const FMatrix &unityMatrix, const FVector &localPositionOffset);
 	FVector2D unityUvToUnreal(const FVector2D& arg);
 
-	FVector4 getIdxVector4(const TArray<float>& floats, int32 idx);
-	FVector2D getIdxVector2(const TArray<float>& floats, int32 idx);
-	FVector getIdxVector3(const TArray<float>& floats, int32 idx);
-	FColor getIdxColor(const TArray<uint8>& colors, int32 idx);
+	FVector4 getIdxVector4(FloatArrayView floats, int32 idx);
+	FVector2D getIdxVector2(FloatArrayView floats, int32 idx);
+	FVector getIdxVector3(FloatArrayView floats, int32 idx);
+	FColor getIdxColor(ByteArrayView colors, int32 idx);
 
 	template<typename Factory> auto makeFactoryRootPtr(){
 		auto factory = NewObject<Factory>();
@@ -114,6 +117,21 @@ namespace UnrealUtilities{
 
 	UPackage* createAssetPackage(const FString &objectName, const FString* desiredDir, const JsonImporter *importer, std::function<UObject*(UPackage*)> assetCreator);
 
+	/*
+	Wraps a rebuild of an asset that is already loaded (and possibly used by components in open levels),
+	the same way reimport does it: PreEditChange/PostEditChange around the rebuild, and meshes 
+	have render state of their components torn down until the rebuild is finished.
+	*/
+	class AssetRebuildScope{
+	public:
+		AssetRebuildScope(UObject *asset_);
+		~AssetRebuildScope();
+	protected:
+		UObject *asset = nullptr;
+		TUniquePtr<FStaticMeshComponentRecreateRenderStateContext> staticMeshContext;
+		TUniquePtr<FSkinnedMeshComponentRecreateRenderStateContext> skinnedMeshContext;
+	};
+
 	template <typename T>T* createAssetObject(const FString& objectName, const FString* desiredDir, const JsonImporter *importer, 
 			std::function<void(T* obj)> onCreate, EObjectFlags objectFlags){
 		return createAssetObject<T>(objectName, desiredDir, importer, onCreate, nullptr, objectFlags);
@@ -128,7 +146,21 @@ namespace UnrealUtilities{
 		createAssetPackage(objectName, desiredDir, importer,
 			[&](UPackage* pkg) -> T*{
 				T* newObj = nullptr;
-				if (checkForExistingObjects){
+				if (!checkForExistingObjects){
+					//Replacing the asset. Constructing a new object over the live one would leave its users dangling, so rebuild into it instead.
+					auto *oldObj = FindObject<T>(pkg, *sanitizedName);
+					if (oldObj){
+						UE_LOG(JsonLog, Log, TEXT("Rebuilding existing object %s"), *oldObj->GetPathName());
+						{
+							AssetRebuildScope rebuildScope(oldObj);
+							if (onCreate)
+								onCreate(oldObj);
+						}
+						finalResult = oldObj;
+						return oldObj;
+					}
+				}
+				else{
 					auto *oldObj = FindObject<T>(pkg, *sanitizedName);
 					if (oldObj){
 						auto uniqueName = MakeUniqueObjectName(pkg, T::StaticClass(), *sanitizedName).ToString();
@@ -144,6 +176,8 @@ namespace UnrealUtilities{
 				}
 				if (onCreate)
 					onCreate(newObj);
+				if (newObj)
+					ImportProfiler::addAssetCreated();
 				finalResult = newObj;
 				return newObj;
 			}
@@ -246,7 +246,7 @@ ImportedObject GeometryComponentBuilder::processStaticMesh(ImportContext &workDa
 
 	FActorSpawnParameters spawnParams;
 	FTransform transform;
-	transform.SetFromMatrix(jsonGameObj.ueWorldMatrix);
+	transform.SetFromMatrix(jsonGameObj.getUeWorldMatrix());
 
 	AStaticMeshActor *meshActor = nullptr;
 	UStaticMeshComponent *meshComp = nullptr;
@@ -455,7 +455,6 @@ void GeometryComponentBuilder::setupCommonColliderSettings(const ImportContext &
 	const auto *rigBody = workData.locateRigidbody(jsonGameObj);
 	//Hmm. Shoudl this even be here?
 	if (rigBody){
-		//bool compoundColliderRoot = workData.isCompoundRigidbodyRootCollider(jsonGameObj);//TODO: Cache this?
 		//int rootIndex = workData.
 
 		bool physicsEnabled = !rigBody->isKinematic;
@@ -510,13 +509,13 @@ bool GeometryComponentBuilder::configureStaticMeshComponent(ImportContext &workD
 	auto foundMeshPath = importer->findMeshPath(meshId);
 	if (!foundMeshPath){
 		UE_LOG(JsonLog, Error, TEXT("Mesh path not found for id %d"), meshId.id);
+		return false;
 	}
 	UE_LOG(JsonLog, Log, TEXT("Mesh path: %s"), **foundMeshPath);
-	auto meshPath = *foundMeshPath;
 
-	auto *meshObject = LoadObject<UStaticMesh>(0, *meshPath);
+	auto *meshObject = importer->loadStaticMeshById(meshId);
 	if (!meshObject){
-		UE_LOG(JsonLog, Warning, TEXT("Could not load mesh %s"), *meshPath);
+		UE_LOG(JsonLog, Warning, TEXT("Could not load mesh %s"), **foundMeshPath);
 		return false;
 	}
 
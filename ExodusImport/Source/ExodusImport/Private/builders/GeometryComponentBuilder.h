@@ -20,8 +20,6 @@ protected:
 	static void configureMeshRendererData(UStaticMeshComponent& meshComp, const JsonGameObject& jsonGameObj, JsonImporter& importer, const ResId &meshId);
 
 	static void setupCommonColliderSettings(const ImportContext &workData, UPrimitiveComponent *dstCollider, const JsonGameObject &jsonGameObj, const JsonCollider &collider);
-	static bool configureStaticMeshComponent(ImportContext &workData, UStaticMeshComponent *meshComp, 
-		const JsonGameObject &gameObj, bool configForRender, const JsonCollider *collider, JsonImporter *importer);
 
 	static UBoxComponent* createBoxCollider(OuterCreatorCallback outerCreator, const JsonGameObject& gameObj, const JsonCollider& collider);
 	static USphereComponent* createSphereCollider(OuterCreatorCallback outerCreator, const JsonGameObject& gameObj, const JsonCollider& collider);
@@ -31,6 +29,10 @@ protected:
 	static UPrimitiveComponent* processCollider(ImportContext& workData, const JsonGameObject& jsonGameObj,
 		OuterCreatorCallback outerCreator, const JsonCollider& collider, JsonImporter* importer);
 public:
+	//Also used by InstancedMeshBuilder on instanced components
+	static bool configureStaticMeshComponent(ImportContext &workData, UStaticMeshComponent *meshComp, 
+		const JsonGameObject &gameObj, bool configForRender, const JsonCollider *collider, JsonImporter *importer);
+
 	static ImportedObject processMeshAndColliders(ImportContext &workData, 
 		const JsonGameObject &jsonGameObj, ImportedObject *parentObject, const FString &folderPath, 
 		bool spawnAsComponents,
@@ -0,0 +1,135 @@
+#include "JsonImportPrivatePCH.h"
+#include "InstancedMeshBuilder.h"
+#include "GeometryComponentBuilder.h"
+#include "JsonImporter.h"
+#include "UnrealUtilities.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+
+bool InstancedMeshBuilder::canInstance(const ImportContext &workData, const JsonGameObject &jsonGameObj, const IdSet &parentIds){
+	if (!jsonGameObj.hasMesh() || !jsonGameObj.hasRenderers())
+		return false;
+	if (!jsonGameObj.isStatic || !jsonGameObj.activeInHierarchy)
+		return false;
+	if (jsonGameObj.usesPrefab() || parentIds.Contains(jsonGameObj.id))
+		return false;
+	if (jsonGameObj.hasLights() || jsonGameObj.hasProbes() || jsonGameObj.hasSkinMeshes() || jsonGameObj.hasTerrain()
+		|| jsonGameObj.hasAnimators() || jsonGameObj.hasJoints() || jsonGameObj.hasRigidbody())
+		return false;
+	//Rigidbody may sit on a parent and pick this one up as a compound collider
+	if (workData.locateRigidbody(jsonGameObj))
+		return false;
+
+	if (jsonGameObj.hasColliders()){
+		if (jsonGameObj.colliders.Num() != 1)
+			return false;
+		//main mesh collider always uses the render mesh
+		const auto *collider = jsonGameObj.getMainMeshCollider();
+		if (!collider || !collider->enabled)
+			return false;
+	}
+	return true;
+}
+
+FString InstancedMeshBuilder::makeGroupKey(const JsonGameObject &jsonGameObj, const FString &folderPath, const FTransform &transform) const{
+	FString result = FString::Printf(TEXT("mesh%d|mats"), jsonGameObj.meshId.toIndex());
+	for(auto matId: jsonGameObj.getFirstMaterials())
+		result += FString::Printf(TEXT(",%d"), matId);
+
+	const auto *collider = jsonGameObj.getMainMeshCollider();
+	result += collider ? (collider->trigger ? TEXT("|trigger"): TEXT("|collider")): TEXT("|nocollision");
+
+	if (const auto *renderer = jsonGameObj.getFirstRenderer()){
+		result += FString::Printf(TEXT("|shadows%d%d%d"),
+			(int)renderer->castsShadows(), (int)renderer->castsTwoSidedShadows(), (int)renderer->castsShadowsOnly());
+	}
+
+	if (cellSize > 0.0f){
+		auto cell = transform.GetLocation() / cellSize;
+		result += FString::Printf(TEXT("|cell%d,%d,%d"),
+			FMath::FloorToInt(cell.X), FMath::FloorToInt(cell.Y), FMath::FloorToInt(cell.Z));
+	}
+
+	result += TEXT("|") + folderPath;
+	return result;
+}
+
+void InstancedMeshBuilder::addObject(ImportContext &workData, const JsonGameObject &jsonGameObj){
+	const auto &folderPath = workData.getFolderPath(jsonGameObj);
+	auto transform = jsonGameObj.getUnrealTransform();
+	auto key = makeGroupKey(jsonGameObj, folderPath, transform);
+
+	auto *group = groups.Find(key);
+	if (!group){
+		group = &groups.Add(key);
+		group->templateObject = &jsonGameObj;
+		group->folderPath = folderPath;
+		groupOrder.Add(key);
+	}
+	group->transforms.Add(transform);
+	numInstancedObjects++;
+}
+
+UHierarchicalInstancedStaticMeshComponent* InstancedMeshBuilder::buildGroup(ImportContext &workData,
+		const InstanceGroup &group, JsonImporter *importer) const{
+	using namespace UnrealUtilities;
+	check(group.templateObject);
+	check(group.transforms.Num() > 0);
+	const auto &templateObj = *group.templateObject;
+
+	FTransform actorTransform(group.transforms[0].GetLocation());
+	AActor *actor = workData.world->SpawnActor<AActor>(AActor::StaticClass(), actorTransform);
+	if (!actor){
+		UE_LOG(JsonLog, Warning, TEXT("Could not spawn instanced mesh actor for mesh %d"), templateObj.meshId.toIndex());
+		return nullptr;
+	}
+
+	auto *meshComp = NewObject<UHierarchicalInstancedStaticMeshComponent>(actor);
+	actor->SetRootComponent(meshComp);
+	meshComp->SetWorldTransform(actorTransform);
+	meshComp->bAutoRebuildTreeOnInstanceChanges = false;
+
+	if (!GeometryComponentBuilder::configureStaticMeshComponent(workData, meshComp, templateObj, true,
+			templateObj.getMainMeshCollider(), importer)){
+		UE_LOG(JsonLog, Warning, TEXT("Could not configure instanced mesh %d, %d instances dropped"),
+			templateObj.meshId.toIndex(), group.transforms.Num());
+		actor->Destroy();
+		return nullptr;
+	}
+
+	const auto *renderer = templateObj.getFirstRenderer();
+	if (renderer && renderer->castsShadowsOnly()){
+		meshComp->bCastHiddenShadow = true;
+		meshComp->bHiddenInGame = true;
+	}
+
+	meshComp->RegisterComponent();
+	for(const auto &curTransform: group.transforms){
+		meshComp->AddInstance(curTransform.GetRelativeTransform(actorTransform));
+	}
+	meshComp->BuildTreeIfOutdated(false, true);
+
+	auto meshName = FPaths::GetBaseFilename(importer->getMeshPath(templateObj.meshId));
+	actor->SetActorLabel(FString::Printf(TEXT("%s_instances%d"), *meshName, group.transforms.Num()), true);
+	if (group.folderPath.Len())
+		actor->SetFolderPath(*group.folderPath);
+
+	makeComponentVisibleInEditor(meshComp);
+	convertToInstanceComponent(meshComp);
+	return meshComp;
+}
+
+void InstancedMeshBuilder::buildInstances(ImportContext &workData, JsonImporter *importer){
+	check(importer);
+	if (groups.Num() == 0)
+		return;
+
+	EXODUS_IMPORT_SCOPE(ObjectSpawn);
+	UE_LOG(JsonLog, Log, TEXT("Building %d instanced mesh groups out of %d objects"), groups.Num(), numInstancedObjects);
+	for(const auto &curKey: groupOrder){
+		buildGroup(workData, groups[curKey], importer);
+	}
+
+	groups.Empty();
+	groupOrder.Empty();
+	numInstancedObjects = 0;
+}
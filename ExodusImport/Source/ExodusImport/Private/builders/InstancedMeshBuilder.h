@@ -0,0 +1,52 @@
+#pragma once
+#include "JsonTypes.h"
+#include "ImportContext.h"
+#include "JsonObjects/JsonGameObject.h"
+
+class JsonImporter;
+class UHierarchicalInstancedStaticMeshComponent;
+
+/*
+Optional import mode that merges repeated static meshes into hierarchical instanced static mesh components.
+
+Only plain static geometry is instanced: static, active objects with a mesh and a renderer, nothing else on them
+(lights, probes, skin meshes, animators, joints, terrains), no rigidbody on them or their parents, no children,
+no prefab rebuilding, and either no collider or a single mesh collider that uses the render mesh.
+Everything else goes through the regular path.
+
+Objects are grouped by mesh, materials, collision setup, shadow settings and outliner folder.
+If cellSize is positive, groups are additionally split into cubic cells of that size (in unreal units),
+so large levels don't end up with one component spanning the whole map.
+
+Instanced objects don't get ImportedObjects, so they're not registered in ImportContext.
+*/
+class InstancedMeshBuilder{
+public:
+	static bool canInstance(const ImportContext &workData, const JsonGameObject &jsonGameObj, const IdSet &parentIds);
+
+	void addObject(ImportContext &workData, const JsonGameObject &jsonGameObj);
+	//Spawns one actor per group and forgets the groups.
+	void buildInstances(ImportContext &workData, JsonImporter *importer);
+
+	int32 getNumInstancedObjects() const{
+		return numInstancedObjects;
+	}
+
+	InstancedMeshBuilder(float cellSize_ = 0.0f)
+	:cellSize(cellSize_){
+	}
+protected:
+	struct InstanceGroup{
+		const JsonGameObject *templateObject = nullptr;
+		FString folderPath;
+		TArray<FTransform> transforms;
+	};
+
+	float cellSize = 0.0f;
+	int32 numInstancedObjects = 0;
+	TMap<FString, InstanceGroup> groups;
+	TArray<FString> groupOrder;
+
+	FString makeGroupKey(const JsonGameObject &jsonGameObj, const FString &folderPath, const FTransform &transform) const;
+	UHierarchicalInstancedStaticMeshComponent* buildGroup(ImportContext &workData, const InstanceGroup &group, JsonImporter *importer) const;
+};
@@ -1,6 +1,5 @@
 #include "JsonImportPrivatePCH.h"
 #include "JointBuilder.h"
-#include "JsonGameObjectRegistry.h"
 
 #include "UnrealUtilities.h"
 #include "JsonObjects.h"
@@ -318,141 +317,141 @@ FTransform &jointTransform, const JsonPhysicsJoint &joint, const JsonGameObject
 	//physConstraint->SetWorldTransform(hingeTransform);
 }
 
-void JointBuilder::processPhysicsJoint(const JsonGameObject &obj, const InstanceIdMap &instanceMap,
-	const TArray<JsonGameObject>& objects, ImportContext &workData) const{
-	using namespace UnrealUtilities;
-
-	if (!obj.hasJoints())
-		return;
-
-	auto srcObj = workData.findImportedObject(obj.id);
-	if (!srcObj){
-		UE_LOG(JsonLog, Warning, TEXT("Src object %d not found while processing joints"), obj.id);
-		return;//
-	}
-
-	check(srcObj);
-	check(srcObj->hasComponent() || srcObj->hasActor());
-	auto srcRootActor = srcObj->findRootActor();
-	check(srcRootActor);
-	for (int jointIndex = 0; jointIndex < obj.joints.Num(); jointIndex++){
-		const JsonPhysicsJoint &curJoint = obj.joints[jointIndex];
-
-		auto dstJsonObj = resolveObjectReference(curJoint.connectedBodyObject, instanceMap, objects);
-		if (!curJoint.isConnectedToWorld() && !dstJsonObj){
-			UE_LOG(JsonLog, Warning, TEXT("dst object %d not found while processing joints on %d(%d: \"%s\")"),
-				curJoint.connectedBodyObject.instanceId, obj.instanceId, obj.id, *obj.name);
+void JointBuilder::collectJoints(TArray<PendingJoint> &outJoints, const ImportContext &workData) const{
+	check(workData.srcIndex);
+	outJoints.Reset();
+	for(auto objId: workData.srcIndex->jointObjects){
+		auto obj = workData.findJsonObject(objId);
+		if (!obj)
 			continue;
-		}
 
-		if (!isSupportedJoint(curJoint)	){
-			UE_LOG(JsonLog, Warning, TEXT("Unsupported joint type %s at object %d(%s)"),
-				*curJoint.jointType, obj.id, *obj.name);
+		auto srcObj = workData.findImportedObject(obj->id);
+		if (!srcObj){
+			UE_LOG(JsonLog, Warning, TEXT("Src object %d not found while processing joints"), obj->id);
 			continue;
 		}
+		check(srcObj->hasComponent() || srcObj->hasActor());
+
+		for (int jointIndex = 0; jointIndex < obj->joints.Num(); jointIndex++){
+			const JsonPhysicsJoint &curJoint = obj->joints[jointIndex];
+
+			auto dstJsonObj = resolveObjectReference(curJoint.connectedBodyObject, workData);
+			if (!curJoint.isConnectedToWorld() && !dstJsonObj){
+				UE_LOG(JsonLog, Warning, TEXT("dst object %d not found while processing joints on %d(%d: \"%s\")"),
+					curJoint.connectedBodyObject.instanceId, obj->instanceId, obj->id, *obj->name);
+				continue;
+			}
+
+			if (!isSupportedJoint(curJoint)	){
+				UE_LOG(JsonLog, Warning, TEXT("Unsupported joint type %s at object %d(%s)"),
+					*curJoint.jointType, obj->id, *obj->name);
+				continue;
+			}
 
-		AActor *dstActor = nullptr;
-		UPrimitiveComponent *dstComponent = nullptr;
-		if (dstJsonObj){
-			auto dstObj = workData.findImportedObject(dstJsonObj->id);
-			if (dstObj){
-				dstActor = dstObj->findRootActor();
-				dstComponent = Cast<UPrimitiveComponent>(dstObj->component);
+			PendingJoint pending;
+			pending.obj = obj;
+			pending.jointIndex = jointIndex;
+			pending.srcObj = srcObj;
+			if (dstJsonObj){
+				auto dstObj = workData.findImportedObject(dstJsonObj->id);
+				if (dstObj){
+					pending.dstActor = dstObj->findRootActor();
+					pending.dstComponent = Cast<UPrimitiveComponent>(dstObj->component);
+				}
 			}
+			outJoints.Add(pending);
 		}
+	}
+}
 
-		auto physConstraint = NewObject<UPhysicsConstraintComponent>(srcRootActor);
+void JointBuilder::createConstraint(const PendingJoint &pending) const{
+	using namespace UnrealUtilities;
+	check(pending.obj && pending.srcObj);
+	const auto &obj = *pending.obj;
+	const auto &srcObj = *pending.srcObj;
+	const auto jointIndex = pending.jointIndex;
+	const JsonPhysicsJoint &curJoint = obj.joints[jointIndex];
 
-		auto anchorPos = curJoint.anchor;
-		auto jointTransform = obj.getUnrealTransform(anchorPos);
-		auto physObj = ImportedObject(physConstraint);
+	auto srcRootActor = srcObj.findRootActor();
+	check(srcRootActor);
 
-		auto jointName = FString::Printf(TEXT("joint_%d_%s"), jointIndex, *curJoint.jointType);
-		physObj.setNameOrLabel(jointName);
+	auto physConstraint = NewObject<UPhysicsConstraintComponent>(srcRootActor);
 
-		physConstraint->SetLinearBreakable(curJoint.isLinearBreakable(), unityForceToUnreal(curJoint.breakForce));
-		physConstraint->SetAngularBreakable(curJoint.isAngularBreakable(), unityTorqueToUnreal(curJoint.breakTorque));
-		UE_LOG(JsonLog, Log, TEXT("linear breakable: %d (%f); angular breakable: %d (%f);"),
-			(int)curJoint.isLinearBreakable(), curJoint.breakForce,
-			(int)curJoint.isAngularBreakable(), curJoint.breakTorque);
+	auto anchorPos = curJoint.anchor;
+	auto jointTransform = obj.getUnrealTransform(anchorPos);
+	auto physObj = ImportedObject(physConstraint);
 
-		auto srcActor = srcObj->findRootActor();
-		auto srcComponent = Cast<UPrimitiveComponent>(srcObj->component);
+	auto jointName = FString::Printf(TEXT("joint_%d_%s"), jointIndex, *curJoint.jointType);
+	physObj.setNameOrLabel(jointName);
 
-		physConstraint->ConstraintActor1 = srcActor;
-		if (srcComponent)
-			physConstraint->OverrideComponent1 = srcComponent;
-		physConstraint->ConstraintActor2 = dstActor;
-		if (dstComponent)
-			physConstraint->OverrideComponent2 = dstComponent;
+	physConstraint->SetLinearBreakable(curJoint.isLinearBreakable(), unityForceToUnreal(curJoint.breakForce));
+	physConstraint->SetAngularBreakable(curJoint.isAngularBreakable(), unityTorqueToUnreal(curJoint.breakTorque));
+	UE_LOG(JsonLog, Log, TEXT("linear breakable: %d (%f); angular breakable: %d (%f);"),
+		(int)curJoint.isLinearBreakable(), curJoint.breakForce,
+		(int)curJoint.isAngularBreakable(), curJoint.breakTorque);
 
-		physConstraint->SetDisableCollision(!curJoint.enableCollision);
+	auto srcComponent = Cast<UPrimitiveComponent>(srcObj.component);
 
-		if (curJoint.isFixedJointType()){
-			setupFixedJointConstraint(physConstraint, curJoint);
-		}
-		else if (curJoint.isHingeJointType()){
-			setupHingeJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
-		}
-		else if (curJoint.isSpringJointType()){
-			setupSpringJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
-		}
-		else if (curJoint.isCharacterJointType()){
-			setupCharacterJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
-		}
-		else if (curJoint.isConfigurableJointType()){
-			setupConfigurableJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
-		}
-		else{
-			UE_LOG(JsonLog, Warning, TEXT("Unhandled joint type %s at object %d(%s)"),
-				*curJoint.jointType, obj.id, *obj.name);
-		}
+	physConstraint->ConstraintActor1 = srcRootActor;
+	if (srcComponent)
+		physConstraint->OverrideComponent1 = srcComponent;
+	physConstraint->ConstraintActor2 = pending.dstActor;
+	if (pending.dstComponent)
+		physConstraint->OverrideComponent2 = pending.dstComponent;
+
+	physConstraint->SetDisableCollision(!curJoint.enableCollision);
 
-		physConstraint->SetWorldTransform(jointTransform);
-		check(srcObj);
-		physObj.attachTo(*srcObj);
-		physObj.convertToInstanceComponent();
-		physObj.fixEditorVisibility();
+	if (curJoint.isFixedJointType()){
+		setupFixedJointConstraint(physConstraint, curJoint);
+	}
+	else if (curJoint.isHingeJointType()){
+		setupHingeJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
+	}
+	else if (curJoint.isSpringJointType()){
+		setupSpringJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
+	}
+	else if (curJoint.isCharacterJointType()){
+		setupCharacterJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
 	}
+	else if (curJoint.isConfigurableJointType()){
+		setupConfigurableJointConstraint(physConstraint, jointIndex, jointTransform, curJoint, obj);
+	}
+	else{
+		UE_LOG(JsonLog, Warning, TEXT("Unhandled joint type %s at object %d(%s)"),
+			*curJoint.jointType, obj.id, *obj.name);
+	}
+
+	physConstraint->SetWorldTransform(jointTransform);
+	physObj.attachTo(srcObj);
+	physObj.convertToInstanceComponent();
+	physObj.fixEditorVisibility();
 }
 
-void JointBuilder::processPhysicsJoints(const TArray<JsonGameObject>& objects, ImportContext &workData) const{
-	InstanceIdMap instanceMap;
-	FScopedSlowTask progress(objects.Num(), LOCTEXT("Processing joints", "Processing joints"));
+void JointBuilder::processPhysicsJoints(ImportContext &workData) const{
+	EXODUS_IMPORT_SCOPE(Joints);
+	if (!workData.srcIndex || (workData.srcIndex->jointObjects.Num() == 0))
+		return;
+
+	/*
+	Both ends of every joint are resolved first, and constraints are only created once that's done.
+	Nothing is registered in workData while constraints are being created, so pointers into it stay valid.
+	*/
+	TArray<PendingJoint> pendingJoints;
+	collectJoints(pendingJoints, workData);
+	UE_LOG(JsonLog, Log, TEXT("Processing %d joints on %d objects"), pendingJoints.Num(), workData.srcIndex->jointObjects.Num());
+
+	FScopedSlowTask progress(pendingJoints.Num(), LOCTEXT("Processing joints", "Processing joints"));
 	progress.MakeDialog();
-	UE_LOG(JsonLog, Log, TEXT("Processing joints"));
-	for (int i = 0; i < objects.Num(); i++){
-		auto srcObj = objects[i];
-		if (srcObj.hasJoints()){
-			if (instanceMap.isEmpty()){
-				buildInstanceIdMap(instanceMap, objects);
-				check(!instanceMap.isEmpty());
-			}
-			processPhysicsJoint(srcObj, instanceMap, objects, workData);
-		}
+	for(const auto &cur: pendingJoints){
+		createConstraint(cur);
 		progress.EnterProgressFrame(1.0f);
 	}
 }
 
-void JointBuilder::buildInstanceIdMap(InstanceIdMap &outMap, const TArray<JsonGameObject>& objects){
-	outMap.clear();
-	for (const auto &cur : objects){
-		auto instId = cur.instanceId;
-		auto objId = cur.id;
-		outMap.registerId(instId, objId);
-	}
-}
-
-const JsonGameObject* JointBuilder::resolveObjectReference(const JsonObjectReference &ref,
-	const InstanceIdMap &instanceMap, const TArray<JsonGameObject>& objects) const{
+const JsonGameObject* JointBuilder::resolveObjectReference(const JsonObjectReference &ref, const ImportContext &workData) const{
 	if (ref.isNull)
 		return nullptr;
-	auto found = instanceMap.find(ref.instanceId);
-	if (!found)
-		return nullptr;
-	if ((*found < 0) || (*found >= objects.Num()))
-		return nullptr;
-	return &objects[*found];
+	return workData.findJsonObjectByInstanceId(ref.instanceId);
 }
 
 bool JointBuilder::getConstraintMotion(EAngularConstraintMotion &angMotion, const FString &arg){
@@ -1,9 +1,9 @@
 #pragma once
 #include "JsonTypes.h"
-#include "InstanceIdMap.h"
 #include "ImportContext.h"
 
 class UPhysicsConstraintComponent;
+class UPrimitiveComponent;
 
 class JointBuilder{
 protected:
@@ -26,10 +26,18 @@ protected:
 	static EAngularConstraintMotion getAngularMotionChecked(const FString &arg, const FString &motionName, int jointIndex, const JsonGameObject &jsonObj);
 	static ELinearConstraintMotion getLinearMotionChecked(const FString &arg, const FString &motionName, int jointIndex, const JsonGameObject &jsonObj);
 
-	const JsonGameObject* resolveObjectReference(const JsonObjectReference &ref, const InstanceIdMap &instanceMap, const TArray<JsonGameObject>& objects) const;
-	void processPhysicsJoint(const JsonGameObject &obj, const InstanceIdMap &instanceMap,
-		const TArray<JsonGameObject>& objects, ImportContext &workData) const;
-	static void buildInstanceIdMap(InstanceIdMap &outMap, const TArray<JsonGameObject>& objects);
+	//Joint with both ends resolved to imported objects.
+	struct PendingJoint{
+		const JsonGameObject *obj = nullptr;
+		int jointIndex = -1;
+		const ImportedObject *srcObj = nullptr;
+		AActor *dstActor = nullptr;
+		UPrimitiveComponent *dstComponent = nullptr;
+	};
+
+	const JsonGameObject* resolveObjectReference(const JsonObjectReference &ref, const ImportContext &workData) const;
+	void collectJoints(TArray<PendingJoint> &outJoints, const ImportContext &workData) const;
+	void createConstraint(const PendingJoint &pending) const;
 
 	const bool isSupportedJoint(const JsonPhysicsJoint &joint) const;
 
@@ -62,5 +70,6 @@ protected:
 
 
 public:
-	void processPhysicsJoints(const JsonGameObjectArray& objects, ImportContext &workData) const;
+	//Must be called after all objects of workData are imported.
+	void processPhysicsJoints(ImportContext &workData) const;
 };
@@ -83,7 +83,7 @@ ImportedObject LightBuilder::processLight(ImportContext &workData, const JsonGam
 	UE_LOG(JsonLog, Log, TEXT("Creating light"));
 
 	FTransform lightTransform;
-	lightTransform.SetFromMatrix(gameObj.ueWorldMatrix);
+	lightTransform.SetFromMatrix(gameObj.getUeWorldMatrix());
 
 	ALight *lightActor = nullptr;
 	USceneComponent *lightComponent = nullptr;
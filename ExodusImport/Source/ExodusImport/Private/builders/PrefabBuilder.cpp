@@ -57,7 +57,7 @@ void PrefabBuilder::importPrefab(const JsonPrefabData& prefab, JsonImporter *imp
 		return;
 	}
 
-	ImportContext workData(tmpWorld.Get(), false, &prefab.objects);
+	ImportContext workData(tmpWorld.Get(), false, &prefab);
 	for(const auto& cur: prefab.objects){
 		importer->importObject(cur, workData, true);
 	}
@@ -166,7 +166,7 @@ void JsonImporter::importPrefab(const JsonPrefabData& prefab){
 	}
 	else{
 		FTransform firstObjectTransform;
-		firstObjectTransform.SetFromMatrix(firstObject.ueWorldMatrix);
+		firstObjectTransform.SetFromMatrix(firstObject.getUeWorldMatrix());
 		//errrm? Why isn't it being registered afterwards?
 		auto *rootActor = createActor<AActor>(workData, firstObjectTransform, TEXT("AActor"));
 		firstImportedGameObject = ImportedObject(rootActor);
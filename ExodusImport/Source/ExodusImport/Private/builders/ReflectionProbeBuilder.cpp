@@ -16,7 +16,7 @@ ImportedObject ReflectionProbeBuilder::processReflectionProbe(ImportContext &wor
 	using namespace JsonObjects;
 
 	check(importer);
-	FMatrix captureMatrix = gameObj.ueWorldMatrix;
+	FMatrix captureMatrix = gameObj.getUeWorldMatrix();
 
 	FVector ueCenter = unityPosToUe(probe.center);
 	FVector ueSize = unitySizeToUe(probe.size);
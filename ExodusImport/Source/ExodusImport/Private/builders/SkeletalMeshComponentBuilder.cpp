@@ -28,7 +28,7 @@ ImportedObject SkeletalMeshComponentBuilder::processSkinRenderer(ImportContext &
 	if (!skinRend.meshId.isValid())
 		return ImportedObject();
 
-	auto foundMeshPath = importer->getSkinMeshIdMap().Find(skinRend.meshId);//skinMeshIdMap.Find(skinRend.meshId);
+	auto foundMeshPath = importer->findSkinMeshPath(skinRend.meshId);
 	if (!foundMeshPath){
 		UE_LOG(JsonLog, Log, TEXT("Could not locate skin mesh %d for object %s"), skinRend.meshId.toIndex(), *jsonGameObj.name);
 		return ImportedObject();
@@ -50,7 +50,7 @@ ImportedObject SkeletalMeshComponentBuilder::processSkinRenderer(ImportContext &
 	*/
 	FActorSpawnParameters spawnParams;
 	FTransform transform;
-	transform.SetFromMatrix(jsonGameObj.ueWorldMatrix);
+	transform.SetFromMatrix(jsonGameObj.getUeWorldMatrix());
 
 	ASkeletalMeshActor *meshActor = workData.world->SpawnActor<ASkeletalMeshActor>(ASkeletalMeshActor::StaticClass(), transform, spawnParams);
 	if (!meshActor){
@@ -4,6 +4,7 @@
 #include "TerrainBuilder.h"
 #include "JsonImporter.h"
 #include "Landscape.h"
+#include "LandscapeStreamingProxy.h"
 
 void TerrainComponentBuilder::processTerrains(ImportContext &workData, const JsonGameObject &gameObj, ImportedObject *parentObject, 
 		const FString& folderPath, ImportedObjectArray *createdObjects, JsonImporter *importer, std::function<UObject*()> outerCreator){
@@ -41,12 +42,17 @@ ImportedObject TerrainComponentBuilder::processTerrain(ImportContext &workData,
 		return ImportedObject();
 	}
 	builtTerrain->PostEditChange();
+	for(auto *tile: terrainBuilder.landscapeTiles)
+		tile->PostEditChange();
 
 	//setActorHierarchy(builtTerrain, parentActor, folderPath, workData, jsonGameObj);
 
 	//setObjectHierarchy(builtTerrain, parentObject, folderPath, workData, jsonGameObj);
 	ImportedObject result(builtTerrain);
 	setObjectHierarchy(result, parentObject, folderPath, workData, jsonGameObj);
+	//Tiles aren't attached to anything, they only follow the landscape in the outliner.
+	for(auto *tile: terrainBuilder.landscapeTiles)
+		tile->SetFolderPath(builtTerrain->GetFolderPath());
 
 	return result;
 }